@@ -0,0 +1,68 @@
+/*
+ * 설명: 한 번의 읽기 묶음 동안 쓰고 한꺼번에 되감는 범프 할당기를 std::pmr::memory_resource로 제공한다.
+ * 버전: v1.1.0
+ * 관련 문서: design/server/v1.1.0-performance.md
+ * 테스트: tests/unit/arena_test.cpp, tests/unit/steady_state_alloc_test.cpp
+ */
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+namespace net {
+
+// 개별 해제는 무시하고 Reset에서 한 번에 되감는다. 블록이 모자라면 블록을 더 붙이고,
+// 붙인 블록은 Reset 뒤에도 남겨 다음 묶음에서 다시 쓰므로 최고 사용량에 닿은 뒤에는 malloc을 부르지 않는다.
+// 한 스레드(소유 샤드)만 쓴다.
+class Arena : public std::pmr::memory_resource {
+   public:
+    explicit Arena(std::size_t block_size = 16384);
+    ~Arena() override;
+
+    Arena(const Arena &) = delete;
+    Arena &operator=(const Arena &) = delete;
+
+    // 앞서 내준 메모리를 모두 무효로 하고 첫 블록부터 다시 쓴다.
+    void Reset();
+
+    // 마지막 Reset 이후 내준 바이트(정렬 여백 제외)와 지금까지의 최댓값.
+    std::size_t used() const { return used_; }
+    std::size_t high_water() const { return high_water_; }
+    std::size_t block_count() const { return blocks_.size(); }
+
+   protected:
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void *, std::size_t, std::size_t) override {}
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override { return this == &other; }
+
+   private:
+    struct Block {
+        char *data;
+        std::size_t size;
+    };
+
+    void *TryBump(std::size_t bytes, std::size_t alignment);
+
+    std::size_t block_size_;
+    std::vector<Block> blocks_;
+    std::size_t current_;
+    std::size_t offset_;
+    std::size_t used_;
+    std::size_t high_water_;
+};
+
+// Arena를 묶음 범위에 묶는다. 범위를 벗어날 때 Reset한다.
+class ArenaScope {
+   public:
+    explicit ArenaScope(Arena &arena) : arena_(arena) {}
+    ~ArenaScope() { arena_.Reset(); }
+
+    ArenaScope(const ArenaScope &) = delete;
+    ArenaScope &operator=(const ArenaScope &) = delete;
+
+   private:
+    Arena &arena_;
+};
+
+}  // namespace net
@@ -0,0 +1,76 @@
+/*
+ * 설명: 송신 라인을 스택의 512바이트 고정 버퍼에 조립한 뒤 CRLF를 붙인 뷰로 내보내는 라인 빌더를 제공한다.
+ * 버전: v1.1.0
+ * 관련 문서: design/protocol/contract.md, design/server/v1.1.0-performance.md
+ * 테스트: tests/unit/line_builder_test.cpp
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+
+namespace net {
+
+// 조각마다 std::string 임시 객체를 만들지 않고 한 버퍼에 이어 쓴다.
+// 라인 정책(CRLF 포함 512바이트)을 넘는 부분은 잘라 내고 truncated()로 알린다.
+class LineBuilder {
+   public:
+    static const std::size_t kMaxLine = 512;
+    static const std::size_t kMaxContent = kMaxLine - 2;
+
+    LineBuilder() : size_(0), truncated_(false) {}
+
+    LineBuilder &Append(std::string_view text) {
+        std::size_t room = kMaxContent - size_;
+        std::size_t length = text.size();
+        if (length > room) {
+            length = room;
+            truncated_ = true;
+        }
+        std::memcpy(data_ + size_, text.data(), length);
+        size_ += length;
+        return *this;
+    }
+
+    LineBuilder &Append(char c) {
+        if (size_ == kMaxContent) {
+            truncated_ = true;
+            return *this;
+        }
+        data_[size_++] = c;
+        return *this;
+    }
+
+    LineBuilder &AppendNumber(unsigned long long value) {
+        char digits[20];
+        std::size_t count = 0;
+        do {
+            digits[count++] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        } while (value != 0);
+        while (count > 0) {
+            Append(digits[--count]);
+        }
+        return *this;
+    }
+
+    std::size_t size() const { return size_; }
+    bool truncated() const { return truncated_; }
+    std::string_view View() const { return std::string_view(data_, size_); }
+
+    // CRLF를 붙인 라인을 빌더 버퍼 그대로 돌려준다. 다음 Append 전까지 유효하고, 송신 큐가 복사해 간다.
+    // 빌더는 그대로 남아 이어 쓴 뒤 다시 Finish할 수 있다.
+    std::string_view Finish() {
+        data_[size_] = '\r';
+        data_[size_ + 1] = '\n';
+        return std::string_view(data_, size_ + 2);
+    }
+
+   private:
+    char data_[kMaxLine];
+    std::size_t size_;
+    bool truncated_;
+};
+
+}  // namespace net
@@ -0,0 +1,81 @@
+/*
+ * 설명: 여러 이벤트 루프 스레드가 한 샤드에게 작업을 넘기는 잠금 없는 다중 생산자/단일 소비자 우편함을 제공한다.
+ * 버전: v1.1.0
+ * 관련 문서: design/server/v1.1.0-performance.md
+ * 테스트: tests/unit/mailbox_test.cpp
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace net {
+
+// 생산자는 CAS 한 번으로 스택 머리에 붙이고, 소비자는 exchange 한 번으로 전부 떼어 낸 뒤 뒤집어 FIFO로 만든다.
+// 소비자가 하나뿐이므로 ABA 문제가 없다. 한 생산자가 넣은 항목끼리의 순서는 보존된다.
+template <typename T>
+class Mailbox {
+   public:
+    Mailbox() : head_(nullptr) {}
+    ~Mailbox() {
+        Node *node = head_.load(std::memory_order_acquire);
+        while (node != nullptr) {
+            Node *next = node->next;
+            delete node;
+            node = next;
+        }
+    }
+
+    Mailbox(const Mailbox &) = delete;
+    Mailbox &operator=(const Mailbox &) = delete;
+
+    // 비어 있던 우편함에 처음 넣었으면 true를 돌려준다. 소비자를 깨우는 신호는 이때만 보내면 된다.
+    bool Push(T value) {
+        Node *node = new Node(std::move(value));
+        Node *head = head_.load(std::memory_order_relaxed);
+        do {
+            node->next = head;
+        } while (!head_.compare_exchange_weak(head, node, std::memory_order_release,
+                                              std::memory_order_relaxed));
+        return head == nullptr;
+    }
+
+    // 소비자 스레드 전용. 쌓인 항목을 넣은 순서대로 out 뒤에 붙이고 옮긴 개수를 돌려준다.
+    std::size_t TakeAll(std::vector<T> &out) {
+        Node *node = head_.exchange(nullptr, std::memory_order_acquire);
+        if (node == nullptr) {
+            return 0;
+        }
+        Node *reversed = nullptr;
+        while (node != nullptr) {
+            Node *next = node->next;
+            node->next = reversed;
+            reversed = node;
+            node = next;
+        }
+        std::size_t count = 0;
+        while (reversed != nullptr) {
+            Node *next = reversed->next;
+            out.push_back(std::move(reversed->value));
+            delete reversed;
+            reversed = next;
+            ++count;
+        }
+        return count;
+    }
+
+    bool Empty() const { return head_.load(std::memory_order_acquire) == nullptr; }
+
+   private:
+    struct Node {
+        explicit Node(T v) : value(std::move(v)), next(nullptr) {}
+        T value;
+        Node *next;
+    };
+
+    std::atomic<Node *> head_;
+};
+
+}  // namespace net
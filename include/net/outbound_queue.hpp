@@ -0,0 +1,125 @@
+/*
+ * 설명: 연결별 송신 큐를 4KiB 고정 크기 청크를 가리키는 구간의 사슬로 만들고, 다 보낸 청크와 구간은 샤드의 풀(상한 있는 프리 리스트)로 되돌린다.
+ *       브로드캐스트 라인은 샤드의 게시 청크에 한 번만 복사하고 수신자 큐에는 그 바이트를 가리키는 구간만 붙인다.
+ * 버전: v1.1.0
+ * 관련 문서: design/server/v1.1.0-performance.md
+ * 테스트: tests/unit/outbound_queue_test.cpp, tests/unit/steady_state_alloc_test.cpp
+ */
+#pragma once
+
+#include <sys/uio.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace net {
+
+const std::size_t kOutboundChunkBytes = 4096;
+
+// 헤더를 포함해 정확히 kOutboundChunkBytes이다. used 뒤로만 이어 쓰고, 이미 쓴 바이트는 바꾸지 않는다.
+// refs는 이 청크를 가리키는 구간 수(게시 청크는 풀의 몫 1 포함)이다. 소유 샤드만 바꾸므로 원자 연산이 아니다.
+struct OutboundChunk {
+    static const std::size_t kCapacity = kOutboundChunkBytes - sizeof(void *) - 2 * sizeof(std::uint32_t);
+
+    OutboundChunk *next;  // 프리 리스트에서만 쓴다.
+    std::uint32_t refs;
+    std::uint32_t used;
+    char data[kCapacity];
+};
+
+// 큐 사슬의 한 칸. chunk의 [begin, end)가 아직 보내지 않은 바이트이다.
+struct OutboundSegment {
+    OutboundSegment *next;
+    OutboundChunk *chunk;
+    std::uint32_t begin;
+    std::uint32_t end;
+};
+
+// 게시 청크에 복사한 라인 하나의 위치. 다음 Publish 전까지 AppendShared에 넘긴다.
+struct OutboundSlice {
+    OutboundChunk *chunk;
+    std::uint32_t begin;
+    std::uint32_t end;
+};
+
+// 청크와 구간의 프리 리스트. 샤드마다 하나씩 두고 그 샤드 스레드만 Acquire/Release한다.
+// 청크 프리 리스트가 max_free개를 넘으면 돌려받은 청크를 바로 해제해, 부하가 지나간 뒤 남는 메모리를 묶는다.
+// 구간은 청크 하나당 kSegmentsPerChunk개까지만 쌓아 둔다.
+// 개수 필드는 STATS/지표가 다른 스레드에서 근사치로 읽도록 relaxed atomic에 둔다(쓰는 쪽은 하나).
+class ChunkPool {
+   public:
+    static const std::size_t kSegmentsPerChunk = 16;
+
+    explicit ChunkPool(std::size_t max_free = 1024);
+    ~ChunkPool();
+
+    ChunkPool(const ChunkPool &) = delete;
+    ChunkPool &operator=(const ChunkPool &) = delete;
+
+    // refs가 1인 빈 청크를 돌려준다.
+    OutboundChunk *Acquire();
+    // refs를 하나 내리고 0이 되면 프리 리스트로 돌려받는다.
+    void Unref(OutboundChunk *chunk);
+    OutboundSegment *AcquireSegment();
+    void ReleaseSegment(OutboundSegment *segment);
+    // 여러 큐에 넣을 라인을 게시 청크에 이어 쓴다. 자리가 모자라면 새 게시 청크로 옮긴다. data는 kCapacity 이하여야 한다.
+    OutboundSlice Publish(std::string_view data);
+    // REHASH가 다른 샤드 스레드에서 바꿀 수 있다. 줄어든 만큼은 다음 Release부터 해제한다.
+    void SetMaxFree(std::size_t max_free) { max_free_.store(max_free, std::memory_order_relaxed); }
+
+    // 프리 리스트에 든 청크 수, 큐와 게시 청크가 쥐고 있는 청크 수, 지금까지 operator new로 만든 청크 수.
+    std::size_t free_count() const { return free_count_.load(std::memory_order_relaxed); }
+    std::size_t in_use() const { return in_use_.load(std::memory_order_relaxed); }
+    std::uint64_t allocations() const { return allocations_.load(std::memory_order_relaxed); }
+
+   private:
+    OutboundChunk *free_;
+    OutboundSegment *free_segments_;
+    std::size_t free_segment_count_;
+    // 지금 이어 쓰는 게시 청크. 풀이 refs 하나를 쥐고 있다가 청크가 차면 놓는다.
+    OutboundChunk *published_;
+    std::atomic<std::size_t> max_free_;
+    std::atomic<std::size_t> free_count_;
+    std::atomic<std::size_t> in_use_;
+    std::atomic<std::uint64_t> allocations_;
+};
+
+// 라인은 꼬리 구간이 혼자 쓰는 청크에 이어 붙이고(모자라면 다음 청크로 넘겨 나눠 쓴다), 보낸 만큼 머리부터 소비한다.
+// 공유 라인은 게시 청크를 가리키는 구간으로 붙이며, 같은 게시 청크에서 바로 이어지면 꼬리 구간을 늘리기만 한다.
+// 비면 청크와 구간을 하나도 쥐지 않으므로 유휴 연결의 송신 큐는 포인터 몇 개뿐이다.
+// 처음 Append한 풀에 돌려주므로 한 큐는 한 풀(소유 샤드)에서만 쓴다.
+class OutboundQueue {
+   public:
+    OutboundQueue() : head_(nullptr), tail_(nullptr), pool_(nullptr), size_(0) {}
+    ~OutboundQueue() { Clear(); }
+
+    OutboundQueue(const OutboundQueue &) = delete;
+    OutboundQueue &operator=(const OutboundQueue &) = delete;
+    OutboundQueue(OutboundQueue &&other) noexcept;
+    OutboundQueue &operator=(OutboundQueue &&other) noexcept;
+
+    bool empty() const { return head_ == nullptr; }
+    // 아직 보내지 않은 바이트 수.
+    std::size_t size() const { return size_; }
+
+    void Append(ChunkPool &pool, std::string_view data);
+    // pool.Publish가 돌려준 라인을 복사 없이 붙인다.
+    void AppendShared(ChunkPool &pool, const OutboundSlice &slice);
+    // 머리부터 최대 max_iov개 구간, 합쳐서 limit 바이트까지 iov에 담고 담은 개수를 돌려준다.
+    int Gather(struct iovec *iov, int max_iov, std::size_t limit) const;
+    // 보낸 bytes만큼 머리에서 떼어 내고, 다 비운 구간과 더는 참조되지 않는 청크는 풀에 돌려준다.
+    void Consume(std::size_t bytes);
+    void Clear();
+
+   private:
+    OutboundSegment *head_;
+    OutboundSegment *tail_;
+    ChunkPool *pool_;
+    std::size_t size_;
+
+    void Link(OutboundSegment *segment);
+};
+
+}  // namespace net
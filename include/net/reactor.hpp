@@ -0,0 +1,91 @@
+/*
+ * 설명: 소켓 준비 상태 대기를 추상화한 리액터 인터페이스와 poll/epoll 백엔드를 제공한다.
+ * 버전: v1.1.0
+ * 관련 문서: design/server/v1.1.0-performance.md
+ * 테스트: tests/e2e
+ */
+#pragma once
+
+#include <memory>
+#include <poll.h>
+#include <vector>
+#if defined(__linux__)
+#include <sys/epoll.h>
+#endif
+
+#include "utils/config.hpp"
+
+namespace net {
+
+// 관심 이벤트와 준비 이벤트에 공통으로 쓰는 비트 플래그.
+enum EventFlags : unsigned {
+    kEventRead = 1u << 0,
+    kEventWrite = 1u << 1,
+    kEventError = 1u << 2,
+};
+
+struct ReadyEvent {
+    int fd;
+    unsigned events;
+};
+
+class Reactor {
+   public:
+    virtual ~Reactor() {}
+
+    virtual bool Add(int fd, unsigned interest) = 0;
+    virtual void Modify(int fd, unsigned interest) = 0;
+    virtual void Remove(int fd) = 0;
+    // 엣지 트리거 백엔드에서 처리 예산 때문에 남겨 둔 준비 상태를 다시 통지받도록 한다.
+    virtual void Rearm(int fd) = 0;
+    // 준비된 fd를 out에 채운다. 실패 시 -1을 반환하며 errno를 유지한다.
+    virtual int Wait(std::vector<ReadyEvent> &out, int timeout_ms) = 0;
+    virtual const char *Name() const = 0;
+};
+
+class PollReactor : public Reactor {
+   public:
+    bool Add(int fd, unsigned interest) override;
+    void Modify(int fd, unsigned interest) override;
+    void Remove(int fd) override;
+    void Rearm(int fd) override;
+    int Wait(std::vector<ReadyEvent> &out, int timeout_ms) override;
+    const char *Name() const override { return "poll"; }
+
+   private:
+    std::vector<struct pollfd> poll_fds_;
+    // fd -> poll_fds_ 인덱스. 등록되지 않은 fd는 -1이다.
+    std::vector<int> slot_by_fd_;
+
+    int SlotOf(int fd) const;
+};
+
+#if defined(__linux__)
+class EpollReactor : public Reactor {
+   public:
+    EpollReactor();
+    ~EpollReactor() override;
+
+    bool Valid() const { return epoll_fd_ >= 0; }
+
+    bool Add(int fd, unsigned interest) override;
+    void Modify(int fd, unsigned interest) override;
+    void Remove(int fd) override;
+    void Rearm(int fd) override;
+    int Wait(std::vector<ReadyEvent> &out, int timeout_ms) override;
+    const char *Name() const override { return "epoll"; }
+
+   private:
+    int epoll_fd_;
+    // fd별 현재 관심 이벤트. 0이면 등록되지 않은 fd다.
+    std::vector<unsigned> interest_;
+    std::vector<struct epoll_event> buffer_;
+
+    bool Control(int op, int fd, unsigned interest);
+};
+#endif
+
+// 요청한 백엔드를 만들 수 없으면 poll 백엔드로 대체한다.
+std::unique_ptr<Reactor> CreateReactor(config::IoBackend backend);
+
+}  // namespace net
@@ -0,0 +1,17 @@
+/*
+ * 설명: 다른 샤드로 넘기는 라인을 여러 샤드의 우편함 항목이 하나의 할당으로 공유하도록 불변 참조 카운트 버퍼를 제공한다.
+ * 버전: v1.1.0
+ * 관련 문서: design/server/v1.1.0-performance.md
+ * 테스트: tests/e2e
+ */
+#pragma once
+
+#include <memory>
+#include <string>
+
+namespace net {
+
+// 큐에 들어간 뒤에는 수정되지 않으므로 const로 공유한다. 마지막 핸들이 해제될 때 메모리도 해제된다.
+typedef std::shared_ptr<const std::string> SharedBuffer;
+
+}  // namespace net
@@ -0,0 +1,70 @@
+/*
+ * 설명: 생산자 하나와 소비자 하나가 잠금 없이 항목을 주고받는 고정 용량 링 버퍼를 제공한다.
+ * 버전: v1.1.0
+ * 관련 문서: design/server/v1.1.0-performance.md
+ * 테스트: tests/unit/logger_test.cpp
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace net {
+
+// 용량은 2의 거듭제곱으로 올림한다. head_는 생산자만, tail_은 소비자만 쓰므로 CAS가 필요 없다.
+// 두 인덱스는 서로 다른 캐시 라인에 두어 양쪽 스레드가 같은 라인을 번갈아 더럽히지 않게 한다.
+template <typename T>
+class SpscRing {
+   public:
+    explicit SpscRing(std::size_t capacity) : mask_(RoundUp(capacity) - 1), slots_(mask_ + 1), head_(0), tail_(0) {}
+
+    SpscRing(const SpscRing &) = delete;
+    SpscRing &operator=(const SpscRing &) = delete;
+
+    // 생산자 스레드 전용. 가득 차 있으면 value를 건드리지 않고 false를 돌려준다.
+    bool TryPush(T &value) {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        if (head - tail_.load(std::memory_order_acquire) > mask_) {
+            return false;
+        }
+        slots_[head & mask_] = std::move(value);
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 소비자 스레드 전용. 지금까지 들어온 항목을 넣은 순서대로 fn에 넘기고 개수를 돌려준다.
+    template <typename F>
+    std::size_t Drain(F fn) {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        const std::size_t head = head_.load(std::memory_order_acquire);
+        for (std::size_t i = tail; i != head; ++i) {
+            fn(slots_[i & mask_]);
+        }
+        tail_.store(head, std::memory_order_release);
+        return head - tail;
+    }
+
+    // 어느 스레드에서든 부를 수 있는 근사치.
+    std::size_t Size() const {
+        return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+    }
+    std::size_t Capacity() const { return mask_ + 1; }
+
+   private:
+    static std::size_t RoundUp(std::size_t capacity) {
+        std::size_t size = 1;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        return size;
+    }
+
+    const std::size_t mask_;
+    std::vector<T> slots_;
+    alignas(64) std::atomic<std::size_t> head_;
+    alignas(64) std::atomic<std::size_t> tail_;
+};
+
+}  // namespace net
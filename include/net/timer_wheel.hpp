@@ -0,0 +1,71 @@
+/*
+ * 설명: 이벤트 루프가 대기 타임아웃으로 구동하는 계층형 타이머 휠을 제공한다. 유지 비용은 만료되는 타이머 수에 비례한다.
+ * 버전: v1.1.0
+ * 관련 문서: design/server/v1.1.0-performance.md
+ * 테스트: tests/unit/timer_wheel_test.cpp
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace net {
+
+typedef std::uint32_t TimerId;
+const TimerId kNoTimer = 0xffffffffu;
+
+// 슬롯 64개짜리 바퀴 4단. tick_ms가 100이면 0단은 6.4초, 3단은 약 19일까지 담으며, 그보다 먼 기한은 끝으로 당긴다.
+// 타이머는 노드 풀의 인덱스로 엮은 이중 연결 리스트라 예약/취소/재예약이 O(1)이다.
+// Advance는 지나간 틱의 0단 슬롯과, 0단이 한 바퀴 돌 때 윗단 슬롯 하나를 내려보내는 일만 한다.
+class TimerWheel {
+   public:
+    // start_ms는 처음 Advance 전에 거는 타이머의 기준 시각이다. 시계가 0에서 시작하지 않으면 넘겨야 한다.
+    explicit TimerWheel(std::uint64_t tick_ms = 100, std::uint64_t start_ms = 0);
+
+    // deadline_ms에 key를 돌려주는 타이머를 건다. 이미 지난 기한은 다음 틱에 만료된다.
+    TimerId Schedule(std::uint64_t key, std::uint64_t deadline_ms);
+    // 만료되지 않은 타이머의 기한만 옮긴다.
+    void Reschedule(TimerId id, std::uint64_t deadline_ms);
+    // 만료되어 이미 돌려준 id는 다시 쓰일 수 있으므로 취소하면 안 된다.
+    void Cancel(TimerId id);
+
+    // now_ms까지 시간을 진행하고 만료된 타이머의 key를 out 뒤에 붙인다. 만료된 id는 해제된다.
+    void Advance(std::uint64_t now_ms, std::vector<std::uint64_t> &out);
+
+    // 다음에 Advance를 불러야 할 때까지 남은 밀리초. 타이머가 없으면 -1(무한 대기)이다.
+    int NextTimeoutMs(std::uint64_t now_ms) const;
+
+    std::size_t Size() const { return size_; }
+
+   private:
+    static const int kLevels = 4;
+    static const int kSlotBits = 6;
+    static const std::uint32_t kSlots = 1u << kSlotBits;
+    static const std::uint32_t kNil = 0xffffffffu;
+
+    struct Node {
+        std::uint64_t key;
+        std::uint64_t expiry;  // 틱 단위
+        std::uint32_t prev;
+        std::uint32_t next;
+        // 연결된 리스트 머리 위치(level * kSlots + slot). 풀에서 쉬는 노드는 kNil.
+        std::uint32_t bucket;
+    };
+
+    std::uint64_t tick_ms_;
+    std::uint64_t current_;  // 마지막으로 처리한 틱
+    std::vector<Node> nodes_;
+    std::uint32_t free_head_;
+    std::uint32_t heads_[kLevels * kSlots];
+    // 단마다 비어 있지 않은 슬롯 비트맵. 다음 만료 틱을 슬롯 순회 없이 찾는다.
+    std::uint64_t occupied_[kLevels];
+    std::size_t size_;
+
+    std::uint64_t ToTick(std::uint64_t ms) const;
+    void Link(std::uint32_t index);
+    void Unlink(std::uint32_t index);
+    void Cascade(int level);
+};
+
+}  // namespace net
@@ -0,0 +1,44 @@
+/*
+ * 설명: 명령 토큰을 대소문자 구분 없이 명령 식별자로 바꾸는 디스패치 테이블을 제공한다.
+ * 버전: v1.1.0
+ * 관련 문서: design/protocol/contract.md, design/server/v1.1.0-performance.md
+ * 테스트: tests/unit/message_test.cpp
+ */
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+namespace protocol {
+
+enum class CommandId {
+    kUnknown = 0,
+    kPing,
+    kPong,
+    kPass,
+    kNick,
+    kUser,
+    kJoin,
+    kPart,
+    kPrivmsg,
+    kNotice,
+    kTopic,
+    kKick,
+    kInvite,
+    kMode,
+    kRehash,
+    kNames,
+    kList,
+    kQuit,
+    kOper,
+    kStats,
+};
+
+// 명령별 지표 배열 크기. kUnknown도 한 칸을 쓴다.
+const std::size_t kCommandCount = static_cast<std::size_t>(CommandId::kStats) + 1;
+
+// 토큰 길이와 첫 글자로 후보를 좁힌 뒤 나머지만 비교한다. 대문자 사본을 만들지 않는다.
+CommandId LookupCommand(std::string_view token);
+const char *CommandName(CommandId id);
+
+}  // namespace protocol
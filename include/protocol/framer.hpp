@@ -1,12 +1,13 @@
 /*
- * 설명: CRLF 기준으로 입력 버퍼를 분리하고 길이 제한을 검사한다.
- * 버전: v0.1.0
- * 관련 문서: design/protocol/contract.md
+ * 설명: CRLF 기준으로 입력 버퍼를 분리하고 길이 제한을 검사한다. 연결별 고정 용량 입력 링과 복사 없는 라인 뷰 프레이머를 제공한다.
+ * 버전: v1.1.0
+ * 관련 문서: design/protocol/contract.md, design/server/v1.1.0-performance.md
  * 테스트: tests/unit/framer_test.cpp
  */
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace protocol {
@@ -18,4 +19,41 @@ struct FrameResult {
 
 FrameResult ExtractLines(std::string &buffer, std::size_t max_length);
 
+enum class FrameStatus { kLine, kNeedMore, kTooLong };
+
+// recv()가 직접 채우는 고정 용량 입력 버퍼. 소비한 앞부분은 다음 쓰기 전에 한 번만 앞으로 당겨(compact)
+// 라인이 경계를 넘어 갈라지지 않게 하므로, NextLine이 돌려주는 뷰는 항상 연속 메모리다.
+class InputRing {
+   public:
+    explicit InputRing(std::size_t max_length = 512, std::size_t slack = 512);
+
+    // recv 대상 영역. 호출 시 이전에 돌려준 라인 뷰는 무효가 된다.
+    char *WritePtr();
+    std::size_t WritableSize();
+    void Commit(std::size_t n);
+
+    // CRLF를 뺀 다음 완성 라인을 buffer 내부를 가리키는 뷰로 돌려준다.
+    // kTooLong이면 입력을 모두 버리며, 호출자는 연결을 종료해야 한다.
+    FrameStatus NextLine(std::string_view &line);
+
+    std::size_t Size() const { return tail_ - head_; }
+    std::size_t Capacity() const { return storage_.size(); }
+    // 남은 입력을 버린다. 저장 공간은 그대로 두어 다음 연결이 다시 쓴다.
+    void Clear() {
+        head_ = 0;
+        tail_ = 0;
+        scan_ = 0;
+    }
+
+   private:
+    std::vector<char> storage_;
+    std::size_t max_length_;
+    std::size_t head_;
+    std::size_t tail_;
+    // 이전 탐색에서 CRLF가 없다고 확인한 위치. 부분 라인을 매번 처음부터 다시 훑지 않는다.
+    std::size_t scan_;
+
+    void Compact();
+};
+
 }  // namespace protocol
@@ -1,24 +1,49 @@
 /*
- * 설명: IRC 라인을 RFC 규칙에 따라 prefix/command/params로 파싱하고 닉네임 유효성을 검사한다.
- * 버전: v0.3.0
- * 관련 문서: design/protocol/contract.md
+ * 설명: IRC 라인을 RFC 규칙에 따라 prefix/command/params로 파싱하고 닉네임/채널 이름 유효성을 검사한다. 할당 없는 뷰 파서를 함께 제공한다.
+ * 버전: v1.1.0
+ * 관련 문서: design/protocol/contract.md, design/server/v1.1.0-performance.md
  * 테스트: tests/unit/message_test.cpp
  */
 #pragma once
 
+#include <array>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace protocol {
 
+// RFC 1459 메시지당 최대 파라미터 수. 마지막 파라미터는 남은 라인 전체를 담는다.
+const std::size_t kMaxParams = 15;
+
 struct ParsedMessage {
     std::string prefix;
     std::string command;
     std::vector<std::string> params;
 };
 
+// 고정 크기 인라인 배열에 담는 파라미터 목록. 핸들러가 vector처럼 쓸 수 있도록 같은 이름의 접근자를 둔다.
+struct ParamList {
+    std::array<std::string_view, kMaxParams> items;
+    std::size_t count;
+
+    ParamList() : count(0) {}
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    std::string_view operator[](std::size_t index) const { return items[index]; }
+};
+
+// 원본 라인을 빌려 쓰는 파싱 결과. 원본 버퍼가 살아 있는 동안만 유효하다.
+struct ParsedMessageView {
+    std::string_view prefix;
+    std::string_view command;
+    ParamList params;
+};
+
+ParsedMessageView ParseMessageView(std::string_view line);
 ParsedMessage ParseMessageLine(const std::string &line);
-bool IsValidNickname(const std::string &nick);
+bool IsValidNickname(std::string_view nick);
+// `#`로 시작하고 2~50자이며 영문/숫자/`_`/`-`만 쓴 이름.
+bool IsValidChannelName(std::string_view name);
 
 }  // namespace protocol
-
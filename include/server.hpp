@@ -1,45 +1,162 @@
 /*
- * 설명: poll 기반 TCP 서버로 등록 절차, PING/PONG/QUIT, JOIN/PART, 메시징/채널 관리(TOPIC/KICK/INVITE/MODE) 라우팅과 설정 리로드, 레이트리밋을 처리한다.
- * 버전: v0.9.0
- * 관련 문서: design/protocol/contract.md, design/server/v0.7.0-modes.md, design/server/v0.8.0-config-logging.md, design/server/v0.9.0-defensive.md
- * 테스트: tests/unit/framer_test.cpp, tests/unit/message_test.cpp, tests/unit/config_parser_test.cpp, tests/e2e
+ * 설명: 리액터(poll/epoll) 기반 TCP 서버로, 하나 이상의 이벤트 루프 샤드에서 등록 절차, PING/PONG/QUIT, JOIN/PART, 메시징/채널 관리(TOPIC/KICK/INVITE/MODE) 라우팅과 설정 리로드, 레이트리밋, OPER/STATS와 지표 소켓을 처리한다.
+ * 버전: v1.1.0
+ * 관련 문서: design/protocol/contract.md, design/server/v0.7.0-modes.md, design/server/v0.8.0-config-logging.md, design/server/v0.9.0-defensive.md, design/server/v1.1.0-performance.md
+ * 테스트: tests/unit/framer_test.cpp, tests/unit/message_test.cpp, tests/unit/config_parser_test.cpp, tests/unit/nick_registry_test.cpp, tests/unit/connection_table_test.cpp, tests/unit/channel_registry_test.cpp, tests/unit/rate_limiter_test.cpp, tests/unit/line_builder_test.cpp, tests/unit/metrics_test.cpp, tests/unit/outbound_queue_test.cpp, tests/unit/steady_state_alloc_test.cpp, tests/unit/read_fairness_test.cpp, tests/e2e
  */
 #pragma once
 
-#include <chrono>
+#include <atomic>
+#include <cstdint>
 #include <deque>
-#include <map>
-#include <poll.h>
+#include <memory>
+#include <mutex>
 #include <set>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <vector>
 
+#include "net/arena.hpp"
+#include "net/line_builder.hpp"
+#include "net/mailbox.hpp"
+#include "net/outbound_queue.hpp"
+#include "net/reactor.hpp"
+#include "net/shared_buffer.hpp"
+#include "net/timer_wheel.hpp"
+#include "protocol/command.hpp"
 #include "protocol/framer.hpp"
 #include "protocol/message.hpp"
+#include "state/channel_registry.hpp"
+#include "state/connection_table.hpp"
+#include "state/nick_registry.hpp"
+#include "state/rate_limiter.hpp"
 #include "utils/config.hpp"
 #include "utils/logger.hpp"
+#include "utils/metrics.hpp"
 
-struct ClientConnection {
-    int fd;
-    std::string input_buffer;
-    std::deque<std::string> outbound_queue;
-    std::size_t send_offset;
+// 세션마다 따로 제한하는 명령 묶음. [limits]의 *_per_5s 키와 하나씩 대응한다.
+enum RateClass { kRateMessage = 0, kRateJoin, kRateNick, kRateClassCount };
+
+// 송신 큐가 low 워터마크를 넘었을 때 버려도 되는 라인(NOTICE)은 kOutboundLow로 넣는다.
+enum OutboundPriority { kOutboundNormal = 0, kOutboundLow };
+
+// 이벤트 루프와 송수신 경로가 이벤트마다 만지는 필드(핫). 세션 정보와 다른 배열에 둔다.
+struct ClientIo {
+    // 라인 정책 512바이트 + 여유. 빈 링으로 시작해 처음 수락할 때 [io] read_buffer_bytes 크기로 만들고, 이후 연결은 그대로 물려받는다.
+    protocol::InputRing input;
+    // 소유 샤드의 청크 풀에서 받은 4KiB 청크 사슬. size()가 워터마크 판정에 쓰는 남은 바이트이다.
+    net::OutboundQueue outbound;
+    // 남은 송신을 마친 뒤 닫는다(오류 numeric 후 종료).
     bool marked_close;
+    // 세션에 이어서 만들 LIST/NAMES 응답이 있다. 송신 경로가 잠금 없이 확인한다.
+    bool listing_pending;
+    // 팬아웃 중 큐 초과로 종료가 예약됐다. 이벤트 처리 사이에 ReapPendingCloses가 닫는다.
+    bool close_pending;
+    // 이번 바퀴의 읽기 예산을 다 써 샤드의 read_backlog에서 다음 바퀴를 기다린다.
+    bool read_deferred;
+    // 연결 타이머 하나로 등록 기한, PING/PONG, 송신 정체를 검사한다. 시각은 소유 샤드 기준 밀리초.
+    net::TimerId timer;
+    std::uint64_t accepted_ms;
+    std::uint64_t last_activity_ms;
+    std::uint64_t last_send_progress_ms;
+    std::uint64_t ping_sent_ms;
+    bool ping_outstanding;
+
+    ClientIo()
+        : input(0, 0), marked_close(false), listing_pending(false),
+          close_pending(false), read_deferred(false), timer(net::kNoTimer), accepted_ms(0), last_activity_ms(0),
+          last_send_progress_ms(0), ping_sent_ms(0), ping_outstanding(false) {}
+
+    // 입력 링 저장 공간은 남기고 내용과 필드만 되돌린다. 송신 큐 청크는 풀로 돌아간다.
+    void Reset() {
+        input.Clear();
+        outbound.Clear();
+        marked_close = false;
+        listing_pending = false;
+        close_pending = false;
+        read_deferred = false;
+        timer = net::kNoTimer;
+        accepted_ms = 0;
+        last_activity_ms = 0;
+        last_send_progress_ms = 0;
+        ping_sent_ms = 0;
+        ping_outstanding = false;
+    }
+};
+
+// 소켓이 비는 만큼씩 이어서 만드는 LIST/NAMES 응답의 위치. 채널/멤버가 그 사이 바뀌어도 ID/fd 기준으로 이어 간다.
+struct ListingCursor {
+    enum Kind { kList, kNames };
+    Kind kind;
+    // NAMES: 요청한 채널 이름과 다음에 낼 멤버 fd 하한.
+    std::string channel;
+    int next_fd;
+    // LIST: 마지막으로 본 채널 ID와 필터. masks가 비면 모든 채널이다.
+    state::ChannelId last_channel;
+    std::vector<std::string> masks;
+    bool has_min_users;
+    std::size_t min_users;  // 인원 > min_users
+    bool has_max_users;
+    std::size_t max_users;  // 인원 < max_users
+    bool started;
+
+    ListingCursor()
+        : kind(kList), next_fd(0), last_channel(state::kNoChannel), has_min_users(false),
+          min_users(0), has_max_users(false), max_users(0), started(false) {}
+};
+
+// 등록/채널/레이트리밋처럼 명령 처리 때만 만지는 필드(콜드).
+struct ClientSession {
     bool pass_accepted;
     bool registered;
     bool user_set;
     std::string nick;
     std::string username;
     std::string realname;
-    std::set<std::string> joined_channels;
-    std::size_t enqueues_since_last_write;
-    std::deque<std::chrono::steady_clock::time_point> recent_messages;
-    std::deque<std::chrono::steady_clock::time_point> recent_outbound;
+    // 보통 몇 개뿐이므로 선형 탐색하는 작은 배열로 둔다.
+    std::vector<state::ChannelId> joined_channels;
+    state::RateLimiter command_rate[kRateClassCount];
+    // 요청 순서대로 처리하는 LIST/NAMES 응답. 앞 응답이 끝나야 다음 응답을 시작한다.
+    std::deque<ListingCursor> listings;
+    // UserPrefix 캐시. prefix_generation이 서버 세대와 다르면 다시 만든다(0은 아직 없음).
+    std::string prefix;
+    std::uint32_t prefix_generation;
+    // 이 연결을 수락해 ClientIo를 소유하는 이벤트 루프 샤드.
+    std::size_t shard;
+    // OPER에 성공한 서버 운영자. STATS를 쓸 수 있다.
+    bool oper;
+
+    ClientSession()
+        : pass_accepted(false), registered(false), user_set(false), prefix_generation(0), shard(0),
+          oper(false) {}
+
+    // 문자열/배열은 clear()로 비워 용량을 남긴다.
+    void Reset() {
+        pass_accepted = false;
+        registered = false;
+        user_set = false;
+        nick.clear();
+        username.clear();
+        realname.clear();
+        joined_channels.clear();
+        for (int i = 0; i < kRateClassCount; ++i) {
+            command_rate[i] = state::RateLimiter();
+        }
+        listings.clear();
+        prefix.clear();
+        prefix_generation = 0;
+        shard = 0;
+        oper = false;
+    }
 };
 
+typedef state::ConnectionTable<ClientIo, ClientSession> ClientTable;
+
 struct ChannelState {
-    std::set<int> members;
-    std::set<int> operators;
+    // 운영자 여부는 멤버별 kMemberOperator 플래그로 둔다.
+    state::MemberList members;
+    // RFC 1459 casemapping으로 정규화한 닉네임.
     std::set<std::string> invited;
     std::string topic;
     bool has_topic;
@@ -55,6 +172,92 @@ struct ChannelState {
           has_user_limit(false), user_limit(0) {}
 };
 
+typedef state::ChannelRegistry<ChannelState> ChannelTable;
+
+// 다른 샤드가 소유한 연결에 보낼 라인. 브로드캐스트는 샤드마다 수신자를 한 항목으로 묶는다.
+struct ShardDelivery {
+    net::SharedBuffer buffer;
+    std::vector<state::ConnectionHandle> targets;
+    OutboundPriority priority;
+
+    ShardDelivery() : priority(kOutboundNormal) {}
+};
+
+// 샤드 하나의 지표. 그 샤드 스레드만 쓰고 STATS와 지표 소켓은 잠금 없이 읽기만 한다.
+struct ShardMetrics {
+    metrics::Counter commands[protocol::kCommandCount];
+    // 핸들러 실행 시간(나노초). 상태 잠금을 기다린 시간은 들어가지 않는다.
+    metrics::Histogram command_ns[protocol::kCommandCount];
+    metrics::Counter rate_limited[kRateClassCount];
+    metrics::Counter wakeups;
+    // 대기 한 번에 받은 준비 이벤트 수.
+    metrics::Histogram batch_events;
+    metrics::Counter accepted;
+    // 읽기 예산을 다 써 다음 바퀴로 미룬 횟수.
+    metrics::Counter read_deferrals;
+};
+
+// STATS와 지표 소켓이 내보내는 시점 사본. 샤드별 지표를 더하고 상태 잠금 아래 게이지를 읽는다.
+struct ServerStats {
+    std::uint64_t commands[protocol::kCommandCount];
+    std::vector<metrics::HistogramSnapshot> command_ns;
+    std::uint64_t rate_limited[kRateClassCount];
+    std::vector<std::uint64_t> shard_wakeups;
+    std::vector<metrics::HistogramSnapshot> shard_batch_events;
+    std::uint64_t accepted;
+    std::uint64_t read_deferrals;
+    std::size_t connections;
+    std::size_t channels;
+    std::size_t outbound_bytes;
+    std::uint64_t outbound_dropped_lines;
+    std::uint64_t outbound_evictions;
+    std::size_t outbound_chunks_in_use;
+    std::size_t outbound_chunks_free;
+    std::uint64_t outbound_chunk_allocations;
+    std::uint64_t log_dropped_lines;
+    std::uint64_t uptime_ms;
+
+    ServerStats()
+        : commands(), command_ns(protocol::kCommandCount), rate_limited(), accepted(0), read_deferrals(0),
+          connections(0), channels(0), outbound_bytes(0), outbound_dropped_lines(0), outbound_evictions(0),
+          outbound_chunks_in_use(0), outbound_chunks_free(0), outbound_chunk_allocations(0),
+          log_dropped_lines(0), uptime_ms(0) {}
+};
+
+// 이벤트 루프 스레드 하나. 자기 리스닝 소켓으로 수락한 연결의 ClientIo와 리액터는 이 스레드만 만진다.
+struct EventShard {
+    std::size_t index;
+    int listen_fd;
+    // 빈 우편함에 처음 넣은 생산자가 1바이트를 써서 Wait 중인 샤드를 깨운다.
+    int wake_read_fd;
+    int wake_write_fd;
+    // fd가 바닥났을(EMFILE/ENFILE) 때 닫아 한 자리를 비우고, 밀린 연결을 받아 바로 끊는 데 쓰는 예비 fd.
+    int reserve_fd;
+    std::unique_ptr<net::Reactor> reactor;
+    net::Mailbox<ShardDelivery> mailbox;
+    std::vector<ShardDelivery> inbox;
+    // ScheduleClose로 예약된 연결. 용량을 유지한 채 비우므로 평소에는 할당이 없다.
+    std::vector<state::ConnectionHandle> pending_close;
+    // 브로드캐스트 중 다른 샤드 소유 수신자를 샤드별로 모은다.
+    std::vector<std::vector<state::ConnectionHandle> > outgoing;
+    // 읽기 예산을 다 써 다음 바퀴에 이어 읽을 연결. 바퀴마다 read_serving으로 바꿔 들고 차례로 한 번씩 읽는다.
+    std::vector<state::ConnectionHandle> read_backlog;
+    std::vector<state::ConnectionHandle> read_serving;
+    // 이 샤드 연결들의 타이머. 대기 타임아웃이 다음 만료 틱까지로 정해진다.
+    net::TimerWheel timers;
+    std::vector<std::uint64_t> expired;
+    // 마지막 대기에서 깨어난 시각(밀리초). 배치 안에서는 이 값을 현재 시각으로 쓴다.
+    std::uint64_t now_ms;
+    ShardMetrics metrics;
+    // 읽기 묶음 하나(HandleClientRead 한 번) 동안 핸들러 임시 문자열을 담고, 묶음이 끝나면 되감는다.
+    net::Arena arena;
+    // 이 샤드 연결들의 송신 큐 청크. 큐에 넣고 보내는 일이 모두 소유 샤드에서 일어나므로 잠금이 없다.
+    net::ChunkPool chunk_pool;
+    std::thread thread;
+
+    EventShard() : index(0), listen_fd(-1), wake_read_fd(-1), wake_write_fd(-1), reserve_fd(-1), now_ms(0) {}
+};
+
 class PollServer {
    public:
     PollServer(int port, const std::string &password, const config::Settings &settings,
@@ -62,67 +265,120 @@ class PollServer {
     void Run();
 
    private:
-    void SetupListeningSocket();
-    void EventLoop();
-    void HandleListeningEvent(short revents);
-    void AcceptNewClients();
+    // tests/support/server_harness.hpp가 리액터 대기 없이 샤드 하나를 직접 돌린다(벤치마크와 할당 횟수 테스트).
+    friend class ServerHarness;
+
+    void SetupShards();
+    // 이 스레드의 현재 샤드를 정하고 시각과 타이머 휠을 지금으로 맞춘다. RunShard가 처음에 부른다.
+    void EnterShard(EventShard &shard);
+    void RunShard(EventShard &shard);
+    void HandleListeningEvent(EventShard &shard, unsigned events);
+    void AcceptNewClients(EventShard &shard);
+    bool DropPendingConnection(EventShard &shard);
+    // 논블로킹으로 바꾼 연결 fd를 샤드 리액터와 연결 테이블에 올린다. 실패하면 fd를 닫는다.
+    bool AdoptClient(EventShard &shard, int client_fd);
+    void HandleWakeEvent(EventShard &shard);
+    void OpenMetricsSocket(EventShard &shard);
+    void HandleMetricsEvent();
+    std::unique_lock<std::mutex> AcquireState();
+    void DrainMailbox(EventShard &shard);
+    void PostToShard(std::size_t shard, ShardDelivery delivery);
     void HandleClientRead(int fd);
+    void DeferRead(int fd);
+    void ServeReadBacklog(EventShard &shard);
     void HandleClientWrite(int fd);
     void CloseClient(int fd);
-    void ProcessLine(int fd, const std::string &line);
-    bool EnqueueResponse(int fd, const std::string &line);
+    void ScheduleClose(int fd);
+    void ReapPendingCloses();
+    void RunExpiredTimers(EventShard &shard);
+    void HandleConnectionTimer(const state::ConnectionHandle &handle);
+    void ArmConnectionTimer(int fd);
+    void ProcessLine(int fd, std::string_view line);
+    // shared는 line을 이 샤드 풀에 이미 게시했을 때 넘긴다. 그러면 수신자 큐에 바이트를 복사하지 않고 구간만 붙인다.
+    bool EnqueueLine(int fd, std::string_view line, OutboundPriority priority = kOutboundNormal,
+                     const net::OutboundSlice *shared = nullptr);
+    void ReleaseQueuedBytes(ClientIo &conn, std::size_t bytes);
     void UpdatePollWriteInterest(int fd);
-    protocol::ParsedMessage ParseAndNormalize(const std::string &line);
-    void HandleCommand(int fd, const protocol::ParsedMessage &msg);
-    void HandlePing(int fd, const protocol::ParsedMessage &msg);
-    void HandlePong(int fd, const protocol::ParsedMessage &msg);
-    void HandlePass(int fd, const protocol::ParsedMessage &msg);
-    void HandleNick(int fd, const protocol::ParsedMessage &msg);
-    void HandleUser(int fd, const protocol::ParsedMessage &msg);
-    void HandleJoin(int fd, const protocol::ParsedMessage &msg);
-    void HandlePart(int fd, const protocol::ParsedMessage &msg);
-    void HandlePrivmsgNotice(int fd, const protocol::ParsedMessage &msg, bool notice);
-    void HandleNames(int fd, const protocol::ParsedMessage &msg);
-    void HandleList(int fd, const protocol::ParsedMessage &msg);
-    void HandleTopic(int fd, const protocol::ParsedMessage &msg);
-    void HandleKick(int fd, const protocol::ParsedMessage &msg);
-    void HandleInvite(int fd, const protocol::ParsedMessage &msg);
-    void HandleMode(int fd, const protocol::ParsedMessage &msg);
+    void HandleCommand(int fd, const protocol::ParsedMessageView &msg);
+    void DispatchCommand(int fd, protocol::CommandId command, const protocol::ParsedMessageView &msg);
+    void HandlePing(int fd, const protocol::ParsedMessageView &msg);
+    void HandlePong(int fd, const protocol::ParsedMessageView &msg);
+    void HandlePass(int fd, const protocol::ParsedMessageView &msg);
+    void HandleNick(int fd, const protocol::ParsedMessageView &msg);
+    void HandleUser(int fd, const protocol::ParsedMessageView &msg);
+    void HandleJoin(int fd, const protocol::ParsedMessageView &msg);
+    void HandlePart(int fd, const protocol::ParsedMessageView &msg);
+    void HandlePrivmsgNotice(int fd, const protocol::ParsedMessageView &msg, bool notice);
+    void HandleNames(int fd, const protocol::ParsedMessageView &msg);
+    void HandleList(int fd, const protocol::ParsedMessageView &msg);
+    void StartListing(int fd, const ListingCursor &cursor);
+    void ContinueListings(int fd);
+    bool AdvanceListing(int fd, ListingCursor &cursor);
+    bool ListingHasRoom(int fd) const;
+    bool EmitListingLine(int fd, net::LineBuilder &line);
+    void HandleTopic(int fd, const protocol::ParsedMessageView &msg);
+    void HandleKick(int fd, const protocol::ParsedMessageView &msg);
+    void HandleInvite(int fd, const protocol::ParsedMessageView &msg);
+    void HandleMode(int fd, const protocol::ParsedMessageView &msg);
     void HandleRehash(int fd);
+    void HandleOper(int fd, const protocol::ParsedMessageView &msg);
+    void HandleStats(int fd, const protocol::ParsedMessageView &msg);
+    void CollectStats(ServerStats &out);
+    std::string RenderMetricsText(const ServerStats &stats) const;
     void HandleQuit(int fd);
-    void SendNumeric(int fd, const std::string &code, const std::string &target,
-                     const std::string &message, bool close_after = false);
-    bool NickInUse(const std::string &nick, int requester_fd) const;
-    int FindClientFdByNick(const std::string &nick) const;
+    void SendNumeric(int fd, std::string_view code, std::string_view target,
+                     std::string_view message, bool close_after = false);
+    bool NickInUse(std::string_view nick, int requester_fd) const;
+    int FindClientFdByNick(std::string_view nick) const;
     void TryCompleteRegistration(int fd);
-    void BroadcastToChannel(const std::string &channel, const std::string &line,
-                            int exclude_fd = -1);
-    std::string BuildUserPrefix(int fd) const;
-    bool IsValidChannelName(const std::string &name) const;
+    void BroadcastToChannel(state::ChannelId channel, std::string_view line, int exclude_fd = -1,
+                            OutboundPriority priority = kOutboundNormal);
+    const std::string &UserPrefix(int fd);
     void RemoveFromAllChannels(int fd, const std::string &reason);
-    void DetachClientFromChannel(int fd, const std::string &channel);
+    void DetachClientFromChannel(int fd, state::ChannelId channel);
     void PromoteOperatorIfNeeded(ChannelState &state);
     bool IsChannelOperator(const ChannelState &state, int fd) const;
-    bool ParsePositiveNumber(const std::string &value, std::size_t &out) const;
-    std::string BuildModeReply(const ChannelState &state) const;
+    bool ParsePositiveNumber(std::string_view value, std::size_t &out) const;
+    // 324 본문 "<channel> +<modes> [key] [limit]". 읽기 묶음 아레나에 만든다.
+    std::string_view BuildModeReply(std::string_view channel, const ChannelState &state) const;
     void ApplyConfig(const config::Settings &settings);
     bool ReloadConfig(std::string &error);
     void HandlePendingReload();
-    bool ConsumeRateLimitToken(int fd);
+    bool ConsumeRateLimitToken(int fd, RateClass rate_class);
 
-    int listen_fd_;
     int port_;
     std::string password_;
-    std::vector<struct pollfd> poll_fds_;
-    std::map<int, ClientConnection> clients_;
-    std::map<std::string, ChannelState> channels_;
+    std::vector<std::unique_ptr<EventShard> > shards_;
+    // 세션/채널/닉네임/설정과 연결 슬롯의 생성·삭제를 보호하는 서버 전체 잠금 하나이다.
+    // 명령 처리(recv 한 번의 프레이밍 포함), 연결 종료, 타이머 만료, 우편함 비우기가 모두 이 잠금 아래 돌므로
+    // 샤드가 여럿이어도 이 일들은 한 번에 한 샤드씩만 한다. 잠금 없이 병렬로 도는 것은 recv/sendmsg와 송신 큐뿐이다.
+    // ClientIo는 소유 샤드 스레드만 만지므로 잠금 없이 송수신한다.
+    std::mutex state_mutex_;
+    ClientTable clients_;
+    ChannelTable channels_;
+    state::NickRegistry nicks_;
 
     config::Settings config_;
     std::string config_path_;
     Logger logger_;
 
-    std::size_t max_outbound_queue_;
-
-    std::string FormatPayloadForEcho(const std::string &payload) const;
+    // 송신 큐 워터마크(바이트). 큐잉 판정은 소유 샤드가 상태 잠금을 쥔 채 한다.
+    std::size_t outbound_high_bytes_;
+    std::size_t outbound_low_bytes_;
+    std::size_t outbound_total_cap_;
+    // 모든 연결의 송신 큐 바이트 합과 백프레셔 카운터. 잠금 없는 송신 경로도 갱신한다.
+    std::atomic<std::size_t> outbound_bytes_;
+    std::atomic<std::uint64_t> outbound_dropped_lines_;
+    std::atomic<std::uint64_t> outbound_evictions_;
+    state::RatePolicy command_rate_[kRateClassCount];
+    // REHASH마다 올려 세션의 prefix 캐시를 한꺼번에 무효화한다.
+    std::uint32_t prefix_generation_;
+    // 잠금 없는 송신 경로가 읽는다.
+    std::atomic<std::size_t> write_budget_bytes_;
+    std::atomic<std::size_t> read_budget_bytes_;
+    std::atomic<std::size_t> read_budget_lines_;
+    // [metrics] socket이 있으면 첫 샤드의 리액터에 등록한 Unix 리스닝 소켓.
+    int metrics_fd_;
+    std::uint64_t start_ms_;
 };
 
@@ -0,0 +1,22 @@
+/*
+ * 설명: 닉네임/채널 이름 비교에 쓰는 RFC 1459 casemapping 정규화를 제공한다.
+ * 버전: v1.1.0
+ * 관련 문서: design/protocol/contract.md, design/server/v1.1.0-performance.md
+ * 테스트: tests/unit/nick_registry_test.cpp, tests/unit/channel_registry_test.cpp
+ */
+#pragma once
+
+#include <string>
+#include <string_view>
+
+namespace state {
+
+// A-Z → a-z, [ ] \ ~ → { } | ^ 로 접는다(RFC 1459 casemapping).
+std::string FoldCase(std::string_view name);
+// out에 접은 결과를 덮어쓴다. out의 용량을 다시 쓰므로 조회용 키를 만들 때 할당이 없다.
+void FoldCaseInto(std::string_view name, std::string &out);
+
+// casemapping을 무시하고 글롭 마스크(`*`: 0자 이상, `?`: 1자)와 비교한다. LIST 마스크에 쓴다.
+bool MatchMask(std::string_view mask, std::string_view name);
+
+}  // namespace state
@@ -0,0 +1,152 @@
+/*
+ * 설명: 채널 이름을 정수 ID로 인터닝하는 레지스트리와, 멤버 fd를 플래그 비트와 함께 정렬 배열로 담는 멤버 목록을 제공한다.
+ * 버전: v1.1.0
+ * 관련 문서: design/protocol/contract.md, design/server/v1.1.0-performance.md
+ * 테스트: tests/unit/channel_registry_test.cpp
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "state/casemap.hpp"
+
+namespace state {
+
+typedef std::uint32_t ChannelId;
+const ChannelId kNoChannel = 0;
+
+enum MemberFlag : unsigned { kMemberOperator = 1u << 0 };
+
+struct ChannelMember {
+    int fd;
+    unsigned flags;
+};
+
+// fd 오름차순으로 정렬한 연속 배열. 조회는 이진 탐색 한 번이고 브로드캐스트는 배열을 그대로 훑는다.
+// 운영자 수는 따로 세어 "운영자 없음" 판정이 멤버 수와 무관하게 O(1)이다.
+class MemberList {
+   public:
+    MemberList() : operator_count_(0) {}
+
+    bool Insert(int fd, unsigned flags);
+    bool Erase(int fd);
+    bool Contains(int fd) const;
+    bool HasFlag(int fd, unsigned flag) const;
+    void SetFlag(int fd, unsigned flag, bool on);
+
+    std::size_t size() const { return members_.size(); }
+    bool empty() const { return members_.empty(); }
+    const ChannelMember &operator[](std::size_t i) const { return members_[i]; }
+    std::size_t OperatorCount() const { return operator_count_; }
+    // fd 이상인 첫 멤버의 위치. 목록이 바뀌어도 마지막으로 본 fd로 이어서 훑을 수 있다.
+    std::size_t LowerBound(int fd) const;
+
+   private:
+    std::vector<ChannelMember> members_;
+    std::size_t operator_count_;
+
+    std::vector<ChannelMember>::iterator Locate(int fd);
+    std::vector<ChannelMember>::const_iterator Locate(int fd) const;
+};
+
+// FoldCase로 정규화한 이름 → ID 해시 인덱스와 ID로 바로 접근하는 슬롯 배열.
+// 빈 채널을 지우면 ID는 재사용되므로, ID를 들고 있는 쪽(연결의 가입 목록)은 채널을 떠날 때 반드시 놓아야 한다.
+// FindOrCreate가 배열을 키울 수 있으므로 Get/Name 참조는 다음 생성 전까지만 유효하다.
+template <typename Channel>
+class ChannelRegistry {
+   public:
+    ChannelId Find(std::string_view name) const {
+        FoldCaseInto(name, lookup_key_);
+        std::unordered_map<std::string, ChannelId>::const_iterator it = id_by_name_.find(lookup_key_);
+        return it == id_by_name_.end() ? kNoChannel : it->second;
+    }
+
+    // 처음 만든 사용자의 표기를 채널 이름으로 유지한다.
+    ChannelId FindOrCreate(std::string_view name) {
+        FoldCaseInto(name, lookup_key_);
+        std::unordered_map<std::string, ChannelId>::const_iterator it = id_by_name_.find(lookup_key_);
+        if (it != id_by_name_.end()) {
+            return it->second;
+        }
+        ChannelId id;
+        if (!free_ids_.empty()) {
+            id = free_ids_.back();
+            free_ids_.pop_back();
+        } else {
+            slots_.push_back(Slot());
+            id = static_cast<ChannelId>(slots_.size());
+        }
+        Slot &slot = slots_[id - 1];
+        slot.name = std::string(name);
+        slot.channel = Channel();
+        slot.live = true;
+        id_by_name_.emplace(lookup_key_, id);
+        return id;
+    }
+
+    void Erase(ChannelId id) {
+        if (!IsLive(id)) {
+            return;
+        }
+        Slot &slot = slots_[id - 1];
+        FoldCaseInto(slot.name, lookup_key_);
+        id_by_name_.erase(lookup_key_);
+        slot.name.clear();
+        slot.channel = Channel();
+        slot.live = false;
+        free_ids_.push_back(id);
+    }
+
+    bool IsLive(ChannelId id) const {
+        return id != kNoChannel && id <= slots_.size() && slots_[id - 1].live;
+    }
+
+    // 호출 전에 IsLive(id)가 참이어야 한다.
+    Channel &Get(ChannelId id) { return slots_[id - 1].channel; }
+    const Channel &Get(ChannelId id) const { return slots_[id - 1].channel; }
+    const std::string &Name(ChannelId id) const { return slots_[id - 1].name; }
+
+    std::size_t Size() const { return id_by_name_.size(); }
+
+    // after보다 큰 ID 중 살아 있는 첫 채널. 없으면 kNoChannel. 순회를 나눠서 이어 갈 때 쓴다.
+    ChannelId NextLive(ChannelId after) const {
+        for (std::size_t i = after; i < slots_.size(); ++i) {
+            if (slots_[i].live) {
+                return static_cast<ChannelId>(i + 1);
+            }
+        }
+        return kNoChannel;
+    }
+
+    // visit(id, name, channel)을 살아 있는 채널마다 ID 순서로 호출한다.
+    template <typename Visitor>
+    void ForEach(Visitor visit) const {
+        for (std::size_t i = 0; i < slots_.size(); ++i) {
+            if (slots_[i].live) {
+                visit(static_cast<ChannelId>(i + 1), slots_[i].name, slots_[i].channel);
+            }
+        }
+    }
+
+   private:
+    struct Slot {
+        std::string name;
+        Channel channel;
+        bool live;
+
+        Slot() : live(false) {}
+    };
+
+    std::vector<Slot> slots_;
+    std::vector<ChannelId> free_ids_;
+    std::unordered_map<std::string, ChannelId> id_by_name_;
+    // 조회할 때 접은 키를 담는 재사용 버퍼. 호출자가 상태 잠금으로 직렬화하므로 공유해도 된다.
+    mutable std::string lookup_key_;
+};
+
+}  // namespace state
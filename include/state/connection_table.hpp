@@ -0,0 +1,151 @@
+/*
+ * 설명: fd를 인덱스로 쓰는 연결 슬랩. 송수신 경로의 핫 필드와 세션의 콜드 필드를 별도 배열로 두고 세대 번호로 재사용된 fd를 구별한다.
+ * 버전: v1.1.0
+ * 관련 문서: design/server/v1.1.0-performance.md
+ * 테스트: tests/unit/connection_table_test.cpp
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace state {
+
+// 특정 시점의 연결 하나를 가리킨다. 같은 fd가 닫혔다가 재사용되면 generation이 달라진다.
+struct ConnectionHandle {
+    int fd;
+    std::uint32_t generation;
+};
+
+// fd는 작고 밀집된 정수이므로 트리 대신 fd 위치의 슬롯을 바로 쓴다.
+// 슬롯은 kChunkSlots개씩 묶은 청크에 두고 청크는 옮기지 않으므로, Io/Session 참조는 Insert 이후에도 유효하다.
+// Hot/Cold는 Reset()으로 기본 상태로 돌아가야 한다. 슬롯은 새로 만들지 않고 제자리에서 되돌려, 버퍼와 문자열 용량을
+// 다음 연결이 그대로 물려받는다(수락/종료마다 할당하지 않는다).
+// 여러 이벤트 루프 스레드가 공유할 때: Reserve로 디렉터리를 미리 잡아 두고, Insert/Erase는 호출자가 직렬화한다.
+// 슬롯의 live/generation은 atomic이라 다른 스레드의 Insert와 겹쳐도 IsCurrent/Contains가 안전하다.
+template <typename Hot, typename Cold>
+class ConnectionTable {
+   public:
+    static const std::size_t kChunkSlots = 256;
+
+    ConnectionTable() : size_(0) {}
+
+    ConnectionTable(const ConnectionTable &) = delete;
+    ConnectionTable &operator=(const ConnectionTable &) = delete;
+
+    // fd < slots인 슬롯까지 디렉터리를 미리 만든다. 이후 그 범위의 Insert는 디렉터리를 키우지 않는다.
+    void Reserve(std::size_t slots) {
+        std::size_t chunks = (slots + kChunkSlots - 1) / kChunkSlots;
+        if (chunks > chunks_.size()) {
+            chunks_.resize(chunks);
+        }
+    }
+
+    // 디렉터리를 키우지 않고 받을 수 있는 fd 상한(미포함).
+    std::size_t Capacity() const { return chunks_.size() * kChunkSlots; }
+
+    ConnectionHandle Insert(int fd) {
+        std::size_t slot = static_cast<std::size_t>(fd);
+        Reserve(slot + 1);
+        std::unique_ptr<Chunk> &chunk = chunks_[slot / kChunkSlots];
+        if (!chunk) {
+            chunk.reset(new Chunk());
+        }
+        std::size_t i = slot % kChunkSlots;
+        // 닫힌 뒤에도 핸들러가 참조를 통해 슬롯을 건드렸을 수 있으므로 새 연결은 항상 기본값에서 시작한다.
+        chunk->hot[i].Reset();
+        chunk->cold[i].Reset();
+        // 0은 닫힌 fd를 뜻하므로 한 바퀴 돌아도 건너뛴다.
+        std::uint32_t generation = chunk->generation[i].load(std::memory_order_relaxed) + 1;
+        if (generation == 0) {
+            ++generation;
+        }
+        chunk->generation[i].store(generation, std::memory_order_release);
+        if (!chunk->live[i].exchange(true, std::memory_order_acq_rel)) {
+            ++size_;
+        }
+        ConnectionHandle handle = {fd, generation};
+        return handle;
+    }
+
+    // 슬롯을 기본값으로 되돌린다. 송신 큐처럼 풀에서 빌린 메모리는 Reset이 바로 돌려준다.
+    void Erase(int fd) {
+        if (!Contains(fd)) {
+            return;
+        }
+        std::size_t slot = static_cast<std::size_t>(fd);
+        Chunk &chunk = *chunks_[slot / kChunkSlots];
+        std::size_t i = slot % kChunkSlots;
+        chunk.live[i].store(false, std::memory_order_release);
+        chunk.hot[i].Reset();
+        chunk.cold[i].Reset();
+        --size_;
+    }
+
+    bool Contains(int fd) const {
+        const Chunk *chunk = ChunkOf(fd);
+        return chunk != nullptr &&
+               chunk->live[static_cast<std::size_t>(fd) % kChunkSlots].load(std::memory_order_acquire);
+    }
+
+    // 닫힌 fd면 generation 0(어떤 Insert도 돌려주지 않는 값)을 담는다.
+    ConnectionHandle HandleOf(int fd) const {
+        ConnectionHandle handle = {fd, 0};
+        if (Contains(fd)) {
+            handle.generation = ChunkOf(fd)->generation[static_cast<std::size_t>(fd) % kChunkSlots].load(
+                std::memory_order_acquire);
+        }
+        return handle;
+    }
+
+    bool IsCurrent(const ConnectionHandle &handle) const {
+        return handle.generation != 0 && Contains(handle.fd) &&
+               ChunkOf(handle.fd)
+                       ->generation[static_cast<std::size_t>(handle.fd) % kChunkSlots]
+                       .load(std::memory_order_acquire) == handle.generation;
+    }
+
+    // 호출 전에 해당 fd가 한 번은 Insert되었어야 한다(보통 Contains(fd)가 참).
+    Hot &Io(int fd) { return Slot(fd).hot[static_cast<std::size_t>(fd) % kChunkSlots]; }
+    const Hot &Io(int fd) const { return Slot(fd).hot[static_cast<std::size_t>(fd) % kChunkSlots]; }
+    Cold &Session(int fd) { return Slot(fd).cold[static_cast<std::size_t>(fd) % kChunkSlots]; }
+    const Cold &Session(int fd) const {
+        return Slot(fd).cold[static_cast<std::size_t>(fd) % kChunkSlots];
+    }
+
+    std::size_t Size() const { return size_; }
+
+   private:
+    // 핫/콜드 필드는 청크 안에서도 별도 배열이라 송수신 경로가 세션 필드를 캐시로 끌어오지 않는다.
+    struct Chunk {
+        Hot hot[kChunkSlots];
+        Cold cold[kChunkSlots];
+        std::atomic<std::uint32_t> generation[kChunkSlots];
+        std::atomic<bool> live[kChunkSlots];
+
+        Chunk() {
+            for (std::size_t i = 0; i < kChunkSlots; ++i) {
+                generation[i].store(0, std::memory_order_relaxed);
+                live[i].store(false, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    std::vector<std::unique_ptr<Chunk> > chunks_;
+    std::size_t size_;
+
+    const Chunk *ChunkOf(int fd) const {
+        if (fd < 0) {
+            return nullptr;
+        }
+        std::size_t index = static_cast<std::size_t>(fd) / kChunkSlots;
+        return index < chunks_.size() ? chunks_[index].get() : nullptr;
+    }
+    Chunk &Slot(int fd) { return *chunks_[static_cast<std::size_t>(fd) / kChunkSlots]; }
+    const Chunk &Slot(int fd) const { return *chunks_[static_cast<std::size_t>(fd) / kChunkSlots]; }
+};
+
+}  // namespace state
@@ -0,0 +1,36 @@
+/*
+ * 설명: RFC 1459 casemapping으로 정규화한 닉네임 → fd 해시 인덱스를 제공한다.
+ * 버전: v1.1.0
+ * 관련 문서: design/protocol/contract.md, design/server/v1.1.0-performance.md
+ * 테스트: tests/unit/nick_registry_test.cpp
+ */
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "state/casemap.hpp"
+
+namespace state {
+
+// 키는 FoldCase로 정규화한 닉네임이다. 닉네임을 설정한 모든 연결(등록 전 포함)을 담으며,
+// 등록 여부는 호출자가 연결 상태로 판단한다.
+class NickRegistry {
+   public:
+    // 다른 fd가 이미 같은 (정규화된) 닉네임을 쓰고 있으면 false.
+    bool Claim(std::string_view nick, int fd);
+    // fd가 소유한 경우에만 제거한다.
+    void Release(std::string_view nick, int fd);
+    // 없으면 -1.
+    int Find(std::string_view nick) const;
+    bool InUse(std::string_view nick, int requester_fd) const;
+    std::size_t Size() const { return fd_by_nick_.size(); }
+
+   private:
+    std::unordered_map<std::string, int> fd_by_nick_;
+    // 조회할 때 접은 키를 담는 재사용 버퍼. 호출자가 상태 잠금으로 직렬화하므로 공유해도 된다.
+    mutable std::string lookup_key_;
+};
+
+}  // namespace state
@@ -0,0 +1,61 @@
+/*
+ * 설명: 연결별 명령/송신 속도를 제한하는 GCRA(토큰 버킷과 동등) 리미터. 연결당 정수 하나만 두고 O(1)로 판정한다.
+ * 버전: v1.1.0
+ * 관련 문서: design/protocol/contract.md, design/server/v1.1.0-performance.md
+ * 테스트: tests/unit/rate_limiter_test.cpp
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace state {
+
+// window_ms 동안 limit번. 한꺼번에 limit번까지 허용하고 이후 window_ms / limit마다 한 번씩 다시 채운다.
+// 계산은 마이크로초 단위라 limit이 window_ms보다 커도 간격이 0이 되지 않는다.
+struct RatePolicy {
+    std::uint64_t interval_us;
+    std::uint64_t burst_us;  // (limit - 1) * interval_us
+
+    RatePolicy() : interval_us(0), burst_us(0) {}
+
+    // limit이 0이면 제한하지 않는다.
+    static RatePolicy PerWindow(std::size_t limit, std::uint64_t window_ms) {
+        RatePolicy policy;
+        if (limit == 0) {
+            return policy;
+        }
+        policy.interval_us = window_ms * 1000 / limit;
+        if (policy.interval_us == 0) {
+            policy.interval_us = 1;
+        }
+        policy.burst_us = policy.interval_us * (limit - 1);
+        return policy;
+    }
+
+    bool Enabled() const { return interval_us != 0; }
+};
+
+// 이론상 다음 도착 시각(TAT) 하나로 버킷 상태를 나타낸다. 토큰 개수와 마지막 충전 시각을 따로 둘 필요가 없다.
+class RateLimiter {
+   public:
+    RateLimiter() : tat_us_(0) {}
+
+    // now_ms 시점에 토큰 하나를 쓴다. 남은 토큰이 없으면 상태를 바꾸지 않고 false를 돌려준다.
+    bool TryAcquire(const RatePolicy &policy, std::uint64_t now_ms) {
+        if (!policy.Enabled()) {
+            return true;
+        }
+        const std::uint64_t now_us = now_ms * 1000;
+        if (tat_us_ > now_us + policy.burst_us) {
+            return false;
+        }
+        tat_us_ = (tat_us_ > now_us ? tat_us_ : now_us) + policy.interval_us;
+        return true;
+    }
+
+   private:
+    std::uint64_t tat_us_;
+};
+
+}  // namespace state
@@ -1,7 +1,7 @@
 /*
  * 설명: INI 설정 파일을 로드해 서버 설정 구조체를 생성한다.
- * 버전: v0.9.0
- * 관련 문서: design/protocol/contract.md, design/server/v0.8.0-config-logging.md, design/server/v0.9.0-defensive.md
+ * 버전: v1.1.0
+ * 관련 문서: design/protocol/contract.md, design/server/v0.8.0-config-logging.md, design/server/v0.9.0-defensive.md, design/server/v1.1.0-performance.md
  * 테스트: tests/unit/config_parser_test.cpp
  */
 #pragma once
@@ -11,13 +11,46 @@
 namespace config {
 
 enum class LogLevel { kDebug = 0, kInfo = 1, kWarn = 2, kError = 3 };
+enum class IoBackend { kPoll = 0, kEpoll = 1 };
 
 struct Settings {
     std::string server_name;
     LogLevel log_level;
     std::string log_file;
+    // 5초당 명령 수 상한. 0이면 제한하지 않는다.
     std::size_t messages_per_5s;
-    std::size_t outbound_lines;
+    std::size_t joins_per_5s;
+    std::size_t nicks_per_5s;
+    // 연결별 송신 큐 워터마크와 전체 송신 메모리 상한(바이트). total이 0이면 전체 상한이 없다.
+    std::size_t outbound_high_bytes;
+    std::size_t outbound_low_bytes;
+    std::size_t outbound_total_bytes;
+    // 송신 큐 청크 풀이 비어 있는 청크로 남겨 둘 수 있는 바이트 합(모든 샤드). 넘는 청크는 바로 해제한다.
+    std::size_t outbound_pool_bytes;
+    IoBackend io_backend;
+    std::size_t write_budget_bytes;
+    // 연결별 입력 링 크기(recv 한 번의 최대 크기)와 이벤트 루프 한 바퀴에 연결 하나가 쓸 수 있는 읽기 예산.
+    std::size_t read_buffer_bytes;
+    std::size_t read_budget_bytes;
+    std::size_t read_budget_lines;
+    // 이벤트 루프 스레드 수. 0이면 하드웨어 스레드 수를 쓴다.
+    std::size_t io_threads;
+    std::size_t socket_sndbuf;
+    std::size_t socket_rcvbuf;
+    bool tcp_nodelay;
+    std::size_t tcp_notsent_lowat;
+    bool tcp_keepalive;
+    std::size_t tcp_keepalive_idle;
+    std::size_t listen_backlog;
+    // [timeouts] 초 단위, 0이면 해당 검사를 끈다.
+    std::size_t registration_timeout;
+    std::size_t ping_interval;
+    std::size_t pong_timeout;
+    std::size_t send_stall_timeout;
+    // OPER 비밀번호. 비어 있으면 아무도 서버 운영자가 될 수 없다.
+    std::string oper_password;
+    // 지표를 Prometheus 텍스트로 내주는 Unix 소켓 경로. 비어 있으면 열지 않는다(기동 시에만 적용).
+    std::string metrics_socket;
 
     Settings();
 };
@@ -1,30 +1,95 @@
 /*
- * 설명: 로그 레벨과 출력 경로를 제어하는 단순 로거를 제공한다.
- * 버전: v0.8.0
- * 관련 문서: design/server/v0.8.0-config-logging.md
- * 테스트: tests/unit/config_parser_test.cpp (설정 적용 경로), tests/e2e/test_rehash.py
+ * 설명: 로그 레벨과 출력 경로를 제어하고, 이벤트 루프 스레드 대신 백그라운드 스레드가 모아서 쓰는 비동기 로거를 제공한다.
+ * 버전: v1.1.0
+ * 관련 문서: design/server/v0.8.0-config-logging.md, design/server/v1.1.0-performance.md
+ * 테스트: tests/unit/logger_test.cpp, tests/unit/config_parser_test.cpp (설정 적용 경로), tests/e2e/test_rehash.py
  */
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
 #include <fstream>
+#include <memory>
+#include <mutex>
+#include <sstream>
 #include <string>
+#include <thread>
+#include <vector>
 
+#include "net/spsc_ring.hpp"
 #include "utils/config.hpp"
 
+// 스트림 식은 레벨이 켜져 있을 때만 평가한다. 꺼진 레벨은 분기 하나로 끝난다.
+//   IRC_LOG(logger_, config::LogLevel::kWarn, "송신 큐 초과: fd=" << fd);
+#define IRC_LOG(logger, level, stream)                      \
+    do {                                                    \
+        if ((logger).Enabled(level)) {                      \
+            std::ostringstream irc_log_stream_;             \
+            irc_log_stream_ << stream;                      \
+            (logger).Log((level), irc_log_stream_.str());   \
+        }                                                   \
+    } while (0)
+
+// 로그를 남기는 스레드마다 단일 생산자 링을 하나씩 두고, 백그라운드 스레드 하나가 모든 링을 비워
+// 한 번의 쓰기와 flush로 내보낸다. 링이 가득 차면 그 라인은 버리고 개수만 센다.
+// 백그라운드 스레드는 쌓인 라인이 없으면 깨울 때까지 잠들고, 라인이 생긴 뒤에만 kFlushIntervalMs 주기로 모아 쓴다.
 class Logger {
    public:
-    Logger();
+    static const std::size_t kDefaultRingCapacity = 4096;
+    static const int kFlushIntervalMs = 50;
+
+    explicit Logger(std::size_t ring_capacity = kDefaultRingCapacity);
+    ~Logger();
+
+    Logger(const Logger &) = delete;
+    Logger &operator=(const Logger &) = delete;
 
     void SetLevel(config::LogLevel level);
     void SetOutput(const std::string &path);
+    bool Enabled(config::LogLevel level) const {
+        return static_cast<int>(level) >= level_.load(std::memory_order_relaxed);
+    }
     void Log(config::LogLevel level, const std::string &message);
 
+    // 호출 전에 넣은 라인을 백그라운드 스레드가 모두 쓸 때까지 기다린다.
+    void Flush();
+    std::uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+    // 백그라운드 스레드가 링을 비운 횟수. 유휴 중 주기적으로 깨어나지 않는지 확인하는 데 쓴다.
+    std::uint64_t writer_wakeups() const { return writer_wakeups_.load(std::memory_order_relaxed); }
+
    private:
-    config::LogLevel level_;
+    typedef net::SpscRing<std::string> Ring;
+
+    const std::uint64_t id_;
+    const std::size_t ring_capacity_;
+    std::atomic<int> level_;
+    std::atomic<std::uint64_t> dropped_;
+
+    std::mutex rings_mutex_;
+    std::vector<std::unique_ptr<Ring> > rings_;
+
+    // 백그라운드 스레드 깨우기와 Flush 완료 대기에 쓴다.
+    std::mutex wake_mutex_;
+    std::condition_variable wake_;
+    std::condition_variable flushed_;
+    std::atomic<bool> wake_requested_;
+    // 백그라운드 스레드가 마지막으로 비운 뒤 들어온 라인이 있는지. false→true로 바꾼 생산자만 깨운다.
+    std::atomic<bool> pending_;
+    std::atomic<std::uint64_t> writer_wakeups_;
+    bool stopping_;
+    std::uint64_t flush_requested_;
+    std::uint64_t flush_completed_;
+
+    // 출력 대상은 백그라운드 스레드와 SetOutput만 만진다.
+    std::mutex output_mutex_;
     std::string path_;
     std::ofstream file_;
 
-    bool IsEnabled(config::LogLevel level) const;
-    void WriteLine(const std::string &line);
-};
+    std::thread writer_;
 
+    Ring &LocalRing();
+    void RunWriter();
+    void WriteBatch(std::string &batch, std::uint64_t &reported_drops);
+};
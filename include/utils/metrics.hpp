@@ -0,0 +1,110 @@
+/*
+ * 설명: 스레드마다 따로 쓰는 카운터와 고정 구간 로그-선형(HDR 방식) 히스토그램, 그리고 Prometheus 텍스트 형식 출력기를 제공한다.
+ * 버전: v1.1.0
+ * 관련 문서: design/protocol/contract.md, design/server/v1.1.0-performance.md
+ * 테스트: tests/unit/metrics_test.cpp
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace metrics {
+
+// 값 v를 2의 거듭제곱 구간마다 16칸으로 나눈 칸 번호로 바꾼다. 칸 너비가 값의 1/16 이하라 상대 오차가 6% 안이다.
+// 16 미만은 값 그대로 한 칸씩 쓰고, 2^48 이상은 마지막 칸에 모은다.
+const std::size_t kSubBuckets = 16;
+const std::size_t kBucketCount = kSubBuckets + 44 * kSubBuckets;
+
+std::size_t BucketIndex(std::uint64_t value);
+// 칸의 가운데 값. 백분위수를 돌려줄 때 쓴다.
+std::uint64_t BucketMiddle(std::size_t index);
+
+// 읽기 전용 사본. 여러 샤드의 히스토그램을 더하고 백분위수를 계산한다. 한 스레드 안에서는 직접 Record해도 된다.
+class HistogramSnapshot {
+   public:
+    HistogramSnapshot();
+
+    void Record(std::uint64_t value);
+    void Add(std::size_t index, std::uint64_t count) { buckets_[index] += count; }
+    void AddTotals(std::uint64_t count, std::uint64_t sum, std::uint64_t max);
+
+    std::uint64_t count() const { return count_; }
+    std::uint64_t sum() const { return sum_; }
+    std::uint64_t max() const { return max_; }
+    // p는 0~1. 해당 순위가 든 칸의 가운데 값을 max로 눌러 돌려준다. 비어 있으면 0이다.
+    std::uint64_t Percentile(double p) const;
+
+   private:
+    std::uint64_t buckets_[kBucketCount];
+    std::uint64_t count_;
+    std::uint64_t sum_;
+    std::uint64_t max_;
+};
+
+// 쓰는 스레드가 하나뿐인 카운터. 다른 스레드는 Load로 근사치를 읽는다.
+// fetch_add 대신 load + store를 써서 쓰는 쪽에 잠금 접두 명령이 없다.
+class Counter {
+   public:
+    Counter() : value_(0) {}
+
+    void Add(std::uint64_t n = 1) {
+        value_.store(value_.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+    std::uint64_t Load() const { return value_.load(std::memory_order_relaxed); }
+
+   private:
+    std::atomic<std::uint64_t> value_;
+};
+
+// 쓰는 스레드가 하나뿐인 히스토그램. Record는 칸 하나와 합계만 갱신한다.
+class Histogram {
+   public:
+    Histogram();
+
+    Histogram(const Histogram &) = delete;
+    Histogram &operator=(const Histogram &) = delete;
+
+    void Record(std::uint64_t value) {
+        std::atomic<std::uint64_t> &bucket = buckets_[BucketIndex(value)];
+        bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        count_.Add();
+        sum_.Add(value);
+        if (value > max_.load(std::memory_order_relaxed)) {
+            max_.store(value, std::memory_order_relaxed);
+        }
+    }
+
+    std::uint64_t count() const { return count_.Load(); }
+
+    // 다른 스레드에서 불러도 된다. 쓰는 도중이면 칸 합과 count가 조금 어긋날 수 있다.
+    void AddTo(HistogramSnapshot &out) const;
+
+   private:
+    std::atomic<std::uint64_t> buckets_[kBucketCount];
+    Counter count_;
+    Counter sum_;
+    std::atomic<std::uint64_t> max_;
+};
+
+// Prometheus 텍스트 노출 형식(0.0.4). 같은 이름의 표본은 Family 뒤에 이어서 쓴다.
+class TextWriter {
+   public:
+    // type: counter, gauge, summary
+    void Family(std::string_view name, std::string_view type, std::string_view help);
+    // labels는 `a="x",b="y"` 형식이며 비어 있으면 중괄호를 쓰지 않는다.
+    void Value(std::string_view name, std::string_view labels, double value);
+    // 0.5/0.99/0.999 분위수와 _sum, _count를 쓴다. scale은 기록 단위를 출력 단위로 바꾸는 배수다.
+    void Summary(std::string_view name, std::string_view labels, const HistogramSnapshot &histogram,
+                 double scale);
+
+    const std::string &Text() const { return text_; }
+
+   private:
+    std::string text_;
+};
+
+}  // namespace metrics
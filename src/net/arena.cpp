@@ -0,0 +1,68 @@
+/*
+ * 설명: 블록을 이어 붙이는 범프 할당기를 구현한다. Reset은 블록을 돌려주지 않고 위치만 되감는다.
+ * 버전: v1.1.0
+ * 관련 문서: design/server/v1.1.0-performance.md
+ * 테스트: tests/unit/arena_test.cpp
+ */
+#include "net/arena.hpp"
+
+#include <cstdint>
+#include <new>
+
+namespace net {
+
+Arena::Arena(std::size_t block_size)
+    : block_size_(block_size == 0 ? 1 : block_size), current_(0), offset_(0), used_(0), high_water_(0) {
+    // 첫 블록은 미리 잡아 두어 정상 상태의 첫 묶음에서도 할당이 없게 한다.
+    Block first = {static_cast<char *>(::operator new(block_size_)), block_size_};
+    blocks_.push_back(first);
+}
+
+Arena::~Arena() {
+    for (std::size_t i = 0; i < blocks_.size(); ++i) {
+        ::operator delete(blocks_[i].data);
+    }
+}
+
+void Arena::Reset() {
+    current_ = 0;
+    offset_ = 0;
+    used_ = 0;
+}
+
+void *Arena::TryBump(std::size_t bytes, std::size_t alignment) {
+    const Block &block = blocks_[current_];
+    const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(block.data);
+    const std::uintptr_t aligned = (base + offset_ + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+    const std::size_t start = static_cast<std::size_t>(aligned - base);
+    if (start > block.size || block.size - start < bytes) {
+        return nullptr;
+    }
+    offset_ = start + bytes;
+    return block.data + start;
+}
+
+void *Arena::do_allocate(std::size_t bytes, std::size_t alignment) {
+    void *ptr = TryBump(bytes, alignment);
+    // 현재 블록이 모자라면 뒤에 남겨 둔 블록을 차례로 쓰고, 다 모자라면 새 블록을 붙인다.
+    while (ptr == nullptr && current_ + 1 < blocks_.size()) {
+        ++current_;
+        offset_ = 0;
+        ptr = TryBump(bytes, alignment);
+    }
+    if (ptr == nullptr) {
+        const std::size_t size = bytes + alignment > block_size_ ? bytes + alignment : block_size_;
+        Block block = {static_cast<char *>(::operator new(size)), size};
+        blocks_.push_back(block);
+        current_ = blocks_.size() - 1;
+        offset_ = 0;
+        ptr = TryBump(bytes, alignment);
+    }
+    used_ += bytes;
+    if (used_ > high_water_) {
+        high_water_ = used_;
+    }
+    return ptr;
+}
+
+}  // namespace net
@@ -0,0 +1,240 @@
+/*
+ * 설명: 청크/구간 풀과 구간 사슬 송신 큐, 공유 라인 게시를 구현한다.
+ * 버전: v1.1.0
+ * 관련 문서: design/server/v1.1.0-performance.md
+ * 테스트: tests/unit/outbound_queue_test.cpp
+ */
+#include "net/outbound_queue.hpp"
+
+#include <cstring>
+
+namespace net {
+
+static_assert(sizeof(OutboundChunk) == kOutboundChunkBytes, "청크는 헤더 포함 4KiB여야 한다");
+
+namespace {
+// 쓰는 스레드가 하나뿐이라 잠금 접두 명령 없이 load + store로 올린다.
+template <typename T>
+void Add(std::atomic<T> &value, T delta) {
+    value.store(value.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+}
+
+template <typename T>
+void Sub(std::atomic<T> &value, T delta) {
+    value.store(value.load(std::memory_order_relaxed) - delta, std::memory_order_relaxed);
+}
+}  // namespace
+
+ChunkPool::ChunkPool(std::size_t max_free)
+    : free_(nullptr),
+      free_segments_(nullptr),
+      free_segment_count_(0),
+      published_(nullptr),
+      max_free_(max_free),
+      free_count_(0),
+      in_use_(0),
+      allocations_(0) {}
+
+ChunkPool::~ChunkPool() {
+    if (published_ != nullptr) {
+        Unref(published_);
+    }
+    while (free_ != nullptr) {
+        OutboundChunk *next = free_->next;
+        delete free_;
+        free_ = next;
+    }
+    while (free_segments_ != nullptr) {
+        OutboundSegment *next = free_segments_->next;
+        delete free_segments_;
+        free_segments_ = next;
+    }
+}
+
+OutboundChunk *ChunkPool::Acquire() {
+    OutboundChunk *chunk = free_;
+    if (chunk != nullptr) {
+        free_ = chunk->next;
+        Sub(free_count_, static_cast<std::size_t>(1));
+    } else {
+        chunk = new OutboundChunk;
+        Add(allocations_, static_cast<std::uint64_t>(1));
+    }
+    chunk->next = nullptr;
+    chunk->refs = 1;
+    chunk->used = 0;
+    Add(in_use_, static_cast<std::size_t>(1));
+    return chunk;
+}
+
+void ChunkPool::Unref(OutboundChunk *chunk) {
+    if (--chunk->refs != 0) {
+        return;
+    }
+    Sub(in_use_, static_cast<std::size_t>(1));
+    if (free_count_.load(std::memory_order_relaxed) >= max_free_.load(std::memory_order_relaxed)) {
+        delete chunk;
+        return;
+    }
+    chunk->next = free_;
+    free_ = chunk;
+    Add(free_count_, static_cast<std::size_t>(1));
+}
+
+OutboundSegment *ChunkPool::AcquireSegment() {
+    OutboundSegment *segment = free_segments_;
+    if (segment != nullptr) {
+        free_segments_ = segment->next;
+        --free_segment_count_;
+    } else {
+        segment = new OutboundSegment;
+    }
+    segment->next = nullptr;
+    return segment;
+}
+
+void ChunkPool::ReleaseSegment(OutboundSegment *segment) {
+    if (free_segment_count_ >= max_free_.load(std::memory_order_relaxed) * kSegmentsPerChunk) {
+        delete segment;
+        return;
+    }
+    segment->next = free_segments_;
+    free_segments_ = segment;
+    ++free_segment_count_;
+}
+
+OutboundSlice ChunkPool::Publish(std::string_view data) {
+    if (published_ == nullptr || OutboundChunk::kCapacity - published_->used < data.size()) {
+        // 찬 게시 청크는 풀의 몫만 놓는다. 아직 보내지 않은 큐가 있으면 그 큐들이 다 보낼 때 돌아온다.
+        if (published_ != nullptr) {
+            Unref(published_);
+        }
+        published_ = Acquire();
+    }
+    OutboundSlice slice;
+    slice.chunk = published_;
+    slice.begin = published_->used;
+    std::memcpy(published_->data + published_->used, data.data(), data.size());
+    published_->used += static_cast<std::uint32_t>(data.size());
+    slice.end = published_->used;
+    return slice;
+}
+
+OutboundQueue::OutboundQueue(OutboundQueue &&other) noexcept
+    : head_(other.head_), tail_(other.tail_), pool_(other.pool_), size_(other.size_) {
+    other.head_ = nullptr;
+    other.tail_ = nullptr;
+    other.size_ = 0;
+}
+
+OutboundQueue &OutboundQueue::operator=(OutboundQueue &&other) noexcept {
+    if (this != &other) {
+        Clear();
+        head_ = other.head_;
+        tail_ = other.tail_;
+        pool_ = other.pool_;
+        size_ = other.size_;
+        other.head_ = nullptr;
+        other.tail_ = nullptr;
+        other.size_ = 0;
+    }
+    return *this;
+}
+
+void OutboundQueue::Link(OutboundSegment *segment) {
+    if (tail_ == nullptr) {
+        head_ = segment;
+    } else {
+        tail_->next = segment;
+    }
+    tail_ = segment;
+}
+
+void OutboundQueue::Append(ChunkPool &pool, std::string_view data) {
+    pool_ = &pool;
+    size_ += data.size();
+    while (!data.empty()) {
+        // 꼬리 구간이 청크를 혼자 쓰고 그 끝이 청크의 쓴 끝일 때만 이어 쓴다. 게시 청크에는 쓰지 않는다.
+        if (tail_ == nullptr || tail_->chunk->refs != 1 || tail_->end != tail_->chunk->used ||
+            tail_->end == OutboundChunk::kCapacity) {
+            OutboundSegment *segment = pool.AcquireSegment();
+            segment->chunk = pool.Acquire();
+            segment->begin = 0;
+            segment->end = 0;
+            Link(segment);
+        }
+        OutboundChunk *chunk = tail_->chunk;
+        std::size_t room = OutboundChunk::kCapacity - chunk->used;
+        std::size_t length = data.size() < room ? data.size() : room;
+        std::memcpy(chunk->data + chunk->used, data.data(), length);
+        chunk->used += static_cast<std::uint32_t>(length);
+        tail_->end = chunk->used;
+        data.remove_prefix(length);
+    }
+}
+
+void OutboundQueue::AppendShared(ChunkPool &pool, const OutboundSlice &slice) {
+    pool_ = &pool;
+    size_ += slice.end - slice.begin;
+    // 같은 게시 청크에서 바로 이어지는 라인이면 구간을 늘리기만 한다(브로드캐스트가 잇따를 때 iovec도 하나로 모인다).
+    if (tail_ != nullptr && tail_->chunk == slice.chunk && tail_->end == slice.begin) {
+        tail_->end = slice.end;
+        return;
+    }
+    OutboundSegment *segment = pool.AcquireSegment();
+    segment->chunk = slice.chunk;
+    segment->begin = slice.begin;
+    segment->end = slice.end;
+    ++slice.chunk->refs;
+    Link(segment);
+}
+
+int OutboundQueue::Gather(struct iovec *iov, int max_iov, std::size_t limit) const {
+    int count = 0;
+    std::size_t gathered = 0;
+    for (const OutboundSegment *segment = head_; segment != nullptr && count < max_iov && gathered < limit;
+         segment = segment->next) {
+        std::size_t length = segment->end - segment->begin;
+        if (length > limit - gathered) {
+            length = limit - gathered;
+        }
+        iov[count].iov_base = segment->chunk->data + segment->begin;
+        iov[count].iov_len = length;
+        gathered += length;
+        ++count;
+    }
+    return count;
+}
+
+void OutboundQueue::Consume(std::size_t bytes) {
+    size_ -= bytes;
+    while (bytes > 0) {
+        std::size_t available = head_->end - head_->begin;
+        if (bytes < available) {
+            head_->begin += static_cast<std::uint32_t>(bytes);
+            return;
+        }
+        bytes -= available;
+        OutboundSegment *next = head_->next;
+        // 다 보낸 구간은 꼬리여도 돌려줘 유휴 연결이 청크를 쥐지 않게 한다.
+        pool_->Unref(head_->chunk);
+        pool_->ReleaseSegment(head_);
+        head_ = next;
+    }
+    if (head_ == nullptr) {
+        tail_ = nullptr;
+    }
+}
+
+void OutboundQueue::Clear() {
+    while (head_ != nullptr) {
+        OutboundSegment *next = head_->next;
+        pool_->Unref(head_->chunk);
+        pool_->ReleaseSegment(head_);
+        head_ = next;
+    }
+    tail_ = nullptr;
+    size_ = 0;
+}
+
+}  // namespace net
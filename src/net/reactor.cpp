@@ -0,0 +1,217 @@
+/*
+ * 설명: poll/epoll 리액터 백엔드를 구현한다. epoll은 엣지 트리거로 등록해 준비된 fd 수에 비례하는 비용만 든다.
+ * 버전: v1.1.0
+ * 관련 문서: design/server/v1.1.0-performance.md
+ * 테스트: tests/e2e
+ */
+#include "net/reactor.hpp"
+
+#include <unistd.h>
+
+#include <cerrno>
+
+namespace net {
+
+namespace {
+#if defined(__linux__)
+const std::size_t kEpollBatch = 256;
+
+unsigned ToEpollEvents(unsigned interest) {
+    unsigned events = EPOLLET;
+    if (interest & kEventRead) {
+        events |= EPOLLIN;
+    }
+    if (interest & kEventWrite) {
+        events |= EPOLLOUT;
+    }
+    return events;
+}
+#endif
+
+short ToPollEvents(unsigned interest) {
+    short events = 0;
+    if (interest & kEventRead) {
+        events |= POLLIN;
+    }
+    if (interest & kEventWrite) {
+        events |= POLLOUT;
+    }
+    return events;
+}
+}  // namespace
+
+int PollReactor::SlotOf(int fd) const {
+    if (fd < 0 || static_cast<std::size_t>(fd) >= slot_by_fd_.size()) {
+        return -1;
+    }
+    return slot_by_fd_[fd];
+}
+
+bool PollReactor::Add(int fd, unsigned interest) {
+    if (fd < 0 || SlotOf(fd) >= 0) {
+        return false;
+    }
+    if (static_cast<std::size_t>(fd) >= slot_by_fd_.size()) {
+        slot_by_fd_.resize(static_cast<std::size_t>(fd) + 1, -1);
+    }
+    struct pollfd pfd;
+    pfd.fd = fd;
+    pfd.events = ToPollEvents(interest);
+    pfd.revents = 0;
+    slot_by_fd_[fd] = static_cast<int>(poll_fds_.size());
+    poll_fds_.push_back(pfd);
+    return true;
+}
+
+void PollReactor::Modify(int fd, unsigned interest) {
+    int slot = SlotOf(fd);
+    if (slot < 0) {
+        return;
+    }
+    poll_fds_[slot].events = ToPollEvents(interest);
+}
+
+// 마지막 원소를 빈 자리로 옮기고, 옮겨진 fd의 인덱스도 함께 갱신한다.
+void PollReactor::Remove(int fd) {
+    int slot = SlotOf(fd);
+    if (slot < 0) {
+        return;
+    }
+    const struct pollfd &last = poll_fds_.back();
+    slot_by_fd_[last.fd] = slot;
+    poll_fds_[slot] = last;
+    poll_fds_.pop_back();
+    slot_by_fd_[fd] = -1;
+}
+
+// 레벨 트리거이므로 남은 준비 상태는 다음 poll()에서 그대로 다시 보고된다.
+void PollReactor::Rearm(int) {}
+
+int PollReactor::Wait(std::vector<ReadyEvent> &out, int timeout_ms) {
+    out.clear();
+    int ret = poll(poll_fds_.data(), poll_fds_.size(), timeout_ms);
+    if (ret <= 0) {
+        return ret;
+    }
+    for (std::size_t i = 0; i < poll_fds_.size(); ++i) {
+        short revents = poll_fds_[i].revents;
+        if (revents == 0) {
+            continue;
+        }
+        poll_fds_[i].revents = 0;
+
+        ReadyEvent ev;
+        ev.fd = poll_fds_[i].fd;
+        ev.events = 0;
+        if (revents & (POLLHUP | POLLERR | POLLNVAL)) {
+            ev.events |= kEventError;
+        }
+        if (revents & POLLIN) {
+            ev.events |= kEventRead;
+        }
+        if (revents & POLLOUT) {
+            ev.events |= kEventWrite;
+        }
+        out.push_back(ev);
+    }
+    return static_cast<int>(out.size());
+}
+
+#if defined(__linux__)
+EpollReactor::EpollReactor() : epoll_fd_(epoll_create1(EPOLL_CLOEXEC)), buffer_(kEpollBatch) {}
+
+EpollReactor::~EpollReactor() {
+    if (epoll_fd_ >= 0) {
+        close(epoll_fd_);
+    }
+}
+
+bool EpollReactor::Control(int op, int fd, unsigned interest) {
+    struct epoll_event ev;
+    ev.events = ToEpollEvents(interest);
+    ev.data.fd = fd;
+    return epoll_ctl(epoll_fd_, op, fd, &ev) == 0;
+}
+
+bool EpollReactor::Add(int fd, unsigned interest) {
+    if (fd < 0) {
+        return false;
+    }
+    if (!Control(EPOLL_CTL_ADD, fd, interest)) {
+        return false;
+    }
+    if (static_cast<std::size_t>(fd) >= interest_.size()) {
+        interest_.resize(static_cast<std::size_t>(fd) + 1, 0);
+    }
+    interest_[fd] = interest;
+    return true;
+}
+
+void EpollReactor::Modify(int fd, unsigned interest) {
+    if (fd < 0 || static_cast<std::size_t>(fd) >= interest_.size() || interest_[fd] == 0) {
+        return;
+    }
+    if (interest_[fd] == interest) {
+        return;
+    }
+    if (Control(EPOLL_CTL_MOD, fd, interest)) {
+        interest_[fd] = interest;
+    }
+}
+
+void EpollReactor::Remove(int fd) {
+    if (fd < 0 || static_cast<std::size_t>(fd) >= interest_.size() || interest_[fd] == 0) {
+        return;
+    }
+    epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, NULL);
+    interest_[fd] = 0;
+}
+
+// EPOLL_CTL_MOD는 현재 준비 상태를 다시 평가하므로 읽기/쓰기 가능한 fd는 다음 Wait에서 다시 보고된다.
+void EpollReactor::Rearm(int fd) {
+    if (fd < 0 || static_cast<std::size_t>(fd) >= interest_.size() || interest_[fd] == 0) {
+        return;
+    }
+    Control(EPOLL_CTL_MOD, fd, interest_[fd]);
+}
+
+int EpollReactor::Wait(std::vector<ReadyEvent> &out, int timeout_ms) {
+    out.clear();
+    int ret = epoll_wait(epoll_fd_, buffer_.data(), static_cast<int>(buffer_.size()), timeout_ms);
+    if (ret <= 0) {
+        return ret;
+    }
+    for (int i = 0; i < ret; ++i) {
+        ReadyEvent ev;
+        ev.fd = buffer_[i].data.fd;
+        ev.events = 0;
+        if (buffer_[i].events & (EPOLLHUP | EPOLLERR)) {
+            ev.events |= kEventError;
+        }
+        if (buffer_[i].events & EPOLLIN) {
+            ev.events |= kEventRead;
+        }
+        if (buffer_[i].events & EPOLLOUT) {
+            ev.events |= kEventWrite;
+        }
+        out.push_back(ev);
+    }
+    return ret;
+}
+#endif
+
+std::unique_ptr<Reactor> CreateReactor(config::IoBackend backend) {
+#if defined(__linux__)
+    if (backend == config::IoBackend::kEpoll) {
+        std::unique_ptr<EpollReactor> epoll(new EpollReactor());
+        if (epoll->Valid()) {
+            return std::unique_ptr<Reactor>(epoll.release());
+        }
+    }
+#else
+    (void)backend;
+#endif
+    return std::unique_ptr<Reactor>(new PollReactor());
+}
+
+}  // namespace net
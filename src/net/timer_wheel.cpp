@@ -0,0 +1,200 @@
+/*
+ * 설명: 계층형 타이머 휠을 구현한다. 기한까지의 거리로 단을 고르고, 0단이 한 바퀴 돌 때마다 윗단 슬롯 하나를 아래로 내려보낸다.
+ * 버전: v1.1.0
+ * 관련 문서: design/server/v1.1.0-performance.md
+ * 테스트: tests/unit/timer_wheel_test.cpp
+ */
+#include "net/timer_wheel.hpp"
+
+#include <climits>
+
+namespace net {
+
+namespace {
+// 가장 낮은 비트의 위치. value는 0이 아니어야 한다.
+int LowestBit(std::uint64_t value) {
+    int index = 0;
+    while ((value & 1u) == 0) {
+        value >>= 1;
+        ++index;
+    }
+    return index;
+}
+}  // namespace
+
+TimerWheel::TimerWheel(std::uint64_t tick_ms, std::uint64_t start_ms)
+    : tick_ms_(tick_ms > 0 ? tick_ms : 1), current_(start_ms / tick_ms_), free_head_(kNil), size_(0) {
+    for (std::uint32_t i = 0; i < kLevels * kSlots; ++i) {
+        heads_[i] = kNil;
+    }
+    for (int level = 0; level < kLevels; ++level) {
+        occupied_[level] = 0;
+    }
+}
+
+std::uint64_t TimerWheel::ToTick(std::uint64_t ms) const { return (ms + tick_ms_ - 1) / tick_ms_; }
+
+TimerId TimerWheel::Schedule(std::uint64_t key, std::uint64_t deadline_ms) {
+    std::uint32_t index;
+    if (free_head_ != kNil) {
+        index = free_head_;
+        free_head_ = nodes_[index].next;
+    } else {
+        index = static_cast<std::uint32_t>(nodes_.size());
+        nodes_.push_back(Node());
+    }
+    Node &node = nodes_[index];
+    node.key = key;
+    node.expiry = ToTick(deadline_ms);
+    if (node.expiry <= current_) {
+        node.expiry = current_ + 1;
+    }
+    Link(index);
+    ++size_;
+    return index;
+}
+
+void TimerWheel::Reschedule(TimerId id, std::uint64_t deadline_ms) {
+    Unlink(id);
+    Node &node = nodes_[id];
+    node.expiry = ToTick(deadline_ms);
+    if (node.expiry <= current_) {
+        node.expiry = current_ + 1;
+    }
+    Link(id);
+}
+
+void TimerWheel::Cancel(TimerId id) {
+    Unlink(id);
+    nodes_[id].bucket = kNil;
+    nodes_[id].next = free_head_;
+    free_head_ = id;
+    --size_;
+}
+
+void TimerWheel::Link(std::uint32_t index) {
+    Node &node = nodes_[index];
+    // 거리가 64^(l+1) 미만이면 l단에 둔다. 가장 윗단을 넘는 기한은 끝으로 당기며, 만료 시 호출자가 다시 건다.
+    const std::uint64_t max_delta = (static_cast<std::uint64_t>(1) << (kSlotBits * kLevels)) - 1;
+    if (node.expiry - current_ > max_delta) {
+        node.expiry = current_ + max_delta;
+    }
+    std::uint64_t delta = node.expiry - current_;
+    int level = 0;
+    while (level < kLevels - 1 && delta >= (static_cast<std::uint64_t>(1) << (kSlotBits * (level + 1)))) {
+        ++level;
+    }
+    std::uint32_t slot = static_cast<std::uint32_t>(node.expiry >> (kSlotBits * level)) & (kSlots - 1);
+    std::uint32_t bucket = static_cast<std::uint32_t>(level) * kSlots + slot;
+
+    node.bucket = bucket;
+    node.prev = kNil;
+    node.next = heads_[bucket];
+    if (node.next != kNil) {
+        nodes_[node.next].prev = index;
+    }
+    heads_[bucket] = index;
+    occupied_[level] |= static_cast<std::uint64_t>(1) << slot;
+}
+
+void TimerWheel::Unlink(std::uint32_t index) {
+    Node &node = nodes_[index];
+    if (node.prev != kNil) {
+        nodes_[node.prev].next = node.next;
+    } else {
+        heads_[node.bucket] = node.next;
+    }
+    if (node.next != kNil) {
+        nodes_[node.next].prev = node.prev;
+    }
+    if (heads_[node.bucket] == kNil) {
+        occupied_[node.bucket / kSlots] &= ~(static_cast<std::uint64_t>(1) << (node.bucket % kSlots));
+    }
+}
+
+void TimerWheel::Cascade(int level) {
+    std::uint32_t slot = static_cast<std::uint32_t>(current_ >> (kSlotBits * level)) & (kSlots - 1);
+    std::uint32_t bucket = static_cast<std::uint32_t>(level) * kSlots + slot;
+    std::uint32_t index = heads_[bucket];
+    heads_[bucket] = kNil;
+    occupied_[level] &= ~(static_cast<std::uint64_t>(1) << slot);
+    while (index != kNil) {
+        std::uint32_t next = nodes_[index].next;
+        Link(index);
+        index = next;
+    }
+}
+
+void TimerWheel::Advance(std::uint64_t now_ms, std::vector<std::uint64_t> &out) {
+    const std::uint64_t target = now_ms / tick_ms_;
+    while (current_ < target) {
+        if (size_ == 0) {
+            // 쉬는 동안의 틱은 돌 필요가 없다.
+            current_ = target;
+            return;
+        }
+        if (occupied_[0] == 0) {
+            // 0단이 비었으면 다음 내려보내기 직전까지 건너뛴다.
+            std::uint64_t wrap_end = current_ | (kSlots - 1);
+            if (wrap_end >= target) {
+                current_ = target;
+                return;
+            }
+            current_ = wrap_end;
+        }
+
+        ++current_;
+        // 윗단부터 내려보내야 같은 틱에 여러 단이 넘어갈 때 노드가 제자리를 찾는다.
+        int top = 0;
+        while (top < kLevels - 1 &&
+               (current_ & ((static_cast<std::uint64_t>(1) << (kSlotBits * (top + 1))) - 1)) == 0) {
+            ++top;
+        }
+        for (int level = top; level >= 1; --level) {
+            Cascade(level);
+        }
+
+        std::uint32_t bucket = static_cast<std::uint32_t>(current_) & (kSlots - 1);
+        std::uint32_t index = heads_[bucket];
+        heads_[bucket] = kNil;
+        occupied_[0] &= ~(static_cast<std::uint64_t>(1) << bucket);
+        while (index != kNil) {
+            Node &node = nodes_[index];
+            std::uint32_t next = node.next;
+            out.push_back(node.key);
+            node.bucket = kNil;
+            node.next = free_head_;
+            free_head_ = index;
+            --size_;
+            index = next;
+        }
+    }
+}
+
+int TimerWheel::NextTimeoutMs(std::uint64_t now_ms) const {
+    if (size_ == 0) {
+        return -1;
+    }
+    const std::uint32_t position = static_cast<std::uint32_t>(current_) & (kSlots - 1);
+    // 윗단에 타이머가 있으면 0단이 한 바퀴 도는 틱에 내려보내야 한다.
+    std::uint64_t next = (current_ | (kSlots - 1)) + 1;
+    if (occupied_[0] != 0) {
+        // 현재 위치 다음 슬롯부터 한 바퀴 돌도록 비트맵을 회전한다.
+        std::uint64_t rotated = occupied_[0];
+        if (position + 1 < kSlots) {
+            rotated = (occupied_[0] >> (position + 1)) | (occupied_[0] << (kSlots - position - 1));
+        }
+        std::uint64_t candidate = current_ + 1 + static_cast<std::uint64_t>(LowestBit(rotated));
+        if (candidate < next) {
+            next = candidate;
+        }
+    }
+    std::uint64_t next_ms = next * tick_ms_;
+    if (next_ms <= now_ms) {
+        return 0;
+    }
+    std::uint64_t wait = next_ms - now_ms;
+    return wait > static_cast<std::uint64_t>(INT_MAX) ? INT_MAX : static_cast<int>(wait);
+}
+
+}  // namespace net
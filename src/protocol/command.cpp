@@ -0,0 +1,148 @@
+/*
+ * 설명: 길이 + 첫 글자 switch로 명령 토큰을 식별자로 매핑한다.
+ * 버전: v1.1.0
+ * 관련 문서: design/protocol/contract.md, design/server/v1.1.0-performance.md
+ * 테스트: tests/unit/message_test.cpp
+ */
+#include "protocol/command.hpp"
+
+namespace protocol {
+
+namespace {
+// 명령 이름은 모두 영문자이므로 0x20 비트를 켜면 대소문자 무시 비교가 된다.
+// 영문자가 아닌 바이트는 이 변환으로 소문자 범위에 들어오지 않아 잘못 일치하지 않는다.
+inline char Fold(char c) { return static_cast<char>(c | 0x20); }
+
+// 길이와 첫 글자는 switch에서 이미 맞췄으므로 두 번째 글자부터 비교한다.
+inline bool MatchRest(std::string_view token, const char *lower) {
+    for (std::size_t i = 1; i < token.size(); ++i) {
+        if (Fold(token[i]) != lower[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+}  // namespace
+
+CommandId LookupCommand(std::string_view token) {
+    if (token.empty()) {
+        return CommandId::kUnknown;
+    }
+    const char first = Fold(token[0]);
+    switch (token.size()) {
+        case 4:
+            switch (first) {
+                case 'p':
+                    if (MatchRest(token, "ping")) {
+                        return CommandId::kPing;
+                    }
+                    if (MatchRest(token, "pong")) {
+                        return CommandId::kPong;
+                    }
+                    if (MatchRest(token, "pass")) {
+                        return CommandId::kPass;
+                    }
+                    if (MatchRest(token, "part")) {
+                        return CommandId::kPart;
+                    }
+                    break;
+                case 'n':
+                    return MatchRest(token, "nick") ? CommandId::kNick : CommandId::kUnknown;
+                case 'u':
+                    return MatchRest(token, "user") ? CommandId::kUser : CommandId::kUnknown;
+                case 'j':
+                    return MatchRest(token, "join") ? CommandId::kJoin : CommandId::kUnknown;
+                case 'k':
+                    return MatchRest(token, "kick") ? CommandId::kKick : CommandId::kUnknown;
+                case 'm':
+                    return MatchRest(token, "mode") ? CommandId::kMode : CommandId::kUnknown;
+                case 'l':
+                    return MatchRest(token, "list") ? CommandId::kList : CommandId::kUnknown;
+                case 'q':
+                    return MatchRest(token, "quit") ? CommandId::kQuit : CommandId::kUnknown;
+                case 'o':
+                    return MatchRest(token, "oper") ? CommandId::kOper : CommandId::kUnknown;
+                default:
+                    break;
+            }
+            break;
+        case 5:
+            if (first == 't' && MatchRest(token, "topic")) {
+                return CommandId::kTopic;
+            }
+            if (first == 'n' && MatchRest(token, "names")) {
+                return CommandId::kNames;
+            }
+            if (first == 's' && MatchRest(token, "stats")) {
+                return CommandId::kStats;
+            }
+            break;
+        case 6:
+            if (first == 'n' && MatchRest(token, "notice")) {
+                return CommandId::kNotice;
+            }
+            if (first == 'i' && MatchRest(token, "invite")) {
+                return CommandId::kInvite;
+            }
+            if (first == 'r' && MatchRest(token, "rehash")) {
+                return CommandId::kRehash;
+            }
+            break;
+        case 7:
+            if (first == 'p' && MatchRest(token, "privmsg")) {
+                return CommandId::kPrivmsg;
+            }
+            break;
+        default:
+            break;
+    }
+    return CommandId::kUnknown;
+}
+
+const char *CommandName(CommandId id) {
+    switch (id) {
+        case CommandId::kPing:
+            return "PING";
+        case CommandId::kPong:
+            return "PONG";
+        case CommandId::kPass:
+            return "PASS";
+        case CommandId::kNick:
+            return "NICK";
+        case CommandId::kUser:
+            return "USER";
+        case CommandId::kJoin:
+            return "JOIN";
+        case CommandId::kPart:
+            return "PART";
+        case CommandId::kPrivmsg:
+            return "PRIVMSG";
+        case CommandId::kNotice:
+            return "NOTICE";
+        case CommandId::kTopic:
+            return "TOPIC";
+        case CommandId::kKick:
+            return "KICK";
+        case CommandId::kInvite:
+            return "INVITE";
+        case CommandId::kMode:
+            return "MODE";
+        case CommandId::kRehash:
+            return "REHASH";
+        case CommandId::kNames:
+            return "NAMES";
+        case CommandId::kList:
+            return "LIST";
+        case CommandId::kQuit:
+            return "QUIT";
+        case CommandId::kOper:
+            return "OPER";
+        case CommandId::kStats:
+            return "STATS";
+        case CommandId::kUnknown:
+            break;
+    }
+    return "";
+}
+
+}  // namespace protocol
@@ -1,12 +1,13 @@
 /*
- * 설명: CRLF 기준으로 입력 버퍼를 분리하고 길이 초과 여부를 판정한다.
- * 버전: v0.1.0
- * 관련 문서: design/protocol/contract.md
+ * 설명: CRLF 기준으로 입력 버퍼를 분리하고 길이 초과 여부를 판정한다. 입력 링은 memchr로 LF를 찾아 복사 없이 라인 뷰를 돌려준다.
+ * 버전: v1.1.0
+ * 관련 문서: design/protocol/contract.md, design/server/v1.1.0-performance.md
  * 테스트: tests/unit/framer_test.cpp
  */
 #include "protocol/framer.hpp"
 
 #include <cstddef>
+#include <cstring>
 
 namespace protocol {
 
@@ -21,17 +22,19 @@ FrameResult ExtractLines(std::string &buffer, std::size_t max_length) {
         return result;
     }
 
+    // 라인마다 앞부분을 지우면 라인 수에 대해 제곱 비용이 들므로, 소비 위치만 옮기고 마지막에 한 번 지운다.
+    std::size_t start = 0;
     std::size_t pos = std::string::npos;
-    while ((pos = buffer.find("\r\n")) != std::string::npos) {
-        std::string line = buffer.substr(0, pos);
-        buffer.erase(0, pos + 2);
-
-        if (line.size() + 2 > max_length) {
+    while ((pos = buffer.find("\r\n", start)) != std::string::npos) {
+        std::size_t length = pos - start;
+        if (length + 2 > max_length) {
             result.line_too_long = true;
-            continue;
+        } else {
+            result.lines.push_back(buffer.substr(start, length));
         }
-        result.lines.push_back(line);
+        start = pos + 2;
     }
+    buffer.erase(0, start);
 
     if (buffer.size() > max_length) {
         buffer.clear();
@@ -41,4 +44,68 @@ FrameResult ExtractLines(std::string &buffer, std::size_t max_length) {
     return result;
 }
 
+InputRing::InputRing(std::size_t max_length, std::size_t slack)
+    : storage_(max_length + slack), max_length_(max_length), head_(0), tail_(0), scan_(0) {}
+
+void InputRing::Compact() {
+    if (head_ == 0) {
+        return;
+    }
+    std::size_t pending = tail_ - head_;
+    if (pending > 0) {
+        std::memmove(storage_.data(), storage_.data() + head_, pending);
+    }
+    scan_ -= head_;
+    head_ = 0;
+    tail_ = pending;
+}
+
+char *InputRing::WritePtr() {
+    if (head_ == tail_) {
+        head_ = tail_ = scan_ = 0;
+    } else if (tail_ == storage_.size()) {
+        Compact();
+    }
+    return storage_.data() + tail_;
+}
+
+std::size_t InputRing::WritableSize() {
+    WritePtr();
+    return storage_.size() - tail_;
+}
+
+void InputRing::Commit(std::size_t n) { tail_ += n; }
+
+FrameStatus InputRing::NextLine(std::string_view &line) {
+    const char *base = storage_.data();
+    while (scan_ < tail_) {
+        const void *found = std::memchr(base + scan_, '\n', tail_ - scan_);
+        if (found == NULL) {
+            scan_ = tail_;
+            break;
+        }
+        std::size_t lf = static_cast<std::size_t>(static_cast<const char *>(found) - base);
+        scan_ = lf + 1;
+        // 단독 LF는 구분자가 아니므로 라인 내용으로 두고 계속 찾는다.
+        if (lf == head_ || base[lf - 1] != '\r') {
+            continue;
+        }
+        std::size_t length = lf - 1 - head_;
+        if (length + 2 > max_length_) {
+            head_ = tail_ = scan_ = 0;
+            return FrameStatus::kTooLong;
+        }
+        line = std::string_view(base + head_, length);
+        head_ = scan_;
+        return FrameStatus::kLine;
+    }
+
+    // CRLF 없이 정책 길이를 넘긴 부분 라인은 더 받아도 유효한 라인이 될 수 없다.
+    if (tail_ - head_ > max_length_) {
+        head_ = tail_ = scan_ = 0;
+        return FrameStatus::kTooLong;
+    }
+    return FrameStatus::kNeedMore;
+}
+
 }  // namespace protocol
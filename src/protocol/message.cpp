@@ -1,7 +1,7 @@
 /*
  * 설명: IRC 라인을 RFC 문법에 맞춰 prefix/command/params로 분리하고 닉네임을 검증한다.
- * 버전: v0.3.0
- * 관련 문서: design/protocol/contract.md
+ * 버전: v1.1.0
+ * 관련 문서: design/protocol/contract.md, design/server/v1.1.0-performance.md
  * 테스트: tests/unit/message_test.cpp
  */
 #include "protocol/message.hpp"
@@ -12,13 +12,13 @@
 
 namespace protocol {
 
-ParsedMessage ParseMessageLine(const std::string &line) {
-    ParsedMessage msg;
+ParsedMessageView ParseMessageView(std::string_view line) {
+    ParsedMessageView msg;
 
     std::size_t idx = 0;
     if (!line.empty() && line[0] == ':') {
         std::size_t space = line.find(' ');
-        if (space == std::string::npos) {
+        if (space == std::string_view::npos) {
             return msg;
         }
         msg.prefix = line.substr(1, space - 1);
@@ -29,7 +29,7 @@ ParsedMessage ParseMessageLine(const std::string &line) {
     }
 
     std::size_t command_end = line.find(' ', idx);
-    if (command_end == std::string::npos) {
+    if (command_end == std::string_view::npos) {
         msg.command = line.substr(idx);
         return msg;
     }
@@ -37,29 +37,47 @@ ParsedMessage ParseMessageLine(const std::string &line) {
     msg.command = line.substr(idx, command_end - idx);
     idx = command_end + 1;
 
+    ParamList &params = msg.params;
     while (idx < line.size()) {
         if (line[idx] == ' ') {
             ++idx;
             continue;
         }
         if (line[idx] == ':') {
-            msg.params.push_back(line.substr(idx + 1));
+            params.items[params.count++] = line.substr(idx + 1);
+            break;
+        }
+        // 마지막 칸에 도달하면 ':' 없이도 남은 라인 전체를 하나의 파라미터로 취급한다.
+        if (params.count + 1 == kMaxParams) {
+            params.items[params.count++] = line.substr(idx);
             break;
         }
 
         std::size_t next_space = line.find(' ', idx);
-        if (next_space == std::string::npos) {
-            msg.params.push_back(line.substr(idx));
+        if (next_space == std::string_view::npos) {
+            params.items[params.count++] = line.substr(idx);
             break;
         }
-        msg.params.push_back(line.substr(idx, next_space - idx));
+        params.items[params.count++] = line.substr(idx, next_space - idx);
         idx = next_space + 1;
     }
 
     return msg;
 }
 
-bool IsValidNickname(const std::string &nick) {
+ParsedMessage ParseMessageLine(const std::string &line) {
+    ParsedMessageView view = ParseMessageView(line);
+    ParsedMessage msg;
+    msg.prefix = std::string(view.prefix);
+    msg.command = std::string(view.command);
+    msg.params.reserve(view.params.size());
+    for (std::size_t i = 0; i < view.params.size(); ++i) {
+        msg.params.push_back(std::string(view.params[i]));
+    }
+    return msg;
+}
+
+bool IsValidNickname(std::string_view nick) {
     if (nick.empty()) {
         return false;
     }
@@ -77,5 +95,20 @@ bool IsValidNickname(const std::string &nick) {
     return true;
 }
 
-}  // namespace protocol
+bool IsValidChannelName(std::string_view name) {
+    if (name.size() < 2 || name.size() > 50) {
+        return false;
+    }
+    if (name[0] != '#') {
+        return false;
+    }
+    for (std::size_t i = 1; i < name.size(); ++i) {
+        unsigned char c = static_cast<unsigned char>(name[i]);
+        if (!(std::isalnum(c) || c == '_' || c == '-')) {
+            return false;
+        }
+    }
+    return true;
+}
 
+}  // namespace protocol
@@ -1,387 +1,1032 @@
 /*
- * 설명: poll 기반 TCP 서버를 구성하고 등록 절차, PING/PONG/QUIT, JOIN/PART, 메시징과 채널 관리(TOPIC/KICK/INVITE/MODE), 설정 리로드, 레이트리밋을 처리한다.
- * 버전: v0.9.0
- * 관련 문서: design/protocol/contract.md, design/server/v0.7.0-modes.md, design/server/v0.8.0-config-logging.md, design/server/v0.9.0-defensive.md
+ * 설명: 리액터(poll/epoll) 기반 TCP 서버를 하나 이상의 이벤트 루프 샤드로 구성하고 등록 절차, PING/PONG/QUIT, JOIN/PART, 메시징과 채널 관리(TOPIC/KICK/INVITE/MODE), 설정 리로드, 레이트리밋을 처리한다.
+ * 버전: v1.1.0
+ * 관련 문서: design/protocol/contract.md, design/server/v0.7.0-modes.md, design/server/v0.8.0-config-logging.md, design/server/v0.9.0-defensive.md, design/server/v1.1.0-performance.md
  * 테스트: tests/unit/framer_test.cpp, tests/unit/message_test.cpp, tests/unit/config_parser_test.cpp, tests/e2e
  */
 #include "server.hpp"
 
+
 #include <arpa/inet.h>
 #include <fcntl.h>
 #include <netinet/in.h>
-#include <poll.h>
+#include <netinet/tcp.h>
 #include <csignal>
+#include <sys/resource.h>
 #include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <sys/un.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <cctype>
+#include <charconv>
+#include <chrono>
+#include <climits>
 #include <cerrno>
+#include <cstdlib>
 #include <cstring>
-#include <sstream>
 #include <stdexcept>
 
+#if !defined(MSG_NOSIGNAL)
+#define MSG_NOSIGNAL 0
+#endif
+
 namespace {
 const std::size_t kMaxLineLength = 512;
-const std::size_t kMaxWritesPerTick = 1;
-const std::chrono::seconds kRateWindow(5);
-const std::chrono::seconds kOutboundWindow(5);
-volatile std::sig_atomic_t g_reload_requested = 0;
+// LIST/NAMES는 송신 큐가 이만큼(또는 low 워터마크) 찰 때까지만 만들고 소켓이 비면 이어 간다.
+const std::size_t kListingBatchBytes = 16 * 1024;
+// 연결마다 대기시킬 수 있는 LIST/NAMES 요청 수. 넘으면 263으로 거절한다.
+const std::size_t kMaxPendingListings = 4;
+// 수신자가 이만큼 이상인 브로드캐스트는 라인을 샤드 게시 청크에 한 번만 복사해 큐들이 나눠 쓴다.
+const std::size_t kSharedFanoutRecipients = 16;
+// sendmsg 한 번에 넘길 iovec 상한. 송신 큐는 청크 하나를 iovec 하나로 모은다.
+#if defined(IOV_MAX)
+const int kMaxIovecs = IOV_MAX;
+#else
+const int kMaxIovecs = 1024;
+#endif
+const std::uint64_t kRateWindowMs = 5000;
+// 어느 스레드가 시그널을 받아도 보이도록 atomic으로 둔다(lock-free라 시그널 처리기에서 안전하다).
+std::atomic<int> g_reload_requested(0);
+// 지금 실행 중인 이벤트 루프 샤드. 핸들러는 이 값으로 자기 리액터와 우편함을 찾는다.
+thread_local EventShard *t_current_shard = nullptr;
+// 디렉터리 크기 상한. RLIMIT_NOFILE이 무제한이어도 이만큼만 미리 잡는다.
+const std::size_t kMaxReservedSlots = 1u << 20;
+
+void HandleSighup(int) { g_reload_requested.store(1); }
+
+EventShard &CurrentShard() { return *t_current_shard; }
+
+// 조각들을 이번 읽기 묶음의 아레나에 이어 붙인다. 돌려준 뷰는 HandleClientRead가 끝날 때까지만 유효하다.
+std::string_view ScratchConcat(std::initializer_list<std::string_view> parts) {
+    std::size_t size = 0;
+    for (std::initializer_list<std::string_view>::const_iterator it = parts.begin(); it != parts.end(); ++it) {
+        size += it->size();
+    }
+    char *out = static_cast<char *>(CurrentShard().arena.allocate(size == 0 ? 1 : size, 1));
+    std::size_t offset = 0;
+    for (std::initializer_list<std::string_view>::const_iterator it = parts.begin(); it != parts.end(); ++it) {
+        std::memcpy(out + offset, it->data(), it->size());
+        offset += it->size();
+    }
+    return std::string_view(out, size);
+}
 
-void HandleSighup(int) { g_reload_requested = 1; }
+std::string_view ScratchNumber(std::size_t value) {
+    char *out = static_cast<char *>(CurrentShard().arena.allocate(20, 1));
+    return std::string_view(out, static_cast<std::size_t>(std::to_chars(out, out + 20, value).ptr - out));
 }
 
-PollServer::PollServer(int port, const std::string &password, const config::Settings &settings,
-                       const std::string &config_path)
-    : listen_fd_(-1), port_(port), password_(password), config_path_(config_path),
-      max_outbound_queue_(settings.outbound_lines) {
-    ApplyConfig(settings);
+// 닉네임이 아직 없으면 numeric 대상 자리에 "*"를 쓴다. 복사 없이 세션 문자열을 가리킨다.
+std::string_view NickOrStar(const ClientSession &session) {
+    return session.nick.empty() ? std::string_view("*") : std::string_view(session.nick);
 }
 
-void PollServer::Run() {
-    std::signal(SIGHUP, HandleSighup);
-    SetupListeningSocket();
-    EventLoop();
+std::uint64_t NowMs() {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                                          std::chrono::steady_clock::now().time_since_epoch())
+                                          .count());
 }
 
-void PollServer::SetupListeningSocket() {
-    listen_fd_ = ::socket(AF_INET, SOCK_STREAM, 0);
-    if (listen_fd_ < 0) {
-        throw std::runtime_error("소켓 생성 실패");
+// 타이머 key에 연결 핸들을 그대로 담는다.
+std::uint64_t TimerKey(const state::ConnectionHandle &handle) {
+    return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(handle.fd)) << 32) | handle.generation;
+}
+
+state::ConnectionHandle HandleFromTimerKey(std::uint64_t key) {
+    state::ConnectionHandle handle = {static_cast<int>(key >> 32), static_cast<std::uint32_t>(key)};
+    return handle;
+}
+
+void SetNonBlocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    if (flags >= 0) {
+        fcntl(fd, F_SETFL, flags | O_NONBLOCK);
     }
+}
 
-    int flags = fcntl(listen_fd_, F_GETFL, 0);
-    fcntl(listen_fd_, F_SETFL, flags | O_NONBLOCK);
+int OpenListeningSocket(int port, std::size_t backlog, bool reuse_port) {
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        throw std::runtime_error("소켓 생성 실패");
+    }
+    SetNonBlocking(fd);
 
     int opt = 1;
-    setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+#if defined(SO_REUSEPORT)
+    // 샤드마다 같은 포트에 리스닝 소켓을 하나씩 두고 커널이 새 연결을 나눠 준다.
+    if (reuse_port && setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &opt, sizeof(opt)) < 0) {
+        close(fd);
+        throw std::runtime_error("SO_REUSEPORT 설정 실패");
+    }
+#else
+    (void)reuse_port;
+#endif
 
     sockaddr_in addr;
     std::memset(&addr, 0, sizeof(addr));
     addr.sin_family = AF_INET;
     addr.sin_addr.s_addr = INADDR_ANY;
-    addr.sin_port = htons(port_);
+    addr.sin_port = htons(port);
 
-    if (bind(listen_fd_, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) < 0) {
+    if (bind(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) < 0) {
+        close(fd);
         throw std::runtime_error("바인드 실패");
     }
 
-    if (listen(listen_fd_, 16) < 0) {
+    if (listen(fd, static_cast<int>(backlog)) < 0) {
+        close(fd);
         throw std::runtime_error("리스닝 실패");
     }
+    return fd;
+}
+
+// 명령 처리가 state_mutex_ 하나 아래에서 돌아 샤드를 늘려도 다중 코어 이득이 측정되지 않았으므로,
+// 여러 샤드 경로는 IRC_EXPERIMENTAL_SHARDS로 빌드했을 때만 켠다. 기본 빌드는 [io] threads와 무관하게 1개다.
+std::size_t ResolveShardCount(std::size_t configured) {
+#if !defined(IRC_EXPERIMENTAL_SHARDS)
+    (void)configured;
+    return 1;
+#endif
+    if (configured == 0) {
+        configured = std::thread::hardware_concurrency();
+    }
+    if (configured == 0) {
+        configured = 1;
+    }
+#if !defined(SO_REUSEPORT)
+    configured = 1;
+#endif
+    return configured;
+}
+
+// [io] read_buffer_bytes는 라인 정책 한 줄에 같은 크기의 여유를 더한 값보다 작아지지 않는다.
+std::size_t InputSlack(std::size_t read_buffer_bytes) {
+    return std::max(read_buffer_bytes, 2 * kMaxLineLength) - kMaxLineLength;
+}
+
+// [limits] outbound_pool_bytes는 서버 전체 값이라 샤드 수로 나눠 샤드 풀마다 남길 청크 수로 쓴다.
+std::size_t PoolChunksPerShard(std::size_t pool_bytes, std::size_t shards) {
+    return pool_bytes / net::kOutboundChunkBytes / (shards > 0 ? shards : 1);
+}
+
+std::size_t ReservedSlotCount() {
+    struct rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) != 0 || limit.rlim_cur == RLIM_INFINITY ||
+        limit.rlim_cur > kMaxReservedSlots) {
+        return kMaxReservedSlots;
+    }
+    return static_cast<std::size_t>(limit.rlim_cur);
+}
+
+// 0은 "커널 기본값 유지"를 뜻하므로 건드리지 않는다. 지원하지 않는 옵션의 실패는 무시한다.
+void SetIntOption(int fd, int level, int name, std::size_t value) {
+    if (value == 0) {
+        return;
+    }
+    int raw = static_cast<int>(value);
+    setsockopt(fd, level, name, &raw, sizeof(raw));
+}
 
-    struct pollfd pfd;
-    pfd.fd = listen_fd_;
-    pfd.events = POLLIN;
-    pfd.revents = 0;
-    poll_fds_.push_back(pfd);
+void ApplyClientSocketOptions(int fd, const config::Settings &settings) {
+    SetIntOption(fd, SOL_SOCKET, SO_SNDBUF, settings.socket_sndbuf);
+    SetIntOption(fd, SOL_SOCKET, SO_RCVBUF, settings.socket_rcvbuf);
+    SetIntOption(fd, IPPROTO_TCP, TCP_NODELAY, settings.tcp_nodelay ? 1 : 0);
+#if defined(TCP_NOTSENT_LOWAT)
+    SetIntOption(fd, IPPROTO_TCP, TCP_NOTSENT_LOWAT, settings.tcp_notsent_lowat);
+#endif
+    SetIntOption(fd, SOL_SOCKET, SO_KEEPALIVE, settings.tcp_keepalive ? 1 : 0);
+#if defined(TCP_KEEPIDLE)
+    if (settings.tcp_keepalive) {
+        SetIntOption(fd, IPPROTO_TCP, TCP_KEEPIDLE, settings.tcp_keepalive_idle);
+    }
+#endif
+}
 }
 
-void PollServer::EventLoop() {
+PollServer::PollServer(int port, const std::string &password, const config::Settings &settings,
+                       const std::string &config_path)
+    : port_(port), password_(password), config_path_(config_path),
+      outbound_high_bytes_(0), outbound_low_bytes_(0), outbound_total_cap_(0), outbound_bytes_(0),
+      outbound_dropped_lines_(0), outbound_evictions_(0), prefix_generation_(0),
+      write_budget_bytes_(settings.write_budget_bytes), read_budget_bytes_(settings.read_budget_bytes),
+      read_budget_lines_(settings.read_budget_lines), metrics_fd_(-1), start_ms_(NowMs()) {
+    ApplyConfig(settings);
+}
+
+void PollServer::Run() {
+    std::signal(SIGHUP, HandleSighup);
+    SetupShards();
+    for (std::size_t i = 1; i < shards_.size(); ++i) {
+        EventShard *shard = shards_[i].get();
+        shard->thread = std::thread([this, shard]() {
+            try {
+                RunShard(*shard);
+            } catch (const std::exception &ex) {
+                // 다른 샤드가 나머지 연결을 계속 잡고 있으면 안 되므로 프로세스 전체를 끝낸다.
+                logger_.Log(config::LogLevel::kError,
+                            std::string("이벤트 루프 스레드 오류: ") + ex.what());
+                logger_.Flush();
+                std::_Exit(1);
+            }
+        });
+    }
+    RunShard(*shards_[0]);
+}
+
+void PollServer::SetupShards() {
+    // 샤드 수와 백엔드는 기동 시점에만 정한다(REHASH로 바꾸지 않음).
+    const std::size_t count = ResolveShardCount(config_.io_threads);
+    if (count > 1) {
+        // 여러 스레드가 잠금 없이 슬롯을 읽으므로 디렉터리가 이후에 커지지 않게 미리 잡는다.
+        clients_.Reserve(ReservedSlotCount());
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+        std::unique_ptr<EventShard> shard(new EventShard());
+        shard->index = i;
+        shard->outgoing.resize(count);
+        shard->listen_fd = OpenListeningSocket(port_, config_.listen_backlog, count > 1);
+        int wake[2];
+        if (pipe(wake) < 0) {
+            throw std::runtime_error("샤드 깨우기 파이프 생성 실패");
+        }
+        SetNonBlocking(wake[0]);
+        SetNonBlocking(wake[1]);
+        shard->wake_read_fd = wake[0];
+        shard->wake_write_fd = wake[1];
+        shard->reserve_fd = open("/dev/null", O_RDONLY | O_CLOEXEC);
+
+        shard->reactor = net::CreateReactor(config_.io_backend);
+        if (!shard->reactor->Add(shard->listen_fd, net::kEventRead) ||
+            !shard->reactor->Add(shard->wake_read_fd, net::kEventRead)) {
+            throw std::runtime_error("리액터 등록 실패");
+        }
+        shard->chunk_pool.SetMaxFree(PoolChunksPerShard(config_.outbound_pool_bytes, count));
+        shards_.push_back(std::move(shard));
+    }
+    if (!config_.metrics_socket.empty()) {
+        OpenMetricsSocket(*shards_[0]);
+    }
+    if (config_.io_threads > count) {
+        IRC_LOG(logger_, config::LogLevel::kWarn,
+                "io.threads=" << config_.io_threads << " 무시: 이 빌드는 이벤트 루프 스레드 " << count << "개로 동작");
+    }
+    IRC_LOG(logger_, config::LogLevel::kInfo,
+            "이벤트 백엔드: " << shards_[0]->reactor->Name() << " 스레드: " << count);
+}
+
+void PollServer::EnterShard(EventShard &shard) {
+    t_current_shard = &shard;
+    shard.now_ms = NowMs();
+    // 휠은 틱 0에서 시작한다. 첫 accept가 타이머를 걸기 전에 부팅 후 시각으로 옮겨 두지 않으면
+    // 첫 기한이 틱 0 기준 거리로 계산되어 윗단 끝으로 당겨지고, 첫 Advance가 빈 틱을 훑는다.
+    shard.expired.clear();
+    shard.timers.Advance(shard.now_ms, shard.expired);
+}
+
+void PollServer::RunShard(EventShard &shard) {
+    EnterShard(shard);
+    std::vector<net::ReadyEvent> events;
+    std::vector<state::ConnectionHandle> handles;
     while (true) {
         HandlePendingReload();
 
-        int ret = poll(poll_fds_.data(), poll_fds_.size(), -1);
+        // 타이머가 없으면 무한 대기, 있으면 다음 만료 틱까지만 잔다. 미뤄 둔 읽기가 있으면 자지 않는다.
+        const int timeout = shard.read_backlog.empty() ? shard.timers.NextTimeoutMs(NowMs()) : 0;
+        int ret = shard.reactor->Wait(events, timeout);
+        shard.now_ms = NowMs();
         if (ret < 0) {
             if (errno == EINTR) {
                 HandlePendingReload();
                 continue;
             }
-            throw std::runtime_error("poll 실패");
+            throw std::runtime_error("이벤트 대기 실패");
         }
-
-        for (std::size_t i = 0; i < poll_fds_.size(); ++i) {
-            struct pollfd pfd = poll_fds_[i];
-            if (pfd.revents == 0) {
+        shard.metrics.wakeups.Add();
+        shard.metrics.batch_events.Record(events.size());
+        // 지난 바퀴에 미룬 연결은 이번 이벤트를 다 돈 뒤 한 번씩 읽는다. 이번 바퀴에 새로 미룬 연결은 다음 바퀴로 간다.
+        shard.read_serving.swap(shard.read_backlog);
+
+        // 배치 처리 중 닫힌 fd가 같은 배치의 accept로 재사용될 수 있으므로, 대기 직후의 세대를 기록해 둔다.
+        // 이 리액터에 등록된 연결 fd는 이 샤드 소유이므로 잠금 없이 읽어도 된다.
+        handles.clear();
+        for (std::size_t i = 0; i < events.size(); ++i) {
+            int fd = events[i].fd;
+            if (fd == shard.listen_fd || fd == shard.wake_read_fd || fd == metrics_fd_) {
+                state::ConnectionHandle none = {fd, 0};
+                handles.push_back(none);
                 continue;
             }
+            handles.push_back(clients_.HandleOf(fd));
+        }
 
-            if (pfd.fd == listen_fd_) {
-                HandleListeningEvent(pfd.revents);
-                poll_fds_[i].revents = 0;
+        for (std::size_t i = 0; i < events.size(); ++i) {
+            const net::ReadyEvent &ev = events[i];
+            if (ev.fd == shard.listen_fd) {
+                HandleListeningEvent(shard, ev.events);
                 continue;
             }
-
-            if (pfd.revents & (POLLHUP | POLLERR | POLLNVAL)) {
-                CloseClient(pfd.fd);
-                --i;
+            if (ev.fd == shard.wake_read_fd) {
+                HandleWakeEvent(shard);
+                continue;
+            }
+            if (ev.fd == metrics_fd_) {
+                HandleMetricsEvent();
                 continue;
             }
 
-            if (pfd.revents & POLLIN) {
-                HandleClientRead(pfd.fd);
+            // 앞선 처리(브로드캐스트 실패 등)로 이미 닫혔거나 새 연결에 재사용된 fd는 건너뛴다.
+            if (!clients_.IsCurrent(handles[i])) {
+                continue;
             }
-            if (pfd.revents & POLLOUT) {
-                HandleClientWrite(pfd.fd);
+
+            if (ev.events & net::kEventError) {
+                std::unique_lock<std::mutex> lock = AcquireState();
+                CloseClient(ev.fd);
+                continue;
             }
 
-            if (clients_.find(pfd.fd) == clients_.end()) {
-                --i;
-            } else {
-                poll_fds_[i].revents = 0;
+            // 미뤄 둔 연결은 읽기 이벤트가 또 와도 백로그 차례에 한 번만 읽는다.
+            if ((ev.events & net::kEventRead) && !clients_.Io(ev.fd).read_deferred) {
+                HandleClientRead(ev.fd);
+            }
+            if ((ev.events & net::kEventWrite) && clients_.IsCurrent(handles[i]) &&
+                !clients_.Io(ev.fd).close_pending) {
+                HandleClientWrite(ev.fd);
             }
+            ReapPendingCloses();
         }
+        ServeReadBacklog(shard);
+        // 오류 이벤트로 닫힌 연결의 PART 팬아웃이 예약한 종료도 이번 배치 안에 처리한다.
+        ReapPendingCloses();
+        RunExpiredTimers(shard);
     }
 }
 
-void PollServer::HandleListeningEvent(short revents) {
-    if (revents & POLLIN) {
-        AcceptNewClients();
+void PollServer::HandleListeningEvent(EventShard &shard, unsigned events) {
+    if (events & net::kEventRead) {
+        AcceptNewClients(shard);
     }
 }
 
-void PollServer::AcceptNewClients() {
+void PollServer::AcceptNewClients(EventShard &shard) {
     while (true) {
         sockaddr_in client_addr;
         socklen_t len = sizeof(client_addr);
-        int client_fd = accept(listen_fd_, reinterpret_cast<sockaddr *>(&client_addr), &len);
+        int client_fd =
+            accept(shard.listen_fd, reinterpret_cast<sockaddr *>(&client_addr), &len);
         if (client_fd < 0) {
-            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            const int error = errno;
+            if (error == EAGAIN || error == EWOULDBLOCK) {
                 break;
             }
-            logger_.Log(config::LogLevel::kWarn,
-                        std::string("accept 실패: ") + std::strerror(errno));
-            break;
+            // 리스닝 소켓은 엣지 트리거라 여기서 멈추면 밀린 연결은 다음 연결이 올 때까지 남는다. EAGAIN까지 계속 받는다.
+            if (error == EMFILE || error == ENFILE) {
+                if (!DropPendingConnection(shard)) {
+                    break;
+                }
+                continue;
+            }
+            if (error != EINTR && error != ECONNABORTED && error != EPROTO) {
+                logger_.Log(config::LogLevel::kWarn, std::string("accept 실패: ") + std::strerror(error));
+            }
+            continue;
         }
 
-        int flags = fcntl(client_fd, F_GETFL, 0);
-        if (flags >= 0) {
-            fcntl(client_fd, F_SETFL, flags | O_NONBLOCK);
+        SetNonBlocking(client_fd);
+
+        // 여러 샤드가 슬롯을 공유할 때는 미리 잡은 범위 밖의 fd를 받지 않는다.
+        if (shards_.size() > 1 && static_cast<std::size_t>(client_fd) >= clients_.Capacity()) {
+            logger_.Log(config::LogLevel::kWarn, "연결 슬롯 부족으로 수락 거부");
+            close(client_fd);
+            continue;
         }
 
-        int sndbuf = 64;
-        setsockopt(client_fd, SOL_SOCKET, SO_SNDBUF, &sndbuf, sizeof(sndbuf));
+        AdoptClient(shard, client_fd);
+    }
+}
 
-        ClientConnection conn;
-        conn.fd = client_fd;
-        conn.send_offset = 0;
-        conn.marked_close = false;
-        conn.pass_accepted = false;
-        conn.registered = false;
-        conn.user_set = false;
-        conn.enqueues_since_last_write = 0;
+// fd가 바닥나면 예비 fd를 닫아 자리를 만들고, 밀린 연결 하나를 받아 바로 끊은 뒤 예비 fd를 다시 잡는다.
+// 예비 fd가 없거나 그래도 받지 못하면 false를 돌려준다. 이때는 리스닝 소켓을 재무장해 다음 바퀴에 다시 시도한다.
+bool PollServer::DropPendingConnection(EventShard &shard) {
+    if (shard.reserve_fd >= 0) {
+        close(shard.reserve_fd);
+        int client_fd = accept(shard.listen_fd, nullptr, nullptr);
+        if (client_fd >= 0) {
+            close(client_fd);
+        }
+        shard.reserve_fd = open("/dev/null", O_RDONLY | O_CLOEXEC);
+        if (client_fd >= 0) {
+            logger_.Log(config::LogLevel::kWarn, "fd 부족으로 연결을 받자마자 끊음");
+            return true;
+        }
+    }
+    logger_.Log(config::LogLevel::kWarn, std::string("accept 실패: ") + std::strerror(EMFILE));
+    shard.reactor->Rearm(shard.listen_fd);
+    return false;
+}
+
+bool PollServer::AdoptClient(EventShard &shard, int client_fd) {
+    std::unique_lock<std::mutex> lock = AcquireState();
+    // REHASH 이후 수락한 연결은 갱신된 [socket] 값을 그대로 사용한다.
+    ApplyClientSocketOptions(client_fd, config_);
+
+    if (!shard.reactor->Add(client_fd, net::kEventRead)) {
+        logger_.Log(config::LogLevel::kWarn,
+                    std::string("리액터 등록 실패: ") + std::strerror(errno));
+        close(client_fd);
+        return false;
+    }
+    clients_.Insert(client_fd);
+    clients_.Session(client_fd).shard = shard.index;
+    ClientIo &io = clients_.Io(client_fd);
+    const std::size_t slack = InputSlack(config_.read_buffer_bytes);
+    if (io.input.Capacity() != kMaxLineLength + slack) {
+        io.input = protocol::InputRing(kMaxLineLength, slack);
+    }
+    io.accepted_ms = shard.now_ms;
+    io.last_activity_ms = shard.now_ms;
+    ArmConnectionTimer(client_fd);
+    shard.metrics.accepted.Add();
+    return true;
+}
 
-        clients_[client_fd] = conn;
+void PollServer::HandleWakeEvent(EventShard &shard) {
+    // 파이프를 먼저 비워야, 그 뒤에 빈 우편함으로 들어온 항목이 다시 깨우기 신호를 남긴다.
+    char scratch[64];
+    while (read(shard.wake_read_fd, scratch, sizeof(scratch)) > 0) {
+    }
+    {
+        std::unique_lock<std::mutex> lock = AcquireState();
+    }
+    ReapPendingCloses();
+}
+
+void PollServer::OpenMetricsSocket(EventShard &shard) {
+    sockaddr_un addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (config_.metrics_socket.size() >= sizeof(addr.sun_path)) {
+        throw std::runtime_error("지표 소켓 경로가 너무 김");
+    }
+    std::memcpy(addr.sun_path, config_.metrics_socket.c_str(), config_.metrics_socket.size());
+
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        throw std::runtime_error("지표 소켓 생성 실패");
+    }
+    SetNonBlocking(fd);
+    // 이전 실행이 남긴 소켓 파일만 지우고 다시 만든다. 설정 실수로 일반 파일이나 디렉터리를 가리키면 지우지 않고 기동을 멈춘다.
+    struct stat existing;
+    if (lstat(config_.metrics_socket.c_str(), &existing) == 0) {
+        if (!S_ISSOCK(existing.st_mode)) {
+            close(fd);
+            throw std::runtime_error("지표 소켓 경로에 소켓이 아닌 파일이 있음: " + config_.metrics_socket);
+        }
+        unlink(config_.metrics_socket.c_str());
+    }
+    if (bind(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) < 0 || listen(fd, 16) < 0 ||
+        !shard.reactor->Add(fd, net::kEventRead)) {
+        close(fd);
+        throw std::runtime_error("지표 소켓 바인드 실패: " + config_.metrics_socket);
+    }
+    metrics_fd_ = fd;
+}
 
-        struct pollfd pfd;
-        pfd.fd = client_fd;
-        pfd.events = POLLIN;
-        pfd.revents = 0;
-        poll_fds_.push_back(pfd);
+// 접속마다 현재 지표를 Prometheus 텍스트로 한 번 쓰고 닫는다. 요청은 읽지 않는다.
+void PollServer::HandleMetricsEvent() {
+    while (true) {
+        int client_fd = accept(metrics_fd_, nullptr, nullptr);
+        if (client_fd < 0) {
+            return;
+        }
+        std::string text;
+        {
+            std::unique_lock<std::mutex> lock = AcquireState();
+            ServerStats stats;
+            CollectStats(stats);
+            text = RenderMetricsText(stats);
+        }
+        // 텍스트는 수십 KiB 안이라 Unix 소켓 버퍼에 한 번에 들어간다. 다 못 쓰면 이번 응답은 버린다.
+        ssize_t written = send(client_fd, text.data(), text.size(), MSG_NOSIGNAL | MSG_DONTWAIT);
+        if (written != static_cast<ssize_t>(text.size())) {
+            IRC_LOG(logger_, config::LogLevel::kDebug, "지표 소켓 쓰기 미완료: " << written << "/" << text.size());
+        }
+        close(client_fd);
     }
 }
 
+std::unique_lock<std::mutex> PollServer::AcquireState() {
+    std::unique_lock<std::mutex> lock(state_mutex_);
+    // 다른 샤드가 앞서 보낸 라인을 먼저 큐에 넣어, 이번 처리의 응답이 그보다 앞서 나가지 않게 한다.
+    DrainMailbox(CurrentShard());
+    return lock;
+}
+
+void PollServer::DrainMailbox(EventShard &shard) {
+    if (shard.mailbox.Empty()) {
+        return;
+    }
+    shard.mailbox.TakeAll(shard.inbox);
+    for (std::size_t i = 0; i < shard.inbox.size(); ++i) {
+        const ShardDelivery &delivery = shard.inbox[i];
+        // 수신자가 많으면 이 샤드 풀에 한 번 게시하고 큐마다 구간만 붙인다.
+        net::OutboundSlice slice;
+        const net::OutboundSlice *shared = nullptr;
+        if (delivery.targets.size() >= kSharedFanoutRecipients &&
+            delivery.buffer->size() <= net::OutboundChunk::kCapacity) {
+            slice = shard.chunk_pool.Publish(*delivery.buffer);
+            shared = &slice;
+        }
+        for (std::size_t t = 0; t < delivery.targets.size(); ++t) {
+            const state::ConnectionHandle &target = delivery.targets[t];
+            if (clients_.IsCurrent(target) &&
+                !EnqueueLine(target.fd, *delivery.buffer, delivery.priority, shared)) {
+                ScheduleClose(target.fd);
+            }
+        }
+    }
+    shard.inbox.clear();
+}
+
+void PollServer::PostToShard(std::size_t shard, ShardDelivery delivery) {
+    EventShard &target = *shards_[shard];
+    if (target.mailbox.Push(std::move(delivery))) {
+        // 파이프가 가득 찼다면 이미 깨우기 신호가 남아 있는 것이다.
+        char byte = 1;
+        ssize_t ignored = write(target.wake_write_fd, &byte, 1);
+        (void)ignored;
+    }
+}
+
+// 연결 하나가 한 바퀴에 읽는 양을 바이트/라인 예산으로 묶는다. 예산이 남아도 소켓을 비웠으면 끝내고,
+// 예산을 다 썼는데 읽을 것이 남았으면 DeferRead로 다음 바퀴에 넘겨 다른 연결이 먼저 돌게 한다.
 void PollServer::HandleClientRead(int fd) {
-    char buf[1024];
+    // 이번 묶음의 핸들러 임시 메모리는 여기서 함수가 끝날 때 한꺼번에 되감는다.
+    net::ArenaScope scratch(CurrentShard().arena);
+    std::size_t byte_budget = read_budget_bytes_.load(std::memory_order_relaxed);
+    std::size_t line_budget = read_budget_lines_.load(std::memory_order_relaxed);
+    bool drained = false;
+    // 지난 바퀴에 예산 때문에 남긴 라인이 있으면 recv 없이도 처리한다.
+    bool frame = clients_.Io(fd).input.Size() > 0;
     while (true) {
-        ssize_t n = recv(fd, buf, sizeof(buf), 0);
-        if (n > 0) {
-            clients_[fd].input_buffer.append(buf, n);
-            protocol::FrameResult res = protocol::ExtractLines(clients_[fd].input_buffer, kMaxLineLength);
-            if (res.line_too_long) {
+        // recv는 입력 링의 빈 영역에 직접 쓴다. 입력 링은 이 샤드만 만지므로 recv 동안에는 상태 잠금을 쥐지 않는다.
+        protocol::InputRing &input = clients_.Io(fd).input;
+        const std::size_t want = std::min(input.WritableSize(), byte_budget);
+        if (want > 0) {
+            ssize_t n = recv(fd, input.WritePtr(), want, 0);
+            if (n > 0) {
+                input.Commit(static_cast<std::size_t>(n));
+                byte_budget -= static_cast<std::size_t>(n);
+                frame = true;
+                clients_.Io(fd).last_activity_ms = CurrentShard().now_ms;
+                // 요청보다 적게 와도 소켓을 비웠다고 단정하지 않는다. 데이터와 함께 온 FIN은 새 엣지를 만들지 않으므로
+                // EAGAIN이나 0을 볼 때까지 다시 recv해야 종료를 놓치지 않는다.
+            } else if (n == 0) {
+                std::unique_lock<std::mutex> lock = AcquireState();
+                CloseClient(fd);
+                return;
+            } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                drained = true;
+            } else if (errno != EINTR) {
+                std::unique_lock<std::mutex> lock = AcquireState();
                 CloseClient(fd);
                 return;
             }
-            for (std::size_t i = 0; i < res.lines.size(); ++i) {
-                ProcessLine(fd, res.lines[i]);
-                if (clients_.find(fd) == clients_.end()) {
+        }
+
+        // 이번 recv로 링에 모인 완성 라인을 한 번에 처리한다. 프레이머는 링 내부를 가리키는 뷰를 돌려준다.
+        if (frame) {
+            frame = false;
+            std::unique_lock<std::mutex> lock = AcquireState();
+            std::string_view line;
+            protocol::FrameStatus status = protocol::FrameStatus::kNeedMore;
+            while (line_budget > 0 && (status = input.NextLine(line)) == protocol::FrameStatus::kLine) {
+                --line_budget;
+                ProcessLine(fd, line);
+                if (!clients_.Contains(fd)) {
                     return;
                 }
-                if (clients_[fd].marked_close) {
+                if (clients_.Io(fd).marked_close || clients_.Io(fd).close_pending) {
                     return;
                 }
             }
-        } else if (n == 0) {
-            CloseClient(fd);
-            return;
-        } else {
-            if (errno == EAGAIN || errno == EWOULDBLOCK) {
-                break;
+            if (status == protocol::FrameStatus::kTooLong) {
+                CloseClient(fd);
+                return;
+            }
+        }
+
+        if (line_budget == 0 || byte_budget == 0) {
+            // 링에 남은 라인이나 소켓에 남은 데이터는 다음 바퀴에 읽는다.
+            if (!drained || clients_.Io(fd).input.Size() > 0) {
+                DeferRead(fd);
             }
-            CloseClient(fd);
+            return;
+        }
+        if (drained) {
             return;
         }
     }
 }
 
+void PollServer::DeferRead(int fd) {
+    ClientIo &io = clients_.Io(fd);
+    if (io.read_deferred) {
+        return;
+    }
+    io.read_deferred = true;
+    EventShard &shard = CurrentShard();
+    shard.read_backlog.push_back(clients_.HandleOf(fd));
+    shard.metrics.read_deferrals.Add();
+}
+
+// 지난 바퀴에 미룬 연결을 미룬 순서대로 한 번씩 읽는다. 또 예산을 다 쓰면 다시 뒤에 선다.
+void PollServer::ServeReadBacklog(EventShard &shard) {
+    for (std::size_t i = 0; i < shard.read_serving.size(); ++i) {
+        const state::ConnectionHandle &handle = shard.read_serving[i];
+        if (!clients_.IsCurrent(handle)) {
+            continue;
+        }
+        ClientIo &io = clients_.Io(handle.fd);
+        io.read_deferred = false;
+        if (io.close_pending || io.marked_close) {
+            continue;
+        }
+        HandleClientRead(handle.fd);
+        ReapPendingCloses();
+    }
+    shard.read_serving.clear();
+}
+
 void PollServer::HandleClientWrite(int fd) {
-    ClientConnection &conn = clients_[fd];
-    std::size_t writes = 0;
-    while (!conn.outbound_queue.empty() && writes < kMaxWritesPerTick) {
-        std::string &front = conn.outbound_queue.front();
-        const char *data = front.c_str() + conn.send_offset;
-        std::size_t remaining = front.size() - conn.send_offset;
-
-        ssize_t n = send(fd, data, remaining, 0);
-            if (n > 0) {
-                conn.send_offset += static_cast<std::size_t>(n);
-                if (conn.send_offset >= front.size()) {
-                    conn.outbound_queue.pop_front();
-                    conn.send_offset = 0;
-                    conn.enqueues_since_last_write = 0;
-                    ++writes;
-                }
-            } else {
+    ClientIo &conn = clients_.Io(fd);
+    std::size_t budget = write_budget_bytes_.load(std::memory_order_relaxed);
+    bool would_block = false;
+    struct iovec iov[kMaxIovecs];
+
+    while (!conn.outbound.empty() && budget > 0) {
+        // 큐 머리 청크부터 예산 안에서 모아 한 번의 sendmsg로 보낸다.
+        const int count = conn.outbound.Gather(iov, kMaxIovecs, budget);
+        std::size_t gathered = 0;
+        for (int i = 0; i < count; ++i) {
+            gathered += iov[i].iov_len;
+        }
+
+        struct msghdr msg;
+        std::memset(&msg, 0, sizeof(msg));
+        msg.msg_iov = iov;
+        msg.msg_iovlen = count;
+        ssize_t n = sendmsg(fd, &msg, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
             if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                would_block = true;
                 break;
             }
+            std::unique_lock<std::mutex> lock = AcquireState();
             CloseClient(fd);
             return;
         }
+
+        const std::size_t sent = static_cast<std::size_t>(n);
+        budget -= sent;
+        if (sent > 0) {
+            conn.last_send_progress_ms = CurrentShard().now_ms;
+        }
+        // 다 보낸 청크는 풀로 돌아간다.
+        ReleaseQueuedBytes(conn, sent);
+
+        // 모은 만큼 다 나가지 않았다면 커널 송신 버퍼가 찬 것이다.
+        if (static_cast<std::size_t>(n) < gathered) {
+            would_block = true;
+            break;
+        }
+    }
+
+    // 소켓이 비는 만큼 밀려 있던 LIST/NAMES 응답을 이어서 만든다.
+    if (conn.listing_pending && conn.outbound.size() < kListingBatchBytes && !conn.close_pending) {
+        std::unique_lock<std::mutex> lock = AcquireState();
+        ContinueListings(fd);
     }
 
     UpdatePollWriteInterest(fd);
+    if (!conn.outbound.empty() && !would_block) {
+        // 틱당 바이트 예산으로 멈춘 경우 엣지 트리거 백엔드가 다음 루프에서 다시 알리도록 한다.
+        CurrentShard().reactor->Rearm(fd);
+    }
 
-    if (conn.outbound_queue.empty() && conn.marked_close) {
+    if (conn.outbound.empty() && conn.marked_close) {
+        std::unique_lock<std::mutex> lock = AcquireState();
         CloseClient(fd);
     }
 }
 
+// 상태 잠금을 쥔 소유 샤드 스레드에서만 호출한다.
 void PollServer::CloseClient(int fd) {
-    auto it = clients_.find(fd);
-    if (it != clients_.end()) {
+    if (clients_.Contains(fd)) {
+        ClientIo &io = clients_.Io(fd);
+        if (io.timer != net::kNoTimer) {
+            CurrentShard().timers.Cancel(io.timer);
+            io.timer = net::kNoTimer;
+        }
+        ReleaseQueuedBytes(io, io.outbound.size());
         RemoveFromAllChannels(fd, "연결 종료");
-        close(fd);
-        clients_.erase(it);
-    }
-
-    for (std::size_t i = 0; i < poll_fds_.size(); ++i) {
-        if (poll_fds_[i].fd == fd) {
-            poll_fds_[i] = poll_fds_.back();
-            poll_fds_.pop_back();
-            break;
+        const std::string &nick = clients_.Session(fd).nick;
+        if (!nick.empty()) {
+            nicks_.Release(nick, fd);
         }
+        CurrentShard().reactor->Remove(fd);
+        close(fd);
+        clients_.Erase(fd);
     }
 }
 
-void PollServer::ProcessLine(int fd, const std::string &line) {
-    protocol::ParsedMessage msg = ParseAndNormalize(line);
-    if (msg.command.empty()) {
+void PollServer::ScheduleClose(int fd) {
+    if (!clients_.Contains(fd)) {
         return;
     }
-    HandleCommand(fd, msg);
-}
-
-protocol::ParsedMessage PollServer::ParseAndNormalize(const std::string &line) {
-    protocol::ParsedMessage parsed = protocol::ParseMessageLine(line);
-    for (std::size_t i = 0; i < parsed.command.size(); ++i) {
-        parsed.command[i] = static_cast<char>(std::toupper(parsed.command[i]));
+    ClientIo &conn = clients_.Io(fd);
+    if (conn.close_pending) {
+        return;
     }
-    return parsed;
+    conn.close_pending = true;
+    CurrentShard().pending_close.push_back(clients_.HandleOf(fd));
 }
 
-void PollServer::HandleCommand(int fd, const protocol::ParsedMessage &msg) {
-    if (msg.command == "PING") {
-        HandlePing(fd, msg);
+void PollServer::ReapPendingCloses() {
+    std::vector<state::ConnectionHandle> &pending = CurrentShard().pending_close;
+    if (pending.empty()) {
         return;
     }
-    if (msg.command == "PONG") {
-        HandlePong(fd, msg);
-        return;
-    }
-    if (msg.command == "PASS") {
-        HandlePass(fd, msg);
-        return;
-    }
-    if (msg.command == "NICK") {
-        HandleNick(fd, msg);
-        return;
+    std::unique_lock<std::mutex> lock = AcquireState();
+    // 종료 시 PART 브로드캐스트가 다른 연결을 또 예약할 수 있으므로 인덱스로 끝까지 돈다.
+    for (std::size_t i = 0; i < pending.size(); ++i) {
+        if (clients_.IsCurrent(pending[i])) {
+            CloseClient(pending[i].fd);
+        }
     }
-    if (msg.command == "USER") {
-        HandleUser(fd, msg);
+    pending.clear();
+}
+
+void PollServer::RunExpiredTimers(EventShard &shard) {
+    shard.expired.clear();
+    shard.timers.Advance(shard.now_ms, shard.expired);
+    if (shard.expired.empty()) {
         return;
     }
-    if (msg.command == "JOIN") {
-        HandleJoin(fd, msg);
-        return;
+    {
+        std::unique_lock<std::mutex> lock = AcquireState();
+        for (std::size_t i = 0; i < shard.expired.size(); ++i) {
+            HandleConnectionTimer(HandleFromTimerKey(shard.expired[i]));
+        }
     }
-    if (msg.command == "PART") {
-        HandlePart(fd, msg);
+    ReapPendingCloses();
+}
+
+// 상태 잠금을 쥔 소유 샤드에서 호출된다. 휠은 만료된 타이머를 이미 해제했다.
+void PollServer::HandleConnectionTimer(const state::ConnectionHandle &handle) {
+    if (!clients_.IsCurrent(handle)) {
         return;
     }
-    if (msg.command == "PRIVMSG") {
-        HandlePrivmsgNotice(fd, msg, false);
+    const int fd = handle.fd;
+    ClientIo &io = clients_.Io(fd);
+    io.timer = net::kNoTimer;
+    if (io.close_pending) {
         return;
     }
-    if (msg.command == "NOTICE") {
-        HandlePrivmsgNotice(fd, msg, true);
+    const ClientSession &session = clients_.Session(fd);
+    const std::uint64_t now = CurrentShard().now_ms;
+
+    if (!session.registered && config_.registration_timeout > 0 &&
+        now - io.accepted_ms >= config_.registration_timeout * 1000) {
+        IRC_LOG(logger_, config::LogLevel::kInfo, "등록 시간 초과: fd=" << fd);
+        CloseClient(fd);
         return;
     }
-    if (msg.command == "TOPIC") {
-        HandleTopic(fd, msg);
+
+    if (config_.send_stall_timeout > 0 && !io.outbound.empty() &&
+        now - io.last_send_progress_ms >= config_.send_stall_timeout * 1000) {
+        IRC_LOG(logger_, config::LogLevel::kWarn, "송신 정체: fd=" << fd << " nick=" << NickOrStar(session));
+        CloseClient(fd);
         return;
     }
-    if (msg.command == "KICK") {
-        HandleKick(fd, msg);
-        return;
+
+    if (session.registered && config_.ping_interval > 0) {
+        // PING 이후 들어온 입력은 무엇이든 살아 있다는 뜻이다.
+        if (io.ping_outstanding && io.last_activity_ms > io.ping_sent_ms) {
+            io.ping_outstanding = false;
+        }
+        if (io.ping_outstanding) {
+            if (now - io.ping_sent_ms >= config_.pong_timeout * 1000) {
+                IRC_LOG(logger_, config::LogLevel::kInfo,
+                        "PING 응답 없음: fd=" << fd << " nick=" << session.nick);
+                CloseClient(fd);
+                return;
+            }
+        } else if (now - std::max(io.last_activity_ms, io.ping_sent_ms) >=
+                   config_.ping_interval * 1000) {
+            io.ping_sent_ms = now;
+            io.ping_outstanding = config_.pong_timeout > 0;
+            net::LineBuilder ping;
+            ping.Append("PING :").AppendNumber(now);
+            if (!EnqueueLine(fd, ping.Finish())) {
+                ScheduleClose(fd);
+                return;
+            }
+        }
     }
-    if (msg.command == "INVITE") {
-        HandleInvite(fd, msg);
-        return;
+    ArmConnectionTimer(fd);
+}
+
+// 상태 잠금을 쥔 소유 샤드에서 호출한다. 다음으로 확인할 기한 하나에만 타이머를 건다.
+void PollServer::ArmConnectionTimer(int fd) {
+    ClientIo &io = clients_.Io(fd);
+    const ClientSession &session = clients_.Session(fd);
+    std::uint64_t deadline = UINT64_MAX;
+    if (!session.registered && config_.registration_timeout > 0) {
+        deadline = std::min(deadline, io.accepted_ms + config_.registration_timeout * 1000);
+    }
+    if (session.registered && config_.ping_interval > 0) {
+        if (io.ping_outstanding) {
+            deadline = std::min(deadline, io.ping_sent_ms + config_.pong_timeout * 1000);
+        } else {
+            deadline = std::min(deadline, std::max(io.last_activity_ms, io.ping_sent_ms) +
+                                              config_.ping_interval * 1000);
+        }
     }
-    if (msg.command == "MODE") {
-        HandleMode(fd, msg);
-        return;
+    // 송신 정체는 타이머가 울릴 때 큐가 차 있는 경우에만 기한에 넣는다. 라인마다 타이머를 옮기지 않기 위해서다.
+    if (config_.send_stall_timeout > 0 && !io.outbound.empty()) {
+        deadline = std::min(deadline, io.last_send_progress_ms + config_.send_stall_timeout * 1000);
     }
-    if (msg.command == "REHASH") {
-        HandleRehash(fd);
+
+    net::TimerWheel &timers = CurrentShard().timers;
+    if (deadline == UINT64_MAX) {
+        if (io.timer != net::kNoTimer) {
+            timers.Cancel(io.timer);
+            io.timer = net::kNoTimer;
+        }
         return;
     }
-    if (msg.command == "NAMES") {
-        HandleNames(fd, msg);
-        return;
+    if (io.timer == net::kNoTimer) {
+        io.timer = timers.Schedule(TimerKey(clients_.HandleOf(fd)), deadline);
+    } else {
+        timers.Reschedule(io.timer, deadline);
     }
-    if (msg.command == "LIST") {
-        HandleList(fd, msg);
+}
+
+void PollServer::ProcessLine(int fd, std::string_view line) {
+    // 파싱 결과는 입력 링을 빌려 쓰므로 이 라인을 처리하는 동안에는 할당이 없다.
+    protocol::ParsedMessageView msg = protocol::ParseMessageView(line);
+    if (msg.command.empty()) {
         return;
     }
-    if (msg.command == "QUIT") {
-        HandleQuit(fd);
-        return;
+    HandleCommand(fd, msg);
+}
+
+void PollServer::HandleCommand(int fd, const protocol::ParsedMessageView &msg) {
+    const protocol::CommandId command = protocol::LookupCommand(msg.command);
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    DispatchCommand(fd, command, msg);
+    const std::uint64_t elapsed = static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+    ShardMetrics &shard_metrics = CurrentShard().metrics;
+    shard_metrics.commands[static_cast<std::size_t>(command)].Add();
+    shard_metrics.command_ns[static_cast<std::size_t>(command)].Record(elapsed);
+}
+
+void PollServer::DispatchCommand(int fd, protocol::CommandId command, const protocol::ParsedMessageView &msg) {
+    switch (command) {
+        case protocol::CommandId::kPrivmsg:
+            HandlePrivmsgNotice(fd, msg, false);
+            return;
+        case protocol::CommandId::kNotice:
+            HandlePrivmsgNotice(fd, msg, true);
+            return;
+        case protocol::CommandId::kPing:
+            HandlePing(fd, msg);
+            return;
+        case protocol::CommandId::kPong:
+            HandlePong(fd, msg);
+            return;
+        case protocol::CommandId::kPass:
+            HandlePass(fd, msg);
+            return;
+        case protocol::CommandId::kNick:
+            HandleNick(fd, msg);
+            return;
+        case protocol::CommandId::kUser:
+            HandleUser(fd, msg);
+            return;
+        case protocol::CommandId::kJoin:
+            HandleJoin(fd, msg);
+            return;
+        case protocol::CommandId::kPart:
+            HandlePart(fd, msg);
+            return;
+        case protocol::CommandId::kTopic:
+            HandleTopic(fd, msg);
+            return;
+        case protocol::CommandId::kKick:
+            HandleKick(fd, msg);
+            return;
+        case protocol::CommandId::kInvite:
+            HandleInvite(fd, msg);
+            return;
+        case protocol::CommandId::kMode:
+            HandleMode(fd, msg);
+            return;
+        case protocol::CommandId::kRehash:
+            HandleRehash(fd);
+            return;
+        case protocol::CommandId::kNames:
+            HandleNames(fd, msg);
+            return;
+        case protocol::CommandId::kList:
+            HandleList(fd, msg);
+            return;
+        case protocol::CommandId::kQuit:
+            HandleQuit(fd);
+            return;
+        case protocol::CommandId::kOper:
+            HandleOper(fd, msg);
+            return;
+        case protocol::CommandId::kStats:
+            HandleStats(fd, msg);
+            return;
+        case protocol::CommandId::kUnknown:
+            break;
     }
 
-    if (!clients_[fd].registered) {
-        SendNumeric(fd, "451", clients_[fd].nick.empty() ? "*" : clients_[fd].nick,
+    if (!clients_.Session(fd).registered) {
+        SendNumeric(fd, "451", NickOrStar(clients_.Session(fd)),
                     ":등록 필요");
         return;
     }
 
-    SendNumeric(fd, "421", clients_[fd].nick, msg.command + " :알 수 없는 명령");
+    std::pmr::string token(msg.command.data(), msg.command.size(), &CurrentShard().arena);
+    for (std::size_t i = 0; i < token.size(); ++i) {
+        token[i] = static_cast<char>(std::toupper(static_cast<unsigned char>(token[i])));
+    }
+    SendNumeric(fd, "421", clients_.Session(fd).nick, ScratchConcat({token, " :알 수 없는 명령"}));
 }
 
-void PollServer::HandlePing(int fd, const protocol::ParsedMessage &msg) {
+void PollServer::HandlePing(int fd, const protocol::ParsedMessageView &msg) {
     if (msg.params.empty()) {
-        SendNumeric(fd, "409", clients_[fd].nick.empty() ? "*" : clients_[fd].nick,
+        SendNumeric(fd, "409", NickOrStar(clients_.Session(fd)),
                     ":출처 없음");
         return;
     }
 
-    std::string response = "PONG" + FormatPayloadForEcho(msg.params[0]);
-    if (!EnqueueResponse(fd, response)) {
+    const std::string_view payload = msg.params[0];
+    net::LineBuilder response;
+    response.Append("PONG");
+    if (!payload.empty()) {
+        response.Append(payload.find(' ') != std::string_view::npos ? " :" : " ").Append(payload);
+    }
+    if (!EnqueueLine(fd, response.Finish())) {
         CloseClient(fd);
     }
 }
 
-void PollServer::HandlePong(int fd, const protocol::ParsedMessage &msg) {
+void PollServer::HandlePong(int fd, const protocol::ParsedMessageView &msg) {
     if (msg.params.empty()) {
-        SendNumeric(fd, "409", clients_[fd].nick.empty() ? "*" : clients_[fd].nick,
+        SendNumeric(fd, "409", NickOrStar(clients_.Session(fd)),
                     ":출처 없음");
         return;
     }
+    // "PONG :<token>"과 "PONG <server> :<token>" 모두 마지막 파라미터가 token이다.
+    // 보낸 token은 ping_sent_ms의 10진 표기이므로 문자열을 만들지 않고 숫자로 읽어 비교한다.
+    ClientIo &io = clients_.Io(fd);
+    if (!io.ping_outstanding) {
+        return;
+    }
+    const std::string_view token = msg.params[msg.params.size() - 1];
+    std::uint64_t value = 0;
+    const std::from_chars_result parsed = std::from_chars(token.data(), token.data() + token.size(), value);
+    if (parsed.ec == std::errc() && parsed.ptr == token.data() + token.size() && value == io.ping_sent_ms) {
+        io.ping_outstanding = false;
+    }
 }
 
-void PollServer::HandlePass(int fd, const protocol::ParsedMessage &msg) {
-    ClientConnection &conn = clients_[fd];
+void PollServer::HandlePass(int fd, const protocol::ParsedMessageView &msg) {
+    ClientSession &conn = clients_.Session(fd);
     if (conn.registered) {
-        SendNumeric(fd, "462", conn.nick.empty() ? "*" : conn.nick, ":이미 등록됨");
+        SendNumeric(fd, "462", NickOrStar(conn), ":이미 등록됨");
         return;
     }
     if (msg.params.empty()) {
-        SendNumeric(fd, "461", conn.nick.empty() ? "*" : conn.nick,
+        SendNumeric(fd, "461", NickOrStar(conn),
                     "PASS :필수 파라미터 부족", true);
         return;
     }
     if (msg.params[0] != password_) {
-        SendNumeric(fd, "464", conn.nick.empty() ? "*" : conn.nick,
+        SendNumeric(fd, "464", NickOrStar(conn),
                     ":비밀번호 불일치", true);
         return;
     }
@@ -389,194 +1034,219 @@ void PollServer::HandlePass(int fd, const protocol::ParsedMessage &msg) {
     TryCompleteRegistration(fd);
 }
 
-void PollServer::HandleNick(int fd, const protocol::ParsedMessage &msg) {
-    ClientConnection &conn = clients_[fd];
+void PollServer::HandleNick(int fd, const protocol::ParsedMessageView &msg) {
+    ClientSession &conn = clients_.Session(fd);
     if (conn.registered) {
-        SendNumeric(fd, "462", conn.nick.empty() ? "*" : conn.nick, ":이미 등록됨");
+        SendNumeric(fd, "462", NickOrStar(conn), ":이미 등록됨");
         return;
     }
     if (msg.params.empty()) {
-        SendNumeric(fd, "431", conn.nick.empty() ? "*" : conn.nick, ":닉네임 없음");
+        SendNumeric(fd, "431", NickOrStar(conn), ":닉네임 없음");
+        return;
+    }
+    if (!ConsumeRateLimitToken(fd, kRateNick)) {
+        SendNumeric(fd, "439", NickOrStar(conn), "NICK :명령 속도 초과");
         return;
     }
-    const std::string &new_nick = msg.params[0];
+    const std::string_view new_nick = msg.params[0];
     if (!protocol::IsValidNickname(new_nick)) {
-        SendNumeric(fd, "432", conn.nick.empty() ? "*" : conn.nick,
-                    new_nick + " :닉네임 형식 오류");
+        SendNumeric(fd, "432", NickOrStar(conn),
+                    ScratchConcat({new_nick, " :닉네임 형식 오류"}));
         return;
     }
     if (NickInUse(new_nick, fd)) {
-        SendNumeric(fd, "433", conn.nick.empty() ? "*" : conn.nick,
-                    new_nick + " :닉네임 사용 중");
+        SendNumeric(fd, "433", NickOrStar(conn),
+                    ScratchConcat({new_nick, " :닉네임 사용 중"}));
         return;
     }
 
-    conn.nick = new_nick;
+    // 등록 전 닉네임 변경은 이전 닉네임을 인덱스에서 풀어 준다.
+    if (!conn.nick.empty()) {
+        nicks_.Release(conn.nick, fd);
+    }
+    nicks_.Claim(new_nick, fd);
+    conn.nick.assign(new_nick.data(), new_nick.size());
+    conn.prefix_generation = 0;
     TryCompleteRegistration(fd);
 }
 
-void PollServer::HandleUser(int fd, const protocol::ParsedMessage &msg) {
-    ClientConnection &conn = clients_[fd];
+void PollServer::HandleUser(int fd, const protocol::ParsedMessageView &msg) {
+    ClientSession &conn = clients_.Session(fd);
     if (conn.registered) {
-        SendNumeric(fd, "462", conn.nick.empty() ? "*" : conn.nick, ":이미 등록됨");
+        SendNumeric(fd, "462", NickOrStar(conn), ":이미 등록됨");
         return;
     }
     if (msg.params.size() < 4) {
-        SendNumeric(fd, "461", conn.nick.empty() ? "*" : conn.nick,
+        SendNumeric(fd, "461", NickOrStar(conn),
                     "USER :필수 파라미터 부족");
         return;
     }
     conn.username = msg.params[0];
     conn.realname = msg.params[3];
+    conn.prefix_generation = 0;
     conn.user_set = true;
     TryCompleteRegistration(fd);
 }
 
-void PollServer::HandleJoin(int fd, const protocol::ParsedMessage &msg) {
-    ClientConnection &conn = clients_[fd];
+void PollServer::HandleJoin(int fd, const protocol::ParsedMessageView &msg) {
+    ClientSession &conn = clients_.Session(fd);
     if (!conn.registered) {
-        SendNumeric(fd, "451", conn.nick.empty() ? "*" : conn.nick, ":등록 필요");
+        SendNumeric(fd, "451", NickOrStar(conn), ":등록 필요");
         return;
     }
     if (msg.params.empty()) {
-        SendNumeric(fd, "461", conn.nick.empty() ? "*" : conn.nick,
+        SendNumeric(fd, "461", NickOrStar(conn),
                     "JOIN :필수 파라미터 부족");
         return;
     }
-    const std::string &channel = msg.params[0];
-    if (!IsValidChannelName(channel)) {
-        SendNumeric(fd, "476", conn.nick.empty() ? "*" : conn.nick,
-                    channel + " :채널 이름 오류");
+    if (!ConsumeRateLimitToken(fd, kRateJoin)) {
+        SendNumeric(fd, "439", conn.nick, "JOIN :명령 속도 초과");
         return;
     }
-    if (conn.joined_channels.find(channel) != conn.joined_channels.end()) {
-        SendNumeric(fd, "443", conn.nick.empty() ? "*" : conn.nick,
-                    channel + " :이미 채널에 있음");
+    const std::string_view channel = msg.params[0];
+    if (!protocol::IsValidChannelName(channel)) {
+        SendNumeric(fd, "476", NickOrStar(conn),
+                    ScratchConcat({channel, " :채널 이름 오류"}));
+        return;
+    }
+    state::ChannelId existing = channels_.Find(channel);
+    if (existing != state::kNoChannel && channels_.Get(existing).members.Contains(fd)) {
+        SendNumeric(fd, "443", NickOrStar(conn),
+                    ScratchConcat({channel, " :이미 채널에 있음"}));
         return;
     }
 
-    ChannelState &state = channels_[channel];
-    if (!state.members.empty()) {
-        if (state.invite_only && state.invited.find(conn.nick) == state.invited.end()) {
-            SendNumeric(fd, "473", conn.nick.empty() ? "*" : conn.nick,
-                        channel + " :초대 전용");
+    // 빈 채널은 즉시 지우므로 존재하는 채널에는 항상 멤버가 있다.
+    if (existing != state::kNoChannel) {
+        const ChannelState &state = channels_.Get(existing);
+        if (state.invite_only &&
+            state.invited.find(state::FoldCase(conn.nick)) == state.invited.end()) {
+            SendNumeric(fd, "473", NickOrStar(conn),
+                        ScratchConcat({channel, " :초대 전용"}));
             return;
         }
         if (state.has_key) {
             if (msg.params.size() < 2 || msg.params[1] != state.key) {
-                SendNumeric(fd, "475", conn.nick.empty() ? "*" : conn.nick,
-                            channel + " :채널 키 불일치");
+                SendNumeric(fd, "475", NickOrStar(conn),
+                            ScratchConcat({channel, " :채널 키 불일치"}));
                 return;
             }
         }
         if (state.has_user_limit && state.members.size() >= state.user_limit) {
-            SendNumeric(fd, "471", conn.nick.empty() ? "*" : conn.nick,
-                        channel + " :채널 인원 초과");
+            SendNumeric(fd, "471", NickOrStar(conn),
+                        ScratchConcat({channel, " :채널 인원 초과"}));
             return;
         }
     }
-    bool was_empty = state.members.empty();
-    state.members.insert(fd);
-    state.invited.erase(conn.nick);
-    conn.joined_channels.insert(channel);
-    if (was_empty || state.operators.empty()) {
-        state.operators.insert(fd);
+    state::ChannelId id = existing != state::kNoChannel ? existing : channels_.FindOrCreate(channel);
+    ChannelState &state = channels_.Get(id);
+    // 새 채널이거나 운영자가 모두 떠난 채널이면 들어온 사용자가 운영자가 된다.
+    unsigned flags = state.members.OperatorCount() == 0 ? state::kMemberOperator : 0u;
+    state.members.Insert(fd, flags);
+    if (!state.invited.empty()) {
+        state.invited.erase(state::FoldCase(conn.nick));
     }
+    conn.joined_channels.push_back(id);
 
-    std::string line = BuildUserPrefix(fd) + " JOIN " + channel;
-    BroadcastToChannel(channel, line);
+    net::LineBuilder line;
+    line.Append(UserPrefix(fd)).Append(" JOIN ").Append(channels_.Name(id));
+    BroadcastToChannel(id, line.Finish());
 }
 
-void PollServer::HandlePart(int fd, const protocol::ParsedMessage &msg) {
-    ClientConnection &conn = clients_[fd];
+void PollServer::HandlePart(int fd, const protocol::ParsedMessageView &msg) {
+    ClientSession &conn = clients_.Session(fd);
     if (!conn.registered) {
-        SendNumeric(fd, "451", conn.nick.empty() ? "*" : conn.nick, ":등록 필요");
+        SendNumeric(fd, "451", NickOrStar(conn), ":등록 필요");
         return;
     }
     if (msg.params.empty()) {
-        SendNumeric(fd, "461", conn.nick.empty() ? "*" : conn.nick,
+        SendNumeric(fd, "461", NickOrStar(conn),
                     "PART :필수 파라미터 부족");
         return;
     }
-    const std::string &channel = msg.params[0];
-    if (!IsValidChannelName(channel)) {
-        SendNumeric(fd, "476", conn.nick.empty() ? "*" : conn.nick,
-                    channel + " :채널 이름 오류");
+    const std::string_view channel = msg.params[0];
+    if (!protocol::IsValidChannelName(channel)) {
+        SendNumeric(fd, "476", NickOrStar(conn),
+                    ScratchConcat({channel, " :채널 이름 오류"}));
         return;
     }
-    std::map<std::string, ChannelState>::iterator it = channels_.find(channel);
-    if (it == channels_.end() || it->second.members.find(fd) == it->second.members.end()) {
-        SendNumeric(fd, "442", conn.nick.empty() ? "*" : conn.nick,
-                    channel + " :채널에 속해 있지 않음");
+    state::ChannelId id = channels_.Find(channel);
+    if (id == state::kNoChannel || !channels_.Get(id).members.Contains(fd)) {
+        SendNumeric(fd, "442", NickOrStar(conn),
+                    ScratchConcat({channel, " :채널에 속해 있지 않음"}));
         return;
     }
 
-    std::string reason = msg.params.size() >= 2 ? msg.params[1] : "사용자 요청";
-    std::string line = BuildUserPrefix(fd) + " PART " + channel + " :" + reason;
-    BroadcastToChannel(channel, line);
+    const std::string_view reason = msg.params.size() >= 2 ? msg.params[1] : std::string_view("사용자 요청");
+    net::LineBuilder line;
+    line.Append(UserPrefix(fd)).Append(" PART ").Append(channels_.Name(id)).Append(" :").Append(reason);
+    BroadcastToChannel(id, line.Finish());
 
-    DetachClientFromChannel(fd, channel);
+    DetachClientFromChannel(fd, id);
 }
 
-void PollServer::HandlePrivmsgNotice(int fd, const protocol::ParsedMessage &msg, bool notice) {
-    ClientConnection &conn = clients_[fd];
-    const std::string nick = conn.nick.empty() ? "*" : conn.nick;
+void PollServer::HandlePrivmsgNotice(int fd, const protocol::ParsedMessageView &msg, bool notice) {
+    ClientSession &conn = clients_.Session(fd);
+    const std::string_view nick = NickOrStar(conn);
     if (!conn.registered) {
         SendNumeric(fd, "451", nick, ":등록 필요");
         return;
     }
     if (msg.params.empty()) {
-        SendNumeric(fd, "411", nick, msg.command + " :대상 없음");
+        SendNumeric(fd, "411", nick, notice ? "NOTICE :대상 없음" : "PRIVMSG :대상 없음");
         return;
     }
     if (msg.params.size() < 2 || msg.params[1].empty()) {
         SendNumeric(fd, "412", nick, ":본문 없음");
         return;
     }
-    if (!ConsumeRateLimitToken(fd)) {
+    if (!ConsumeRateLimitToken(fd, kRateMessage)) {
         SendNumeric(fd, "439", nick, ":발송 속도 초과");
         return;
     }
 
-    const std::string &target = msg.params[0];
-    const std::string &text = msg.params[1];
-    const std::string command = notice ? " NOTICE " : " PRIVMSG ";
+    const std::string_view target = msg.params[0];
+    const std::string_view text = msg.params[1];
+    const std::string_view command = notice ? " NOTICE " : " PRIVMSG ";
+    const OutboundPriority priority = notice ? kOutboundLow : kOutboundNormal;
 
     if (!target.empty() && target[0] == '#') {
-        if (!IsValidChannelName(target)) {
-            SendNumeric(fd, "403", nick, target + " :채널 없음");
+        if (!protocol::IsValidChannelName(target)) {
+            SendNumeric(fd, "403", nick, ScratchConcat({target, " :채널 없음"}));
             return;
         }
-        std::map<std::string, ChannelState>::iterator it = channels_.find(target);
-        if (it == channels_.end()) {
-            SendNumeric(fd, "403", nick, target + " :채널 없음");
+        state::ChannelId id = channels_.Find(target);
+        if (id == state::kNoChannel) {
+            SendNumeric(fd, "403", nick, ScratchConcat({target, " :채널 없음"}));
             return;
         }
-        if (it->second.members.find(fd) == it->second.members.end()) {
-            SendNumeric(fd, "442", nick, target + " :채널에 속해 있지 않음");
+        if (!channels_.Get(id).members.Contains(fd)) {
+            SendNumeric(fd, "442", nick, ScratchConcat({target, " :채널에 속해 있지 않음"}));
             return;
         }
 
-        std::string line = BuildUserPrefix(fd) + command + target + " :" + text;
-        BroadcastToChannel(target, line, fd);
+        net::LineBuilder line;
+        line.Append(UserPrefix(fd)).Append(command).Append(channels_.Name(id)).Append(" :").Append(text);
+        BroadcastToChannel(id, line.Finish(), fd, priority);
         return;
     }
 
     int target_fd = FindClientFdByNick(target);
     if (target_fd < 0) {
-        SendNumeric(fd, "401", nick, target + " :대상 없음");
+        SendNumeric(fd, "401", nick, ScratchConcat({target, " :대상 없음"}));
         return;
     }
 
-    std::string line = BuildUserPrefix(fd) + command + target + " :" + text;
-    if (!EnqueueResponse(target_fd, line)) {
-        CloseClient(target_fd);
+    net::LineBuilder line;
+    line.Append(UserPrefix(fd)).Append(command).Append(target).Append(" :").Append(text);
+    if (!EnqueueLine(target_fd, line.Finish(), priority)) {
+        ScheduleClose(target_fd);
     }
 }
 
-void PollServer::HandleNames(int fd, const protocol::ParsedMessage &msg) {
-    ClientConnection &conn = clients_[fd];
-    const std::string nick = conn.nick.empty() ? "*" : conn.nick;
+void PollServer::HandleNames(int fd, const protocol::ParsedMessageView &msg) {
+    ClientSession &conn = clients_.Session(fd);
+    const std::string_view nick = NickOrStar(conn);
     if (!conn.registered) {
         SendNumeric(fd, "451", nick, ":등록 필요");
         return;
@@ -585,54 +1255,206 @@ void PollServer::HandleNames(int fd, const protocol::ParsedMessage &msg) {
         SendNumeric(fd, "461", nick, "NAMES :필수 파라미터 부족");
         return;
     }
-    const std::string &channel = msg.params[0];
-    if (!IsValidChannelName(channel)) {
-        SendNumeric(fd, "476", nick, channel + " :채널 이름 오류");
+    const std::string_view channel = msg.params[0];
+    if (!protocol::IsValidChannelName(channel)) {
+        SendNumeric(fd, "476", nick, ScratchConcat({channel, " :채널 이름 오류"}));
+        return;
+    }
+
+    ListingCursor cursor;
+    cursor.kind = ListingCursor::kNames;
+    cursor.channel = channel;
+    StartListing(fd, cursor);
+}
+
+// LIST [<mask|>n|<n>{,...} ...]: 마스크끼리는 OR, 인원 조건은 AND로 묶는다.
+void PollServer::HandleList(int fd, const protocol::ParsedMessageView &msg) {
+    ClientSession &conn = clients_.Session(fd);
+    const std::string_view nick = NickOrStar(conn);
+    if (!conn.registered) {
+        SendNumeric(fd, "451", nick, ":등록 필요");
         return;
     }
 
-    std::map<std::string, ChannelState>::iterator it = channels_.find(channel);
-    if (it != channels_.end() && !it->second.members.empty()) {
-        std::string members_line;
-        for (std::set<int>::const_iterator mem_it = it->second.members.begin();
-             mem_it != it->second.members.end(); ++mem_it) {
-            std::map<int, ClientConnection>::const_iterator client_it = clients_.find(*mem_it);
-            if (client_it == clients_.end()) {
+    ListingCursor cursor;
+    cursor.kind = ListingCursor::kList;
+    for (std::size_t i = 0; i < msg.params.size(); ++i) {
+        std::string_view param = msg.params[i];
+        while (!param.empty()) {
+            std::size_t comma = param.find(',');
+            std::string_view token = param.substr(0, comma);
+            param = comma == std::string_view::npos ? std::string_view() : param.substr(comma + 1);
+            if (token.empty()) {
                 continue;
             }
-            if (!members_line.empty()) {
-                members_line += " ";
+            std::size_t users = 0;
+            if (token[0] == '>' && ParsePositiveNumber(token.substr(1), users)) {
+                cursor.has_min_users = true;
+                cursor.min_users = users;
+            } else if (token[0] == '<' && ParsePositiveNumber(token.substr(1), users)) {
+                cursor.has_max_users = true;
+                cursor.max_users = users;
+            } else {
+                cursor.masks.push_back(std::string(token));
             }
-            members_line += client_it->second.nick.empty() ? "*" : client_it->second.nick;
         }
-        SendNumeric(fd, "353", nick, "= " + channel + " :" + members_line);
     }
-
-    SendNumeric(fd, "366", nick, channel + " :NAMES 종료");
+    StartListing(fd, cursor);
 }
 
-void PollServer::HandleList(int fd, const protocol::ParsedMessage &msg) {
-    (void)msg;
-    ClientConnection &conn = clients_[fd];
-    const std::string nick = conn.nick.empty() ? "*" : conn.nick;
-    if (!conn.registered) {
-        SendNumeric(fd, "451", nick, ":등록 필요");
+void PollServer::StartListing(int fd, const ListingCursor &cursor) {
+    ClientSession &session = clients_.Session(fd);
+    if (session.listings.size() >= kMaxPendingListings) {
+        SendNumeric(fd, "263", session.nick,
+                    cursor.kind == ListingCursor::kList ? "LIST :잠시 후 다시 시도" : "NAMES :잠시 후 다시 시도");
         return;
     }
+    session.listings.push_back(cursor);
+    clients_.Io(fd).listing_pending = true;
+    ContinueListings(fd);
+}
+
+// 상태 잠금을 쥔 소유 샤드에서 호출한다. 송신 큐가 찰 때까지 앞 응답부터 이어서 만든다.
+void PollServer::ContinueListings(int fd) {
+    ClientSession &session = clients_.Session(fd);
+    while (!session.listings.empty()) {
+        if (!AdvanceListing(fd, session.listings.front())) {
+            return;
+        }
+        if (!clients_.Contains(fd) || clients_.Io(fd).close_pending) {
+            return;
+        }
+        session.listings.pop_front();
+    }
+    clients_.Io(fd).listing_pending = false;
+}
+
+// 송신 큐가 목록 배치 기준 아래이고 최대 길이 라인을 더해도 high 워터마크를 넘지 않을 때 한 줄을 더 낸다.
+// 큐가 비어 있으면 항상 낸다(high는 최소 한 라인이다).
+bool PollServer::ListingHasRoom(int fd) const {
+    const ClientIo &io = clients_.Io(fd);
+    if (io.close_pending) {
+        return false;
+    }
+    if (io.outbound.empty()) {
+        return true;
+    }
+    const std::size_t budget = std::min(kListingBatchBytes, outbound_low_bytes_);
+    return io.outbound.size() < budget && io.outbound.size() + kMaxLineLength <= outbound_high_bytes_;
+}
 
-    SendNumeric(fd, "321", nick, "Channel :Users Name");
-    for (std::map<std::string, ChannelState>::const_iterator it = channels_.begin();
-         it != channels_.end(); ++it) {
-        const std::string count = std::to_string(it->second.members.size());
-        const std::string topic = it->second.has_topic ? it->second.topic : "-";
-        SendNumeric(fd, "322", nick, it->first + " " + count + " :" + topic);
+bool PollServer::EmitListingLine(int fd, net::LineBuilder &line) {
+    if (!EnqueueLine(fd, line.Finish())) {
+        ScheduleClose(fd);
+        return false;
     }
-    SendNumeric(fd, "323", nick, ":LIST 종료");
+    return true;
 }
 
-void PollServer::HandleTopic(int fd, const protocol::ParsedMessage &msg) {
-    ClientConnection &conn = clients_[fd];
-    const std::string nick = conn.nick.empty() ? "*" : conn.nick;
+// 응답을 끝냈으면 true, 송신 큐가 차서 멈췄으면 false를 돌려준다.
+bool PollServer::AdvanceListing(int fd, ListingCursor &cursor) {
+    const std::string_view nick = NickOrStar(clients_.Session(fd));
+
+    if (cursor.kind == ListingCursor::kList) {
+        if (!cursor.started) {
+            net::LineBuilder line;
+            line.Append(':').Append(config_.server_name).Append(" 321 ").Append(nick);
+            line.Append(" Channel :Users Name");
+            if (!EmitListingLine(fd, line)) {
+                return false;
+            }
+            cursor.started = true;
+        }
+        while (true) {
+            state::ChannelId id = channels_.NextLive(cursor.last_channel);
+            if (id == state::kNoChannel) {
+                break;
+            }
+            if (!ListingHasRoom(fd)) {
+                return false;
+            }
+            cursor.last_channel = id;
+            const ChannelState &state = channels_.Get(id);
+            const std::size_t count = state.members.size();
+            if ((cursor.has_min_users && count <= cursor.min_users) ||
+                (cursor.has_max_users && count >= cursor.max_users)) {
+                continue;
+            }
+            const std::string &name = channels_.Name(id);
+            if (!cursor.masks.empty()) {
+                bool matched = false;
+                for (std::size_t i = 0; i < cursor.masks.size() && !matched; ++i) {
+                    matched = state::MatchMask(cursor.masks[i], name);
+                }
+                if (!matched) {
+                    continue;
+                }
+            }
+            net::LineBuilder line;
+            line.Append(':').Append(config_.server_name).Append(" 322 ").Append(nick);
+            line.Append(' ').Append(name).Append(' ').AppendNumber(count).Append(" :");
+            line.Append(state.has_topic ? std::string_view(state.topic) : std::string_view("-"));
+            if (!EmitListingLine(fd, line)) {
+                return false;
+            }
+        }
+        if (!ListingHasRoom(fd)) {
+            return false;
+        }
+        net::LineBuilder line;
+        line.Append(':').Append(config_.server_name).Append(" 323 ").Append(nick).Append(" :LIST 종료");
+        EmitListingLine(fd, line);
+        return true;
+    }
+
+    // NAMES: 멤버를 512바이트(CRLF 포함) 안에 들어가는 만큼씩 353 라인에 담는다.
+    state::ChannelId id = channels_.Find(cursor.channel);
+    if (id != state::kNoChannel) {
+        const state::MemberList &members = channels_.Get(id).members;
+        net::LineBuilder header;
+        header.Append(':').Append(config_.server_name).Append(" 353 ").Append(nick);
+        header.Append(" = ").Append(channels_.Name(id)).Append(" :");
+        std::size_t index = members.LowerBound(cursor.next_fd);
+        while (index < members.size()) {
+            if (!ListingHasRoom(fd)) {
+                return false;
+            }
+            net::LineBuilder line = header;
+            bool first = true;
+            for (; index < members.size(); ++index) {
+                if (!clients_.Contains(members[index].fd)) {
+                    continue;
+                }
+                const std::string_view member_nick = NickOrStar(clients_.Session(members[index].fd));
+                const std::size_t extra = (first ? 0 : 1) + member_nick.size();
+                if (!first && line.size() + extra > net::LineBuilder::kMaxContent) {
+                    break;
+                }
+                if (!first) {
+                    line.Append(' ');
+                }
+                line.Append(member_nick);
+                first = false;
+            }
+            cursor.next_fd = index < members.size() ? members[index].fd : INT_MAX;
+            if (!first && !EmitListingLine(fd, line)) {
+                return false;
+            }
+        }
+    }
+    if (!ListingHasRoom(fd)) {
+        return false;
+    }
+    net::LineBuilder line;
+    line.Append(':').Append(config_.server_name).Append(" 366 ").Append(nick);
+    line.Append(' ').Append(cursor.channel).Append(" :NAMES 종료");
+    EmitListingLine(fd, line);
+    return true;
+}
+
+void PollServer::HandleTopic(int fd, const protocol::ParsedMessageView &msg) {
+    ClientSession &conn = clients_.Session(fd);
+    const std::string_view nick = NickOrStar(conn);
     if (!conn.registered) {
         SendNumeric(fd, "451", nick, ":등록 필요");
         return;
@@ -641,45 +1463,46 @@ void PollServer::HandleTopic(int fd, const protocol::ParsedMessage &msg) {
         SendNumeric(fd, "461", nick, "TOPIC :필수 파라미터 부족");
         return;
     }
-    const std::string &channel = msg.params[0];
-    if (!IsValidChannelName(channel)) {
-        SendNumeric(fd, "476", nick, channel + " :채널 이름 오류");
+    const std::string_view channel = msg.params[0];
+    if (!protocol::IsValidChannelName(channel)) {
+        SendNumeric(fd, "476", nick, ScratchConcat({channel, " :채널 이름 오류"}));
         return;
     }
-    std::map<std::string, ChannelState>::iterator it = channels_.find(channel);
-    if (it == channels_.end()) {
-        SendNumeric(fd, "403", nick, channel + " :채널 없음");
+    state::ChannelId id = channels_.Find(channel);
+    if (id == state::kNoChannel) {
+        SendNumeric(fd, "403", nick, ScratchConcat({channel, " :채널 없음"}));
         return;
     }
-    ChannelState &state = it->second;
-    if (state.members.find(fd) == state.members.end()) {
-        SendNumeric(fd, "442", nick, channel + " :채널에 속해 있지 않음");
+    ChannelState &state = channels_.Get(id);
+    if (!state.members.Contains(fd)) {
+        SendNumeric(fd, "442", nick, ScratchConcat({channel, " :채널에 속해 있지 않음"}));
         return;
     }
 
     if (msg.params.size() < 2) {
         if (!state.has_topic) {
-            SendNumeric(fd, "331", nick, channel + " :토픽 없음");
+            SendNumeric(fd, "331", nick, ScratchConcat({channel, " :토픽 없음"}));
         } else {
-            SendNumeric(fd, "332", nick, channel + " :" + state.topic);
+            SendNumeric(fd, "332", nick, ScratchConcat({channel, " :", state.topic}));
         }
         return;
     }
 
     if (state.topic_protected && !IsChannelOperator(state, fd)) {
-        SendNumeric(fd, "482", nick, channel + " :채널 권한 없음");
+        SendNumeric(fd, "482", nick, ScratchConcat({channel, " :채널 권한 없음"}));
         return;
     }
 
     state.topic = msg.params[1];
     state.has_topic = true;
-    std::string line = BuildUserPrefix(fd) + " TOPIC " + channel + " :" + state.topic;
-    BroadcastToChannel(channel, line);
+    net::LineBuilder line;
+    line.Append(UserPrefix(fd)).Append(" TOPIC ").Append(channels_.Name(id)).Append(" :").Append(state.topic);
+    BroadcastToChannel(id, line.Finish());
 }
 
-void PollServer::HandleKick(int fd, const protocol::ParsedMessage &msg) {
-    ClientConnection &conn = clients_[fd];
-    const std::string nick = conn.nick.empty() ? "*" : conn.nick;
+void PollServer::HandleKick(int fd, const protocol::ParsedMessageView &msg) {
+    ClientSession &conn = clients_.Session(fd);
+    const std::string_view nick = NickOrStar(conn);
     if (!conn.registered) {
         SendNumeric(fd, "451", nick, ":등록 필요");
         return;
@@ -688,42 +1511,43 @@ void PollServer::HandleKick(int fd, const protocol::ParsedMessage &msg) {
         SendNumeric(fd, "461", nick, "KICK :필수 파라미터 부족");
         return;
     }
-    const std::string &channel = msg.params[0];
-    const std::string &target_nick = msg.params[1];
-    if (!IsValidChannelName(channel)) {
-        SendNumeric(fd, "476", nick, channel + " :채널 이름 오류");
+    const std::string_view channel = msg.params[0];
+    const std::string_view target_nick = msg.params[1];
+    if (!protocol::IsValidChannelName(channel)) {
+        SendNumeric(fd, "476", nick, ScratchConcat({channel, " :채널 이름 오류"}));
         return;
     }
-    std::map<std::string, ChannelState>::iterator it = channels_.find(channel);
-    if (it == channels_.end()) {
-        SendNumeric(fd, "403", nick, channel + " :채널 없음");
+    state::ChannelId id = channels_.Find(channel);
+    if (id == state::kNoChannel) {
+        SendNumeric(fd, "403", nick, ScratchConcat({channel, " :채널 없음"}));
         return;
     }
-    ChannelState &state = it->second;
-    if (state.members.find(fd) == state.members.end()) {
-        SendNumeric(fd, "442", nick, channel + " :채널에 속해 있지 않음");
+    ChannelState &state = channels_.Get(id);
+    if (!state.members.Contains(fd)) {
+        SendNumeric(fd, "442", nick, ScratchConcat({channel, " :채널에 속해 있지 않음"}));
         return;
     }
     if (!IsChannelOperator(state, fd)) {
-        SendNumeric(fd, "482", nick, channel + " :채널 권한 없음");
+        SendNumeric(fd, "482", nick, ScratchConcat({channel, " :채널 권한 없음"}));
         return;
     }
     int target_fd = FindClientFdByNick(target_nick);
-    if (target_fd < 0 || state.members.find(target_fd) == state.members.end()) {
-        SendNumeric(fd, "441", nick, target_nick + " " + channel + " :대상이 채널에 없음");
+    if (target_fd < 0 || !state.members.Contains(target_fd)) {
+        SendNumeric(fd, "441", nick, ScratchConcat({target_nick, " ", channel, " :대상이 채널에 없음"}));
         return;
     }
 
-    std::string comment = msg.params.size() >= 3 ? msg.params[2] : "강퇴됨";
-    std::string line = BuildUserPrefix(fd) + " KICK " + channel + " " + target_nick +
-                       " :" + comment;
-    BroadcastToChannel(channel, line);
-    DetachClientFromChannel(target_fd, channel);
+    const std::string_view comment = msg.params.size() >= 3 ? msg.params[2] : std::string_view("강퇴됨");
+    net::LineBuilder line;
+    line.Append(UserPrefix(fd)).Append(" KICK ").Append(channels_.Name(id)).Append(' ');
+    line.Append(target_nick).Append(" :").Append(comment);
+    BroadcastToChannel(id, line.Finish());
+    DetachClientFromChannel(target_fd, id);
 }
 
-void PollServer::HandleInvite(int fd, const protocol::ParsedMessage &msg) {
-    ClientConnection &conn = clients_[fd];
-    const std::string nick = conn.nick.empty() ? "*" : conn.nick;
+void PollServer::HandleInvite(int fd, const protocol::ParsedMessageView &msg) {
+    ClientSession &conn = clients_.Session(fd);
+    const std::string_view nick = NickOrStar(conn);
     if (!conn.registered) {
         SendNumeric(fd, "451", nick, ":등록 필요");
         return;
@@ -732,48 +1556,53 @@ void PollServer::HandleInvite(int fd, const protocol::ParsedMessage &msg) {
         SendNumeric(fd, "461", nick, "INVITE :필수 파라미터 부족");
         return;
     }
-    const std::string &target_nick = msg.params[0];
-    const std::string &channel = msg.params[1];
-    if (!IsValidChannelName(channel)) {
-        SendNumeric(fd, "476", nick, channel + " :채널 이름 오류");
+    const std::string_view target_nick = msg.params[0];
+    const std::string_view channel = msg.params[1];
+    if (!protocol::IsValidChannelName(channel)) {
+        SendNumeric(fd, "476", nick, ScratchConcat({channel, " :채널 이름 오류"}));
         return;
     }
-    std::map<std::string, ChannelState>::iterator it = channels_.find(channel);
-    if (it == channels_.end()) {
-        SendNumeric(fd, "403", nick, channel + " :채널 없음");
+    state::ChannelId id = channels_.Find(channel);
+    if (id == state::kNoChannel) {
+        SendNumeric(fd, "403", nick, ScratchConcat({channel, " :채널 없음"}));
         return;
     }
-    ChannelState &state = it->second;
-    if (state.members.find(fd) == state.members.end()) {
-        SendNumeric(fd, "442", nick, channel + " :채널에 속해 있지 않음");
+    ChannelState &state = channels_.Get(id);
+    if (!state.members.Contains(fd)) {
+        SendNumeric(fd, "442", nick, ScratchConcat({channel, " :채널에 속해 있지 않음"}));
         return;
     }
     if (!IsChannelOperator(state, fd)) {
-        SendNumeric(fd, "482", nick, channel + " :채널 권한 없음");
+        SendNumeric(fd, "482", nick, ScratchConcat({channel, " :채널 권한 없음"}));
         return;
     }
     int target_fd = FindClientFdByNick(target_nick);
-    if (target_fd >= 0 && state.members.find(target_fd) != state.members.end()) {
-        SendNumeric(fd, "443", nick, target_nick + " " + channel + " :이미 채널에 있음");
+    if (target_fd >= 0 && state.members.Contains(target_fd)) {
+        SendNumeric(fd, "443", nick, ScratchConcat({target_nick, " ", channel, " :이미 채널에 있음"}));
         return;
     }
 
     if (target_fd < 0) {
-        SendNumeric(fd, "401", nick, target_nick + " :대상 없음");
+        SendNumeric(fd, "401", nick, ScratchConcat({target_nick, " :대상 없음"}));
         return;
     }
 
-    state.invited.insert(target_nick);
-    SendNumeric(fd, "341", nick, target_nick + " " + channel);
-    std::string line = BuildUserPrefix(fd) + " INVITE " + target_nick + " " + channel;
-    if (!EnqueueResponse(target_fd, line)) {
-        CloseClient(target_fd);
+    state.invited.insert(state::FoldCase(target_nick));
+    SendNumeric(fd, "341", nick, ScratchConcat({target_nick, " ", channel}));
+    // 응답을 못 넣어 이 연결이 닫혔다면 파라미터 뷰가 가리키는 입력 링도 사라졌다.
+    if (!clients_.Contains(fd)) {
+        return;
+    }
+    net::LineBuilder line;
+    line.Append(UserPrefix(fd)).Append(" INVITE ").Append(target_nick).Append(' ').Append(channel);
+    if (!EnqueueLine(target_fd, line.Finish())) {
+        ScheduleClose(target_fd);
     }
 }
 
-void PollServer::HandleMode(int fd, const protocol::ParsedMessage &msg) {
-    ClientConnection &conn = clients_[fd];
-    const std::string nick = conn.nick.empty() ? "*" : conn.nick;
+void PollServer::HandleMode(int fd, const protocol::ParsedMessageView &msg) {
+    ClientSession &conn = clients_.Session(fd);
+    const std::string_view nick = NickOrStar(conn);
     if (!conn.registered) {
         SendNumeric(fd, "451", nick, ":등록 필요");
         return;
@@ -782,37 +1611,37 @@ void PollServer::HandleMode(int fd, const protocol::ParsedMessage &msg) {
         SendNumeric(fd, "461", nick, "MODE :필수 파라미터 부족");
         return;
     }
-    const std::string &channel = msg.params[0];
-    if (!IsValidChannelName(channel)) {
-        SendNumeric(fd, "476", nick, channel + " :채널 이름 오류");
+    const std::string_view channel = msg.params[0];
+    if (!protocol::IsValidChannelName(channel)) {
+        SendNumeric(fd, "476", nick, ScratchConcat({channel, " :채널 이름 오류"}));
         return;
     }
-    std::map<std::string, ChannelState>::iterator it = channels_.find(channel);
-    if (it == channels_.end()) {
-        SendNumeric(fd, "403", nick, channel + " :채널 없음");
+    state::ChannelId id = channels_.Find(channel);
+    if (id == state::kNoChannel) {
+        SendNumeric(fd, "403", nick, ScratchConcat({channel, " :채널 없음"}));
         return;
     }
-    ChannelState &state = it->second;
-    if (state.members.find(fd) == state.members.end()) {
-        SendNumeric(fd, "442", nick, channel + " :채널에 속해 있지 않음");
+    ChannelState &state = channels_.Get(id);
+    if (!state.members.Contains(fd)) {
+        SendNumeric(fd, "442", nick, ScratchConcat({channel, " :채널에 속해 있지 않음"}));
         return;
     }
 
     if (msg.params.size() == 1) {
-        SendNumeric(fd, "324", nick, channel + " " + BuildModeReply(state));
+        SendNumeric(fd, "324", nick, BuildModeReply(channel, state));
         return;
     }
 
     if (!IsChannelOperator(state, fd)) {
-        SendNumeric(fd, "482", nick, channel + " :채널 권한 없음");
+        SendNumeric(fd, "482", nick, ScratchConcat({channel, " :채널 권한 없음"}));
         return;
     }
 
-    const std::string &mode_tokens = msg.params[1];
+    const std::string_view mode_tokens = msg.params[1];
     bool add = true;
     char last_appended_sign = '\0';
-    std::string applied;
-    std::vector<std::string> applied_params;
+    std::pmr::string applied(&CurrentShard().arena);
+    std::pmr::vector<std::string_view> applied_params(&CurrentShard().arena);
     std::size_t param_index = 2;
 
     for (std::size_t i = 0; i < mode_tokens.size(); ++i) {
@@ -857,21 +1686,19 @@ void PollServer::HandleMode(int fd, const protocol::ParsedMessage &msg) {
                     SendNumeric(fd, "461", nick, "MODE :필수 파라미터 부족");
                     return;
                 }
-                const std::string &target_nick = msg.params[param_index++];
+                const std::string_view target_nick = msg.params[param_index++];
                 int target_fd = FindClientFdByNick(target_nick);
                 if (target_fd < 0) {
-                    SendNumeric(fd, "401", nick, target_nick + " :대상 없음");
+                    SendNumeric(fd, "401", nick, ScratchConcat({target_nick, " :대상 없음"}));
                     return;
                 }
-                if (state.members.find(target_fd) == state.members.end()) {
+                if (!state.members.Contains(target_fd)) {
                     SendNumeric(fd, "441", nick,
-                                target_nick + " " + channel + " :대상이 채널에 없음");
+                                ScratchConcat({target_nick, " ", channel, " :대상이 채널에 없음"}));
                     return;
                 }
-                if (add) {
-                    state.operators.insert(target_fd);
-                } else {
-                    state.operators.erase(target_fd);
+                state.members.SetFlag(target_fd, state::kMemberOperator, add);
+                if (!add) {
                     PromoteOperatorIfNeeded(state);
                 }
                 applied.push_back('o');
@@ -893,7 +1720,7 @@ void PollServer::HandleMode(int fd, const protocol::ParsedMessage &msg) {
                     state.has_user_limit = true;
                     state.user_limit = limit;
                     applied.push_back('l');
-                    applied_params.push_back(std::to_string(limit));
+                    applied_params.push_back(ScratchNumber(limit));
                 } else {
                     state.has_user_limit = false;
                     state.user_limit = 0;
@@ -901,7 +1728,7 @@ void PollServer::HandleMode(int fd, const protocol::ParsedMessage &msg) {
                 }
                 break;
             default:
-                SendNumeric(fd, "472", nick, std::string(1, c) + " :지원하지 않는 모드");
+                SendNumeric(fd, "472", nick, ScratchConcat({std::string_view(&c, 1), " :지원하지 않는 모드"}));
                 return;
         }
     }
@@ -910,75 +1737,57 @@ void PollServer::HandleMode(int fd, const protocol::ParsedMessage &msg) {
         return;
     }
 
-    std::string line = BuildUserPrefix(fd) + " MODE " + channel + " " + applied;
+    net::LineBuilder line;
+    line.Append(UserPrefix(fd)).Append(" MODE ").Append(channels_.Name(id)).Append(' ').Append(applied);
     for (std::size_t i = 0; i < applied_params.size(); ++i) {
-        line += " " + applied_params[i];
+        line.Append(' ').Append(applied_params[i]);
     }
-    BroadcastToChannel(channel, line);
+    BroadcastToChannel(id, line.Finish());
 }
 
 void PollServer::HandleQuit(int fd) { CloseClient(fd); }
 
-void PollServer::SendNumeric(int fd, const std::string &code, const std::string &target,
-                             const std::string &message, bool close_after) {
-    std::string line = std::string(":") + config_.server_name + " " + code + " " + target +
-                       " " + message;
-    if (!EnqueueResponse(fd, line)) {
+void PollServer::SendNumeric(int fd, std::string_view code, std::string_view target,
+                             std::string_view message, bool close_after) {
+    net::LineBuilder line;
+    line.Append(':').Append(config_.server_name).Append(' ').Append(code).Append(' ').Append(target);
+    line.Append(' ').Append(message);
+    if (!EnqueueLine(fd, line.Finish())) {
         CloseClient(fd);
         return;
     }
     if (close_after) {
-        clients_[fd].marked_close = true;
+        clients_.Io(fd).marked_close = true;
     }
 }
 
-bool PollServer::NickInUse(const std::string &nick, int requester_fd) const {
-    for (std::map<int, ClientConnection>::const_iterator it = clients_.begin(); it != clients_.end();
-         ++it) {
-        if (it->first == requester_fd) {
-            continue;
-        }
-        if (it->second.nick == nick) {
-            return true;
-        }
-    }
-    return false;
+bool PollServer::NickInUse(std::string_view nick, int requester_fd) const {
+    return nicks_.InUse(nick, requester_fd);
 }
 
-int PollServer::FindClientFdByNick(const std::string &nick) const {
-    for (std::map<int, ClientConnection>::const_iterator it = clients_.begin(); it != clients_.end();
-         ++it) {
-        if (!it->second.registered) {
-            continue;
-        }
-        if (it->second.nick == nick) {
-            return it->first;
-        }
+// 인덱스에는 등록 전 연결도 들어 있으므로 등록 완료된 연결만 대상으로 돌려준다.
+int PollServer::FindClientFdByNick(std::string_view nick) const {
+    int fd = nicks_.Find(nick);
+    if (fd < 0) {
+        return -1;
     }
-    return -1;
+    if (!clients_.Contains(fd) || !clients_.Session(fd).registered) {
+        return -1;
+    }
+    return fd;
 }
 
-bool PollServer::ConsumeRateLimitToken(int fd) {
-    if (config_.messages_per_5s == 0) {
+bool PollServer::ConsumeRateLimitToken(int fd, RateClass rate_class) {
+    EventShard &shard = CurrentShard();
+    if (clients_.Session(fd).command_rate[rate_class].TryAcquire(command_rate_[rate_class], shard.now_ms)) {
         return true;
     }
-
-    ClientConnection &conn = clients_[fd];
-    const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
-    const std::chrono::steady_clock::time_point cutoff = now - kRateWindow;
-    while (!conn.recent_messages.empty() && conn.recent_messages.front() < cutoff) {
-        conn.recent_messages.pop_front();
-    }
-
-    if (conn.recent_messages.size() >= config_.messages_per_5s) {
-        return false;
-    }
-    conn.recent_messages.push_back(now);
-    return true;
+    shard.metrics.rate_limited[rate_class].Add();
+    return false;
 }
 
 void PollServer::TryCompleteRegistration(int fd) {
-    ClientConnection &conn = clients_[fd];
+    ClientSession &conn = clients_.Session(fd);
     if (conn.registered) {
         return;
     }
@@ -987,133 +1796,203 @@ void PollServer::TryCompleteRegistration(int fd) {
     }
     conn.registered = true;
     SendNumeric(fd, "001", conn.nick, ":등록 완료");
-}
-
-void PollServer::BroadcastToChannel(const std::string &channel, const std::string &line,
-                                    int exclude_fd) {
-    std::map<std::string, ChannelState>::iterator it = channels_.find(channel);
-    if (it == channels_.end()) {
+    // 001을 넣지 못하면 SendNumeric이 연결을 이미 닫았다. 닫혔거나 닫히는 중인 연결에는 타이머를 다시 걸지 않는다.
+    if (!clients_.Contains(fd) || clients_.Io(fd).close_pending) {
         return;
     }
-    std::set<int> recipients = it->second.members;
-    for (std::set<int>::iterator mem_it = recipients.begin(); mem_it != recipients.end(); ++mem_it) {
-        int member_fd = *mem_it;
+    // 등록 기한 대신 PING 주기로 타이머를 옮긴다.
+    ArmConnectionTimer(fd);
+}
+
+// 작은 채널은 같은 샤드 수신자 큐에 라인을 바로 복사하고, 큰 채널은 게시 청크 하나를 나눠 쓴다.
+// 다른 샤드로 넘길 때는 공유 버퍼를 한 번 만들어 샤드마다 한 항목으로 보낸다.
+void PollServer::BroadcastToChannel(state::ChannelId channel, std::string_view line, int exclude_fd,
+                                    OutboundPriority priority) {
+    if (!channels_.IsLive(channel)) {
+        return;
+    }
+    // 큐 초과 멤버는 종료만 예약하므로 순회 중에 멤버 배열이 바뀌지 않아 복사 없이 그대로 훑는다.
+    const state::MemberList &members = channels_.Get(channel).members;
+    const bool sharded = shards_.size() > 1;
+    EventShard &self = CurrentShard();
+    // 큰 채널은 라인을 게시 청크에 한 번만 복사하고 수신자 큐에는 구간만 붙인다. 첫 로컬 수신자에서 게시한다.
+    const bool share = members.size() >= kSharedFanoutRecipients && line.size() <= net::OutboundChunk::kCapacity;
+    net::OutboundSlice slice;
+    const net::OutboundSlice *shared = nullptr;
+    for (std::size_t i = 0; i < members.size(); ++i) {
+        int member_fd = members[i].fd;
         if (exclude_fd >= 0 && member_fd == exclude_fd) {
             continue;
         }
-        if (clients_.find(member_fd) == clients_.end()) {
+        if (!clients_.Contains(member_fd)) {
             continue;
         }
-        if (!EnqueueResponse(member_fd, line)) {
-            CloseClient(member_fd);
+        if (sharded) {
+            std::size_t owner = clients_.Session(member_fd).shard;
+            if (owner != self.index) {
+                self.outgoing[owner].push_back(clients_.HandleOf(member_fd));
+                continue;
+            }
+        }
+        if (share && shared == nullptr) {
+            slice = self.chunk_pool.Publish(line);
+            shared = &slice;
+        }
+        if (!EnqueueLine(member_fd, line, priority, shared)) {
+            ScheduleClose(member_fd);
         }
     }
-}
-
-std::string PollServer::BuildUserPrefix(int fd) const {
-    std::map<int, ClientConnection>::const_iterator it = clients_.find(fd);
-    if (it == clients_.end()) {
-        return std::string(":*");
-    }
-    const ClientConnection &conn = it->second;
-    std::string nick = conn.nick.empty() ? "*" : conn.nick;
-    std::string user = conn.username.empty() ? "user" : conn.username;
-    return std::string(":") + nick + "!" + user + "@" + config_.server_name;
-}
-
-bool PollServer::IsValidChannelName(const std::string &name) const {
-    if (name.size() < 2 || name.size() > 50) {
-        return false;
-    }
-    if (name[0] != '#') {
-        return false;
+    if (!sharded) {
+        return;
     }
-    for (std::size_t i = 1; i < name.size(); ++i) {
-        unsigned char c = static_cast<unsigned char>(name[i]);
-        if (!(std::isalnum(c) || c == '_' || c == '-')) {
-            return false;
+    // 다른 샤드 수신자는 샤드마다 한 항목으로 묶어 우편함 푸시와 깨우기를 한 번씩만 한다.
+    net::SharedBuffer buffer;
+    for (std::size_t s = 0; s < self.outgoing.size(); ++s) {
+        if (self.outgoing[s].empty()) {
+            continue;
         }
+        if (!buffer) {
+            buffer = std::make_shared<const std::string>(line);
+        }
+        ShardDelivery delivery;
+        delivery.buffer = buffer;
+        delivery.targets.swap(self.outgoing[s]);
+        delivery.priority = priority;
+        PostToShard(s, std::move(delivery));
     }
-    return true;
+}
+
+// 메시지를 보낼 때마다 ":nick!user@server"를 다시 만들지 않는다. NICK/USER는 세션의 세대를, REHASH는 서버 세대를 바꿔 무효화한다.
+const std::string &PollServer::UserPrefix(int fd) {
+    static const std::string kUnknown(":*");
+    if (!clients_.Contains(fd)) {
+        return kUnknown;
+    }
+    ClientSession &conn = clients_.Session(fd);
+    if (conn.prefix_generation != prefix_generation_) {
+        conn.prefix.clear();
+        conn.prefix.append(":").append(NickOrStar(conn)).append("!");
+        conn.prefix.append(conn.username.empty() ? std::string_view("user") : std::string_view(conn.username));
+        conn.prefix.append("@").append(config_.server_name);
+        conn.prefix_generation = prefix_generation_;
+    }
+    return conn.prefix;
 }
 
 void PollServer::RemoveFromAllChannels(int fd, const std::string &reason) {
-    std::map<int, ClientConnection>::iterator it = clients_.find(fd);
-    if (it == clients_.end()) {
+    if (!clients_.Contains(fd)) {
         return;
     }
-    ClientConnection &conn = it->second;
-    std::vector<std::string> channels(conn.joined_channels.begin(), conn.joined_channels.end());
+    ClientSession &conn = clients_.Session(fd);
+    const std::vector<state::ChannelId> channels = conn.joined_channels;
     for (std::size_t i = 0; i < channels.size(); ++i) {
-        const std::string &channel = channels[i];
-        std::map<std::string, ChannelState>::iterator chan_it = channels_.find(channel);
-        if (chan_it == channels_.end()) {
-            conn.joined_channels.erase(channel);
-            continue;
+        // 떠나는 본인은 곧 닫히므로 PART를 받을 필요가 없고, 본인 큐 초과로 재진입하지도 않는다.
+        if (channels_.IsLive(channels[i])) {
+            net::LineBuilder line;
+            line.Append(UserPrefix(fd)).Append(" PART ").Append(channels_.Name(channels[i]));
+            line.Append(" :").Append(reason);
+            BroadcastToChannel(channels[i], line.Finish(), fd);
         }
-        std::string line = BuildUserPrefix(fd) + " PART " + channel + " :" + reason;
-        BroadcastToChannel(channel, line);
-        DetachClientFromChannel(fd, channel);
+        DetachClientFromChannel(fd, channels[i]);
     }
 }
 
-bool PollServer::EnqueueResponse(int fd, const std::string &line) {
-    ClientConnection &conn = clients_[fd];
-    const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
-    while (!conn.recent_outbound.empty() && conn.recent_outbound.front() < now - kOutboundWindow) {
-        conn.recent_outbound.pop_front();
+// line은 CRLF까지 포함한다. false는 큐 초과로 연결을 닫아야 한다는 뜻이다.
+// 낮은 우선순위 라인은 워터마크나 전체 상한 중 하나라도 넘으면 버리고 true를 돌려준다. 연결을 끊는 것은 일반 라인뿐이다.
+bool PollServer::EnqueueLine(int fd, std::string_view line, OutboundPriority priority,
+                             const net::OutboundSlice *shared) {
+    if (!clients_.Contains(fd)) {
+        return false;
     }
-    if (conn.recent_outbound.size() >= max_outbound_queue_) {
-        std::ostringstream oss;
-        oss << "송신 큐 초과: fd=" << fd << " nick="
-            << (conn.nick.empty() ? "*" : conn.nick);
-        logger_.Log(config::LogLevel::kWarn, oss.str());
+    if (shards_.size() > 1) {
+        std::size_t owner = clients_.Session(fd).shard;
+        if (owner != CurrentShard().index) {
+            // 큐 초과 판정은 소유 샤드가 우편함에서 꺼낼 때 한다.
+            ShardDelivery delivery;
+            delivery.buffer = std::make_shared<const std::string>(line);
+            delivery.targets.push_back(clients_.HandleOf(fd));
+            delivery.priority = priority;
+            PostToShard(owner, std::move(delivery));
+            return true;
+        }
+    }
+    ClientIo &conn = clients_.Io(fd);
+    if (conn.close_pending) {
         return false;
     }
-    if (conn.enqueues_since_last_write >= max_outbound_queue_) {
-        std::ostringstream oss;
-        oss << "송신 큐 초과: fd=" << fd << " nick="
-            << (conn.nick.empty() ? "*" : conn.nick);
-        logger_.Log(config::LogLevel::kWarn, oss.str());
+    const std::size_t size = line.size();
+    const bool over_total = outbound_total_cap_ > 0 &&
+                            outbound_bytes_.load(std::memory_order_relaxed) + size > outbound_total_cap_;
+    const bool over_high = conn.outbound.size() + size > outbound_high_bytes_;
+    const bool over_low = conn.outbound.size() >= outbound_low_bytes_;
+    if (priority == kOutboundLow && (over_low || over_high || over_total)) {
+        outbound_dropped_lines_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    // 전체 상한에 걸리면 low 워터마크 아래의 정상 연결은 그대로 받고, 밀린 연결만 내보낸다.
+    if (over_high || (over_total && over_low)) {
+        const std::uint64_t evictions = outbound_evictions_.fetch_add(1, std::memory_order_relaxed) + 1;
+        IRC_LOG(logger_, config::LogLevel::kWarn,
+                (over_high ? "송신 큐 초과" : "전체 송신 메모리 초과")
+                    << ": fd=" << fd << " nick=" << NickOrStar(clients_.Session(fd))
+                    << " queued=" << conn.outbound.size() << " evictions=" << evictions
+                    << " drops=" << outbound_dropped_lines_.load(std::memory_order_relaxed));
         return false;
     }
-    conn.outbound_queue.push_back(line + "\r\n");
-    ++conn.enqueues_since_last_write;
-    conn.recent_outbound.push_back(now);
+    const bool was_empty = conn.outbound.empty();
+    if (shared != nullptr) {
+        conn.outbound.AppendShared(CurrentShard().chunk_pool, *shared);
+    } else {
+        conn.outbound.Append(CurrentShard().chunk_pool, line);
+    }
+    outbound_bytes_.fetch_add(size, std::memory_order_relaxed);
+    if (was_empty) {
+        // 정체 시간은 큐가 차기 시작한 때부터 잰다. 걸린 타이머가 없으면 정체 검사용으로 하나 건다.
+        conn.last_send_progress_ms = CurrentShard().now_ms;
+        if (conn.timer == net::kNoTimer && config_.send_stall_timeout > 0) {
+            ArmConnectionTimer(fd);
+        }
+    }
     UpdatePollWriteInterest(fd);
     return true;
 }
 
+void PollServer::ReleaseQueuedBytes(ClientIo &conn, std::size_t bytes) {
+    conn.outbound.Consume(bytes);
+    outbound_bytes_.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
 void PollServer::UpdatePollWriteInterest(int fd) {
-    for (std::size_t i = 0; i < poll_fds_.size(); ++i) {
-        if (poll_fds_[i].fd == fd) {
-            poll_fds_[i].events = POLLIN;
-            if (!clients_[fd].outbound_queue.empty()) {
-                poll_fds_[i].events |= POLLOUT;
-            }
-            poll_fds_[i].revents = 0;
-            return;
-        }
+    unsigned interest = net::kEventRead;
+    if (!clients_.Io(fd).outbound.empty()) {
+        interest |= net::kEventWrite;
     }
+    CurrentShard().reactor->Modify(fd, interest);
 }
 
-void PollServer::DetachClientFromChannel(int fd, const std::string &channel) {
-    std::map<std::string, ChannelState>::iterator chan_it = channels_.find(channel);
-    if (chan_it == channels_.end()) {
+void PollServer::DetachClientFromChannel(int fd, state::ChannelId channel) {
+    // 빈 채널의 ID는 재사용되므로 가입 목록에서는 채널 상태와 무관하게 먼저 뺀다.
+    if (clients_.Contains(fd)) {
+        std::vector<state::ChannelId> &joined = clients_.Session(fd).joined_channels;
+        for (std::size_t i = 0; i < joined.size(); ++i) {
+            if (joined[i] == channel) {
+                joined[i] = joined.back();
+                joined.pop_back();
+                break;
+            }
+        }
+    }
+    if (!channels_.IsLive(channel)) {
         return;
     }
-    ChannelState &state = chan_it->second;
-    state.members.erase(fd);
-    state.operators.erase(fd);
-
-    std::map<int, ClientConnection>::iterator client_it = clients_.find(fd);
-    if (client_it != clients_.end()) {
-        state.invited.erase(client_it->second.nick);
-        client_it->second.joined_channels.erase(channel);
+    ChannelState &state = channels_.Get(channel);
+    state.members.Erase(fd);
+    if (clients_.Contains(fd) && !state.invited.empty()) {
+        state.invited.erase(state::FoldCase(clients_.Session(fd).nick));
     }
 
     if (state.members.empty()) {
-        channels_.erase(chan_it);
+        channels_.Erase(channel);
         return;
     }
     PromoteOperatorIfNeeded(state);
@@ -1123,18 +2002,18 @@ void PollServer::PromoteOperatorIfNeeded(ChannelState &state) {
     if (state.members.empty()) {
         return;
     }
-    if (!state.operators.empty()) {
+    if (state.members.OperatorCount() > 0) {
         return;
     }
-    int promote_fd = *state.members.begin();
-    state.operators.insert(promote_fd);
+    // 멤버 배열이 fd 순이므로 가장 작은 fd가 승격된다.
+    state.members.SetFlag(state.members[0].fd, state::kMemberOperator, true);
 }
 
 bool PollServer::IsChannelOperator(const ChannelState &state, int fd) const {
-    return state.operators.find(fd) != state.operators.end();
+    return state.members.HasFlag(fd, state::kMemberOperator);
 }
 
-bool PollServer::ParsePositiveNumber(const std::string &value, std::size_t &out) const {
+bool PollServer::ParsePositiveNumber(std::string_view value, std::size_t &out) const {
     if (value.empty()) {
         return false;
     }
@@ -1153,34 +2032,31 @@ bool PollServer::ParsePositiveNumber(const std::string &value, std::size_t &out)
     return true;
 }
 
-std::string PollServer::BuildModeReply(const ChannelState &state) const {
-    std::string modes = "+";
+std::string_view PollServer::BuildModeReply(std::string_view channel, const ChannelState &state) const {
+    char modes[5];
+    std::size_t count = 0;
+    modes[count++] = '+';
     if (state.invite_only) {
-        modes += "i";
+        modes[count++] = 'i';
     }
     if (state.topic_protected) {
-        modes += "t";
+        modes[count++] = 't';
     }
     if (state.has_key) {
-        modes += "k";
+        modes[count++] = 'k';
     }
     if (state.has_user_limit) {
-        modes += "l";
+        modes[count++] = 'l';
     }
-
-    std::string params;
-    if (state.has_key) {
-        params += " " + state.key;
-    }
-    if (state.has_user_limit) {
-        params += " " + std::to_string(state.user_limit);
-    }
-    return modes + params;
+    const std::string_view key = state.has_key ? std::string_view(state.key) : std::string_view();
+    const std::string_view limit = state.has_user_limit ? ScratchNumber(state.user_limit) : std::string_view();
+    return ScratchConcat({channel, " ", std::string_view(modes, count), key.empty() ? "" : " ", key,
+                          limit.empty() ? "" : " ", limit});
 }
 
 void PollServer::HandleRehash(int fd) {
-    ClientConnection &conn = clients_[fd];
-    const std::string nick = conn.nick.empty() ? "*" : conn.nick;
+    ClientSession &conn = clients_.Session(fd);
+    const std::string_view nick = NickOrStar(conn);
     if (!conn.registered) {
         SendNumeric(fd, "451", nick, ":등록 필요");
         return;
@@ -1196,11 +2072,244 @@ void PollServer::HandleRehash(int fd) {
     SendNumeric(fd, "382", nick, config_path_ + " :설정 리로드 완료");
 }
 
+void PollServer::HandleOper(int fd, const protocol::ParsedMessageView &msg) {
+    ClientSession &conn = clients_.Session(fd);
+    const std::string_view nick = NickOrStar(conn);
+    if (!conn.registered) {
+        SendNumeric(fd, "451", nick, ":등록 필요");
+        return;
+    }
+    if (msg.params.size() < 2) {
+        SendNumeric(fd, "461", nick, "OPER :필수 파라미터 부족");
+        return;
+    }
+    if (config_.oper_password.empty()) {
+        SendNumeric(fd, "491", nick, ":운영자 설정 없음");
+        return;
+    }
+    if (msg.params[1] != config_.oper_password) {
+        SendNumeric(fd, "464", nick, ":비밀번호 불일치");
+        return;
+    }
+    conn.oper = true;
+    IRC_LOG(logger_, config::LogLevel::kInfo, "서버 운영자 권한 부여: fd=" << fd << " nick=" << nick);
+    SendNumeric(fd, "381", nick, ":서버 운영자 권한 부여");
+}
+
+// m: 명령별 횟수와 처리 시간, u: 가동 시간, z: 게이지와 카운터. 어느 경우든 219로 끝낸다.
+void PollServer::HandleStats(int fd, const protocol::ParsedMessageView &msg) {
+    ClientSession &conn = clients_.Session(fd);
+    const std::string_view nick = NickOrStar(conn);
+    if (!conn.registered) {
+        SendNumeric(fd, "451", nick, ":등록 필요");
+        return;
+    }
+    if (!conn.oper) {
+        SendNumeric(fd, "481", nick, ":권한 없음");
+        return;
+    }
+    const char query = msg.params.empty() || msg.params[0].empty() ? 'm' : msg.params[0][0];
+    ServerStats stats;
+    CollectStats(stats);
+
+    // 응답마다 ":서버 코드 닉 "으로 시작하는 라인을 스택 빌더에 만든다. 큐에 넣지 못하면 연결을 닫도록 예약한다.
+    const auto begin = [&](net::LineBuilder &line, const char *code) {
+        line.Append(':').Append(config_.server_name).Append(' ').Append(code).Append(' ').Append(nick).Append(' ');
+    };
+    if (query == 'm') {
+        // 명령마다 한 줄이라 큐가 넘칠 수 있다. 실패하면 남은 줄은 만들지 않는다.
+        for (std::size_t i = 0; i < protocol::kCommandCount; ++i) {
+            if (stats.commands[i] == 0) {
+                continue;
+            }
+            const metrics::HistogramSnapshot &latency = stats.command_ns[i];
+            net::LineBuilder line;
+            begin(line, "212");
+            const char *name = protocol::CommandName(static_cast<protocol::CommandId>(i));
+            line.Append(*name != '\0' ? name : "UNKNOWN").Append(' ').AppendNumber(stats.commands[i]);
+            line.Append(" :p50=").AppendNumber(latency.Percentile(0.5)).Append("ns p99=");
+            line.AppendNumber(latency.Percentile(0.99)).Append("ns p999=");
+            line.AppendNumber(latency.Percentile(0.999)).Append("ns max=").AppendNumber(latency.max()).Append("ns");
+            if (!EnqueueLine(fd, line.Finish())) {
+                ScheduleClose(fd);
+                return;
+            }
+        }
+    } else if (query == 'u') {
+        net::LineBuilder line;
+        begin(line, "242");
+        line.Append(":서버 가동 ").AppendNumber(stats.uptime_ms / 1000).Append("초");
+        if (!EnqueueLine(fd, line.Finish())) {
+            ScheduleClose(fd);
+            return;
+        }
+    } else if (query == 'z') {
+        const std::pair<const char *, std::uint64_t> values[] = {
+            std::make_pair("connections", stats.connections),
+            std::make_pair("channels", stats.channels),
+            std::make_pair("outbound_queued_bytes", stats.outbound_bytes),
+            std::make_pair("outbound_dropped_lines", stats.outbound_dropped_lines),
+            std::make_pair("outbound_evictions", stats.outbound_evictions),
+            std::make_pair("outbound_chunks_in_use", stats.outbound_chunks_in_use),
+            std::make_pair("outbound_chunks_free", stats.outbound_chunks_free),
+            std::make_pair("outbound_chunk_allocations", stats.outbound_chunk_allocations),
+            std::make_pair("rate_limited_message", stats.rate_limited[kRateMessage]),
+            std::make_pair("rate_limited_join", stats.rate_limited[kRateJoin]),
+            std::make_pair("rate_limited_nick", stats.rate_limited[kRateNick]),
+            std::make_pair("accepted", stats.accepted),
+            std::make_pair("read_deferrals", stats.read_deferrals),
+            std::make_pair("log_dropped_lines", stats.log_dropped_lines),
+        };
+        for (std::size_t i = 0; i < sizeof(values) / sizeof(values[0]); ++i) {
+            net::LineBuilder line;
+            begin(line, "249");
+            line.Append(values[i].first).Append(' ').AppendNumber(values[i].second);
+            if (!EnqueueLine(fd, line.Finish())) {
+                ScheduleClose(fd);
+                return;
+            }
+        }
+        for (std::size_t i = 0; i < stats.shard_wakeups.size(); ++i) {
+            const metrics::HistogramSnapshot &batch = stats.shard_batch_events[i];
+            net::LineBuilder line;
+            begin(line, "249");
+            line.Append("shard").AppendNumber(i).Append(" wakeups=").AppendNumber(stats.shard_wakeups[i]);
+            line.Append(" batch_p50=").AppendNumber(batch.Percentile(0.5));
+            line.Append(" batch_p99=").AppendNumber(batch.Percentile(0.99));
+            line.Append(" batch_max=").AppendNumber(batch.max());
+            if (!EnqueueLine(fd, line.Finish())) {
+                ScheduleClose(fd);
+                return;
+            }
+        }
+    }
+    net::LineBuilder end;
+    begin(end, "219");
+    end.Append(query).Append(" :STATS 종료");
+    if (!EnqueueLine(fd, end.Finish())) {
+        ScheduleClose(fd);
+    }
+}
+
+// 상태 잠금을 쥔 채 부른다. 샤드 지표는 각 샤드 스레드가 계속 쓰므로 근사치다.
+void PollServer::CollectStats(ServerStats &out) {
+    for (std::size_t s = 0; s < shards_.size(); ++s) {
+        const ShardMetrics &shard = shards_[s]->metrics;
+        for (std::size_t i = 0; i < protocol::kCommandCount; ++i) {
+            out.commands[i] += shard.commands[i].Load();
+            shard.command_ns[i].AddTo(out.command_ns[i]);
+        }
+        for (int c = 0; c < kRateClassCount; ++c) {
+            out.rate_limited[c] += shard.rate_limited[c].Load();
+        }
+        out.shard_wakeups.push_back(shard.wakeups.Load());
+        out.shard_batch_events.push_back(metrics::HistogramSnapshot());
+        shard.batch_events.AddTo(out.shard_batch_events.back());
+        out.accepted += shard.accepted.Load();
+        out.read_deferrals += shard.read_deferrals.Load();
+        const net::ChunkPool &pool = shards_[s]->chunk_pool;
+        out.outbound_chunks_in_use += pool.in_use();
+        out.outbound_chunks_free += pool.free_count();
+        out.outbound_chunk_allocations += pool.allocations();
+    }
+    out.connections = clients_.Size();
+    out.channels = channels_.Size();
+    out.outbound_bytes = outbound_bytes_.load(std::memory_order_relaxed);
+    out.outbound_dropped_lines = outbound_dropped_lines_.load(std::memory_order_relaxed);
+    out.outbound_evictions = outbound_evictions_.load(std::memory_order_relaxed);
+    out.log_dropped_lines = logger_.dropped();
+    out.uptime_ms = NowMs() - start_ms_;
+}
+
+std::string PollServer::RenderMetricsText(const ServerStats &stats) const {
+    metrics::TextWriter out;
+    out.Family("irc_commands_total", "counter", "처리한 명령 수");
+    for (std::size_t i = 0; i < protocol::kCommandCount; ++i) {
+        if (stats.commands[i] != 0) {
+            const char *name = protocol::CommandName(static_cast<protocol::CommandId>(i));
+            out.Value("irc_commands_total", std::string("command=\"") + (*name != '\0' ? name : "UNKNOWN") + "\"",
+                      static_cast<double>(stats.commands[i]));
+        }
+    }
+    out.Family("irc_command_duration_seconds", "summary", "명령 핸들러 실행 시간");
+    for (std::size_t i = 0; i < protocol::kCommandCount; ++i) {
+        if (stats.commands[i] != 0) {
+            const char *name = protocol::CommandName(static_cast<protocol::CommandId>(i));
+            out.Summary("irc_command_duration_seconds",
+                        std::string("command=\"") + (*name != '\0' ? name : "UNKNOWN") + "\"", stats.command_ns[i],
+                        1e-9);
+        }
+    }
+    static const char *const kRateClassNames[kRateClassCount] = {"message", "join", "nick"};
+    out.Family("irc_rate_limited_total", "counter", "속도 제한(439)으로 거절한 명령 수");
+    for (int c = 0; c < kRateClassCount; ++c) {
+        out.Value("irc_rate_limited_total", std::string("class=\"") + kRateClassNames[c] + "\"",
+                  static_cast<double>(stats.rate_limited[c]));
+    }
+    out.Family("irc_poll_wakeups_total", "counter", "이벤트 대기에서 깨어난 횟수");
+    for (std::size_t i = 0; i < stats.shard_wakeups.size(); ++i) {
+        out.Value("irc_poll_wakeups_total", "shard=\"" + std::to_string(i) + "\"",
+                  static_cast<double>(stats.shard_wakeups[i]));
+    }
+    out.Family("irc_poll_batch_events", "summary", "대기 한 번에 받은 준비 이벤트 수");
+    for (std::size_t i = 0; i < stats.shard_batch_events.size(); ++i) {
+        out.Summary("irc_poll_batch_events", "shard=\"" + std::to_string(i) + "\"", stats.shard_batch_events[i], 1);
+    }
+    out.Family("irc_accepted_connections_total", "counter", "수락한 연결 수");
+    out.Value("irc_accepted_connections_total", "", static_cast<double>(stats.accepted));
+    out.Family("irc_read_deferrals_total", "counter", "읽기 예산을 다 써 다음 바퀴로 미룬 횟수");
+    out.Value("irc_read_deferrals_total", "", static_cast<double>(stats.read_deferrals));
+    out.Family("irc_outbound_dropped_lines_total", "counter", "low 워터마크를 넘어 버린 NOTICE 라인 수");
+    out.Value("irc_outbound_dropped_lines_total", "", static_cast<double>(stats.outbound_dropped_lines));
+    out.Family("irc_outbound_evictions_total", "counter", "송신 큐 초과로 끊은 연결 수");
+    out.Value("irc_outbound_evictions_total", "", static_cast<double>(stats.outbound_evictions));
+    out.Family("irc_outbound_chunk_allocations_total", "counter", "풀이 비어 새로 할당한 송신 큐 청크 수");
+    out.Value("irc_outbound_chunk_allocations_total", "", static_cast<double>(stats.outbound_chunk_allocations));
+    out.Family("irc_log_dropped_lines_total", "counter", "로그 링이 가득 차 버린 라인 수");
+    out.Value("irc_log_dropped_lines_total", "", static_cast<double>(stats.log_dropped_lines));
+    out.Family("irc_connections", "gauge", "현재 연결 수");
+    out.Value("irc_connections", "", static_cast<double>(stats.connections));
+    out.Family("irc_channels", "gauge", "현재 채널 수");
+    out.Value("irc_channels", "", static_cast<double>(stats.channels));
+    out.Family("irc_outbound_queued_bytes", "gauge", "모든 연결의 송신 큐 바이트 합");
+    out.Value("irc_outbound_queued_bytes", "", static_cast<double>(stats.outbound_bytes));
+    out.Family("irc_outbound_chunks", "gauge", "송신 큐 청크 수(in_use: 큐가 쥔 것, free: 풀에 남긴 것)");
+    out.Value("irc_outbound_chunks", "state=\"in_use\"", static_cast<double>(stats.outbound_chunks_in_use));
+    out.Value("irc_outbound_chunks", "state=\"free\"", static_cast<double>(stats.outbound_chunks_free));
+    out.Family("irc_uptime_seconds", "gauge", "서버 가동 시간");
+    out.Value("irc_uptime_seconds", "", static_cast<double>(stats.uptime_ms) / 1000.0);
+    return out.Text();
+}
+
 void PollServer::ApplyConfig(const config::Settings &settings) {
     config_ = settings;
+    // 서버명이 prefix에 들어가므로 캐시된 prefix를 모두 무효화한다. 0은 "아직 없음"으로 남겨 둔다.
+    if (++prefix_generation_ == 0) {
+        prefix_generation_ = 1;
+    }
     logger_.SetLevel(config_.log_level);
     logger_.SetOutput(config_.log_file);
-    max_outbound_queue_ = config_.outbound_lines > 0 ? config_.outbound_lines : 1;
+    // 한 라인은 항상 들어갈 수 있어야 하고, low는 high를 넘지 않는다.
+    outbound_high_bytes_ = std::max(config_.outbound_high_bytes, kMaxLineLength);
+    outbound_low_bytes_ = config_.outbound_low_bytes <= outbound_high_bytes_
+                              ? config_.outbound_low_bytes
+                              : outbound_high_bytes_ / 2;
+    outbound_total_cap_ = config_.outbound_total_bytes;
+    command_rate_[kRateMessage] = state::RatePolicy::PerWindow(config_.messages_per_5s, kRateWindowMs);
+    command_rate_[kRateJoin] = state::RatePolicy::PerWindow(config_.joins_per_5s, kRateWindowMs);
+    command_rate_[kRateNick] = state::RatePolicy::PerWindow(config_.nicks_per_5s, kRateWindowMs);
+    write_budget_bytes_.store(
+        config_.write_budget_bytes > 0 ? config_.write_budget_bytes : kMaxLineLength,
+        std::memory_order_relaxed);
+    read_budget_bytes_.store(config_.read_budget_bytes > 0 ? config_.read_budget_bytes : kMaxLineLength,
+                             std::memory_order_relaxed);
+    read_budget_lines_.store(config_.read_budget_lines > 0 ? config_.read_budget_lines : 1,
+                             std::memory_order_relaxed);
+    // 이미 리스닝 중인 소켓에 listen()을 다시 호출하면 backlog만 갱신된다.
+    for (std::size_t i = 0; i < shards_.size(); ++i) {
+        listen(shards_[i]->listen_fd, static_cast<int>(config_.listen_backlog));
+        shards_[i]->chunk_pool.SetMaxFree(PoolChunksPerShard(config_.outbound_pool_bytes, shards_.size()));
+    }
 }
 
 bool PollServer::ReloadConfig(std::string &error) {
@@ -1213,30 +2322,19 @@ bool PollServer::ReloadConfig(std::string &error) {
 }
 
 void PollServer::HandlePendingReload() {
-    if (!g_reload_requested) {
+    // 시그널을 받은 샤드 하나만 리로드한다.
+    if (g_reload_requested.exchange(0) == 0) {
         return;
     }
-    g_reload_requested = 0;
+    std::unique_lock<std::mutex> lock = AcquireState();
 
     std::string error;
     if (!ReloadConfig(error)) {
         logger_.Log(config::LogLevel::kWarn, "SIGHUP 리로드 실패: " + error);
         return;
     }
-    logger_.Log(config::LogLevel::kInfo,
-                "SIGHUP 리로드 성공: 서버명=" + config_.server_name + " 레벨=" +
-                    config::LogLevelToString(config_.log_level));
-}
-
-std::string PollServer::FormatPayloadForEcho(const std::string &payload) const {
-    if (payload.empty()) {
-        return "";
-    }
-    for (std::size_t i = 0; i < payload.size(); ++i) {
-        if (payload[i] == ' ') {
-            return " :" + payload;
-        }
-    }
-    return " " + payload;
+    IRC_LOG(logger_, config::LogLevel::kInfo,
+            "SIGHUP 리로드 성공: 서버명=" << config_.server_name
+                << " 레벨=" << config::LogLevelToString(config_.log_level));
 }
 
@@ -0,0 +1,71 @@
+/*
+ * 설명: RFC 1459 casemapping 정규화를 구현한다.
+ * 버전: v1.1.0
+ * 관련 문서: design/protocol/contract.md, design/server/v1.1.0-performance.md
+ * 테스트: tests/unit/nick_registry_test.cpp, tests/unit/channel_registry_test.cpp
+ */
+#include "state/casemap.hpp"
+
+namespace state {
+
+namespace {
+char FoldChar(char c) {
+    if (c >= 'A' && c <= 'Z') {
+        return static_cast<char>(c - 'A' + 'a');
+    }
+    if (c == '[') {
+        return '{';
+    }
+    if (c == ']') {
+        return '}';
+    }
+    if (c == '\\') {
+        return '|';
+    }
+    if (c == '~') {
+        return '^';
+    }
+    return c;
+}
+}  // namespace
+
+std::string FoldCase(std::string_view name) {
+    std::string folded;
+    FoldCaseInto(name, folded);
+    return folded;
+}
+
+void FoldCaseInto(std::string_view name, std::string &out) {
+    out.assign(name.data(), name.size());
+    for (std::size_t i = 0; i < out.size(); ++i) {
+        out[i] = FoldChar(out[i]);
+    }
+}
+
+bool MatchMask(std::string_view mask, std::string_view name) {
+    // 마지막 `*` 위치로만 되돌아가는 탐욕 매칭이라 역추적 폭발이 없다.
+    std::size_t m = 0;
+    std::size_t n = 0;
+    std::size_t star = std::string_view::npos;
+    std::size_t resume = 0;
+    while (n < name.size()) {
+        if (m < mask.size() && mask[m] == '*') {
+            star = m++;
+            resume = n;
+        } else if (m < mask.size() && (mask[m] == '?' || FoldChar(mask[m]) == FoldChar(name[n]))) {
+            ++m;
+            ++n;
+        } else if (star != std::string_view::npos) {
+            m = star + 1;
+            n = ++resume;
+        } else {
+            return false;
+        }
+    }
+    while (m < mask.size() && mask[m] == '*') {
+        ++m;
+    }
+    return m == mask.size();
+}
+
+}  // namespace state
@@ -0,0 +1,83 @@
+/*
+ * 설명: 채널 멤버 정렬 배열의 삽입/삭제/플래그 갱신을 구현한다.
+ * 버전: v1.1.0
+ * 관련 문서: design/server/v1.1.0-performance.md
+ * 테스트: tests/unit/channel_registry_test.cpp
+ */
+#include "state/channel_registry.hpp"
+
+#include <algorithm>
+
+namespace state {
+
+namespace {
+bool FdLess(const ChannelMember &member, int fd) { return member.fd < fd; }
+}  // namespace
+
+std::vector<ChannelMember>::iterator MemberList::Locate(int fd) {
+    return std::lower_bound(members_.begin(), members_.end(), fd, FdLess);
+}
+
+std::vector<ChannelMember>::const_iterator MemberList::Locate(int fd) const {
+    return std::lower_bound(members_.begin(), members_.end(), fd, FdLess);
+}
+
+std::size_t MemberList::LowerBound(int fd) const {
+    return static_cast<std::size_t>(Locate(fd) - members_.begin());
+}
+
+bool MemberList::Insert(int fd, unsigned flags) {
+    std::vector<ChannelMember>::iterator it = Locate(fd);
+    if (it != members_.end() && it->fd == fd) {
+        return false;
+    }
+    ChannelMember member = {fd, flags};
+    members_.insert(it, member);
+    if (flags & kMemberOperator) {
+        ++operator_count_;
+    }
+    return true;
+}
+
+bool MemberList::Erase(int fd) {
+    std::vector<ChannelMember>::iterator it = Locate(fd);
+    if (it == members_.end() || it->fd != fd) {
+        return false;
+    }
+    if (it->flags & kMemberOperator) {
+        --operator_count_;
+    }
+    members_.erase(it);
+    return true;
+}
+
+bool MemberList::Contains(int fd) const {
+    std::vector<ChannelMember>::const_iterator it = Locate(fd);
+    return it != members_.end() && it->fd == fd;
+}
+
+bool MemberList::HasFlag(int fd, unsigned flag) const {
+    std::vector<ChannelMember>::const_iterator it = Locate(fd);
+    return it != members_.end() && it->fd == fd && (it->flags & flag) != 0;
+}
+
+void MemberList::SetFlag(int fd, unsigned flag, bool on) {
+    std::vector<ChannelMember>::iterator it = Locate(fd);
+    if (it == members_.end() || it->fd != fd) {
+        return;
+    }
+    bool was_operator = (it->flags & kMemberOperator) != 0;
+    if (on) {
+        it->flags |= flag;
+    } else {
+        it->flags &= ~flag;
+    }
+    bool is_operator = (it->flags & kMemberOperator) != 0;
+    if (!was_operator && is_operator) {
+        ++operator_count_;
+    } else if (was_operator && !is_operator) {
+        --operator_count_;
+    }
+}
+
+}  // namespace state
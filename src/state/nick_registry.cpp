@@ -0,0 +1,36 @@
+/*
+ * 설명: 닉네임 → fd 인덱스의 등록/해제/조회를 구현한다.
+ * 버전: v1.1.0
+ * 관련 문서: design/protocol/contract.md, design/server/v1.1.0-performance.md
+ * 테스트: tests/unit/nick_registry_test.cpp
+ */
+#include "state/nick_registry.hpp"
+
+namespace state {
+
+bool NickRegistry::Claim(std::string_view nick, int fd) {
+    std::pair<std::unordered_map<std::string, int>::iterator, bool> inserted =
+        fd_by_nick_.emplace(FoldCase(nick), fd);
+    return inserted.second || inserted.first->second == fd;
+}
+
+void NickRegistry::Release(std::string_view nick, int fd) {
+    FoldCaseInto(nick, lookup_key_);
+    std::unordered_map<std::string, int>::iterator it = fd_by_nick_.find(lookup_key_);
+    if (it != fd_by_nick_.end() && it->second == fd) {
+        fd_by_nick_.erase(it);
+    }
+}
+
+int NickRegistry::Find(std::string_view nick) const {
+    FoldCaseInto(nick, lookup_key_);
+    std::unordered_map<std::string, int>::const_iterator it = fd_by_nick_.find(lookup_key_);
+    return it == fd_by_nick_.end() ? -1 : it->second;
+}
+
+bool NickRegistry::InUse(std::string_view nick, int requester_fd) const {
+    int owner = Find(nick);
+    return owner >= 0 && owner != requester_fd;
+}
+
+}  // namespace state
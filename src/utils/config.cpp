@@ -1,7 +1,7 @@
 /*
  * 설명: INI 파일을 파싱해 서버 설정을 생성하고 검증한다.
- * 버전: v0.9.0
- * 관련 문서: design/protocol/contract.md, design/server/v0.8.0-config-logging.md, design/server/v0.9.0-defensive.md
+ * 버전: v1.1.0
+ * 관련 문서: design/protocol/contract.md, design/server/v0.8.0-config-logging.md, design/server/v0.9.0-defensive.md, design/server/v1.1.0-performance.md
  * 테스트: tests/unit/config_parser_test.cpp
  */
 #include "utils/config.hpp"
@@ -14,6 +14,9 @@
 #include <stdexcept>
 
 namespace {
+// limits.outbound_lines 환산에 쓰는 라인 최대 길이(CRLF 포함).
+const std::size_t kOutboundLineBytes = 512;
+
 bool StartsWith(const std::string &text, char c) { return !text.empty() && text[0] == c; }
 
 std::string Trim(const std::string &text) {
@@ -56,6 +59,32 @@ bool ParseLogLevel(const std::string &raw, config::LogLevel &out) {
     return false;
 }
 
+bool ParseIoBackend(const std::string &raw, config::IoBackend &out) {
+    const std::string lowered = ToLower(raw);
+    if (lowered == "poll") {
+        out = config::IoBackend::kPoll;
+        return true;
+    }
+    if (lowered == "epoll") {
+        out = config::IoBackend::kEpoll;
+        return true;
+    }
+    return false;
+}
+
+bool ParseBool(const std::string &raw, bool &out) {
+    const std::string lowered = ToLower(raw);
+    if (lowered == "true" || lowered == "yes" || lowered == "on" || lowered == "1") {
+        out = true;
+        return true;
+    }
+    if (lowered == "false" || lowered == "no" || lowered == "off" || lowered == "0") {
+        out = false;
+        return true;
+    }
+    return false;
+}
+
 bool ParsePositiveNumber(const std::string &raw, std::size_t &out) {
     if (raw.empty()) {
         return false;
@@ -73,7 +102,14 @@ bool ParsePositiveNumber(const std::string &raw, std::size_t &out) {
 namespace config {
 
 Settings::Settings()
-    : server_name("modern-irc"), log_level(LogLevel::kInfo), messages_per_5s(0), outbound_lines(16) {}
+    : server_name("modern-irc"), log_level(LogLevel::kInfo), messages_per_5s(0), joins_per_5s(0), nicks_per_5s(0),
+      outbound_high_bytes(256 * 1024), outbound_low_bytes(64 * 1024),
+      outbound_total_bytes(256 * 1024 * 1024), outbound_pool_bytes(16 * 1024 * 1024),
+      io_backend(IoBackend::kEpoll), write_budget_bytes(64 * 1024), read_buffer_bytes(4096),
+      read_budget_bytes(16 * 1024), read_budget_lines(64), io_threads(1),
+      socket_sndbuf(0), socket_rcvbuf(0), tcp_nodelay(true), tcp_notsent_lowat(0), tcp_keepalive(true),
+      tcp_keepalive_idle(0), listen_backlog(511), registration_timeout(60), ping_interval(120),
+      pong_timeout(60), send_stall_timeout(60) {}
 
 bool LoadFromFile(const std::string &path, Settings &out, std::string &error) {
     Settings defaults;
@@ -136,6 +172,10 @@ bool LoadFromFile(const std::string &path, Settings &out, std::string &error) {
                 return false;
             }
             out.server_name = value;
+        } else if (section == "server" && key == "oper_password") {
+            out.oper_password = value;
+        } else if (section == "metrics" && key == "socket") {
+            out.metrics_socket = value;
         } else if (section == "logging" && key == "level") {
             LogLevel parsed;
             if (!ParseLogLevel(value, parsed)) {
@@ -147,24 +187,134 @@ bool LoadFromFile(const std::string &path, Settings &out, std::string &error) {
             out.log_level = parsed;
         } else if (section == "logging" && key == "file") {
             out.log_file = value;
-        } else if (section == "limits" && key == "messages_per_5s") {
+        } else if (section == "limits" &&
+                   (key == "messages_per_5s" || key == "joins_per_5s" || key == "nicks_per_5s")) {
             std::size_t number = 0;
             if (!ParsePositiveNumber(value, number)) {
                 std::ostringstream oss;
-                oss << "limits.messages_per_5s 오류 (" << line_no << ")";
+                oss << "limits." << key << " 오류 (" << line_no << ")";
                 error = oss.str();
                 return false;
             }
-            out.messages_per_5s = number;
-        } else if (section == "limits" && key == "outbound_lines") {
+            if (key == "messages_per_5s") {
+                out.messages_per_5s = number;
+            } else if (key == "joins_per_5s") {
+                out.joins_per_5s = number;
+            } else {
+                out.nicks_per_5s = number;
+            }
+        } else if (section == "limits" &&
+                   (key == "outbound_high_bytes" || key == "outbound_low_bytes" ||
+                    key == "outbound_total_bytes" || key == "outbound_pool_bytes" || key == "outbound_lines")) {
             std::size_t number = 0;
             if (!ParsePositiveNumber(value, number)) {
                 std::ostringstream oss;
-                oss << "limits.outbound_lines 오류 (" << line_no << ")";
+                oss << "limits." << key << " 오류 (" << line_no << ")";
+                error = oss.str();
+                return false;
+            }
+            if (key == "outbound_high_bytes") {
+                out.outbound_high_bytes = number;
+            } else if (key == "outbound_low_bytes") {
+                out.outbound_low_bytes = number;
+            } else if (key == "outbound_total_bytes") {
+                out.outbound_total_bytes = number;
+            } else if (key == "outbound_pool_bytes") {
+                out.outbound_pool_bytes = number;
+            } else if (number > 0) {
+                // 이전 라인 수 상한은 최대 길이 라인 기준 바이트로 환산한다.
+                out.outbound_high_bytes = number * kOutboundLineBytes;
+            }
+        } else if (section == "io" && key == "backend") {
+            IoBackend parsed;
+            if (!ParseIoBackend(value, parsed)) {
+                std::ostringstream oss;
+                oss << "io.backend 오류 (" << line_no << ")";
                 error = oss.str();
                 return false;
             }
-            out.outbound_lines = number;
+            out.io_backend = parsed;
+        } else if (section == "io" &&
+                   (key == "write_budget_bytes" || key == "read_buffer_bytes" || key == "read_budget_bytes" ||
+                    key == "read_budget_lines")) {
+            std::size_t number = 0;
+            if (!ParsePositiveNumber(value, number)) {
+                std::ostringstream oss;
+                oss << "io." << key << " 오류 (" << line_no << ")";
+                error = oss.str();
+                return false;
+            }
+            if (key == "write_budget_bytes") {
+                out.write_budget_bytes = number;
+            } else if (key == "read_buffer_bytes") {
+                out.read_buffer_bytes = number;
+            } else if (key == "read_budget_bytes") {
+                out.read_budget_bytes = number;
+            } else {
+                out.read_budget_lines = number;
+            }
+        } else if (section == "io" && key == "threads") {
+            std::size_t number = 0;
+            if (!ParsePositiveNumber(value, number)) {
+                std::ostringstream oss;
+                oss << "io.threads 오류 (" << line_no << ")";
+                error = oss.str();
+                return false;
+            }
+            out.io_threads = number;
+        } else if (section == "socket" &&
+                   (key == "sndbuf" || key == "rcvbuf" || key == "notsent_lowat" ||
+                    key == "keepalive_idle" || key == "backlog")) {
+            std::size_t number = 0;
+            if (!ParsePositiveNumber(value, number)) {
+                std::ostringstream oss;
+                oss << "socket." << key << " 오류 (" << line_no << ")";
+                error = oss.str();
+                return false;
+            }
+            if (key == "sndbuf") {
+                out.socket_sndbuf = number;
+            } else if (key == "rcvbuf") {
+                out.socket_rcvbuf = number;
+            } else if (key == "notsent_lowat") {
+                out.tcp_notsent_lowat = number;
+            } else if (key == "keepalive_idle") {
+                out.tcp_keepalive_idle = number;
+            } else {
+                out.listen_backlog = number;
+            }
+        } else if (section == "socket" && (key == "tcp_nodelay" || key == "keepalive")) {
+            bool flag = false;
+            if (!ParseBool(value, flag)) {
+                std::ostringstream oss;
+                oss << "socket." << key << " 오류 (" << line_no << ")";
+                error = oss.str();
+                return false;
+            }
+            if (key == "tcp_nodelay") {
+                out.tcp_nodelay = flag;
+            } else {
+                out.tcp_keepalive = flag;
+            }
+        } else if (section == "timeouts" &&
+                   (key == "registration" || key == "ping_interval" || key == "pong" ||
+                    key == "send_stall")) {
+            std::size_t number = 0;
+            if (!ParsePositiveNumber(value, number)) {
+                std::ostringstream oss;
+                oss << "timeouts." << key << " 오류 (" << line_no << ")";
+                error = oss.str();
+                return false;
+            }
+            if (key == "registration") {
+                out.registration_timeout = number;
+            } else if (key == "ping_interval") {
+                out.ping_interval = number;
+            } else if (key == "pong") {
+                out.pong_timeout = number;
+            } else {
+                out.send_stall_timeout = number;
+            }
         } else {
             std::ostringstream oss;
             oss << "알 수 없는 섹션/키 (" << line_no << ")";
@@ -1,19 +1,51 @@
 /*
- * 설명: 로그 레벨 필터링과 파일/표준 오류 출력 제어를 담당한다.
- * 버전: v0.8.0
- * 관련 문서: design/server/v0.8.0-config-logging.md
- * 테스트: tests/e2e/test_rehash.py
+ * 설명: 로그 레벨 필터링, 스레드별 링에 라인 넣기, 백그라운드 스레드의 묶음 쓰기와 파일/표준 오류 출력 제어를 담당한다.
+ * 버전: v1.1.0
+ * 관련 문서: design/server/v0.8.0-config-logging.md, design/server/v1.1.0-performance.md
+ * 테스트: tests/unit/logger_test.cpp, tests/e2e/test_rehash.py
  */
 #include "utils/logger.hpp"
 
+#include <chrono>
 #include <iostream>
-#include <sstream>
+#include <utility>
 
-Logger::Logger() : level_(config::LogLevel::kInfo) {}
+namespace {
+std::atomic<std::uint64_t> g_next_logger_id(1);
 
-void Logger::SetLevel(config::LogLevel level) { level_ = level; }
+// 스레드마다 (로거 ID, 링) 쌍을 기억한다. ID는 다시 쓰지 않으므로 사라진 로거의 항목과 섞이지 않는다.
+thread_local std::vector<std::pair<std::uint64_t, void *> > t_rings;
+}  // namespace
+
+Logger::Logger(std::size_t ring_capacity)
+    : id_(g_next_logger_id.fetch_add(1, std::memory_order_relaxed)),
+      ring_capacity_(ring_capacity),
+      level_(static_cast<int>(config::LogLevel::kInfo)),
+      dropped_(0),
+      wake_requested_(false),
+      pending_(false),
+      writer_wakeups_(0),
+      stopping_(false),
+      flush_requested_(0),
+      flush_completed_(0) {
+    writer_ = std::thread([this]() { RunWriter(); });
+}
+
+Logger::~Logger() {
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_one();
+    writer_.join();
+}
+
+void Logger::SetLevel(config::LogLevel level) {
+    level_.store(static_cast<int>(level), std::memory_order_relaxed);
+}
 
 void Logger::SetOutput(const std::string &path) {
+    std::lock_guard<std::mutex> lock(output_mutex_);
     path_ = path;
     if (file_.is_open()) {
         file_.close();
@@ -25,24 +57,115 @@ void Logger::SetOutput(const std::string &path) {
 }
 
 void Logger::Log(config::LogLevel level, const std::string &message) {
-    if (!IsEnabled(level)) {
+    if (!Enabled(level)) {
+        return;
+    }
+    const std::string name = config::LogLevelToString(level);
+    std::string line;
+    line.reserve(name.size() + 3 + message.size());
+    line += '[';
+    line += name;
+    line += "] ";
+    line += message;
+
+    Ring &ring = LocalRing();
+    if (!ring.TryPush(line)) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
         return;
     }
-    std::ostringstream oss;
-    oss << "[" << config::LogLevelToString(level) << "] " << message;
-    WriteLine(oss.str());
+    // 비어 있던 로거에 처음 넣은 생산자만 잠금을 잡고 깨운다. 잠든 백그라운드 스레드는 시간 제한 없이
+    // 기다리므로 이 깨우기를 놓치면 안 된다. 그 뒤로는 주기 끝에 모아 쓰고, 링이 절반 넘게 차면 주기를 앞당긴다.
+    if (!pending_.exchange(true, std::memory_order_acq_rel)) {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        wake_.notify_one();
+    } else if (ring.Size() >= ring.Capacity() / 2 && !wake_requested_.exchange(true, std::memory_order_relaxed)) {
+        wake_.notify_one();
+    }
 }
 
-bool Logger::IsEnabled(config::LogLevel level) const {
-    return static_cast<int>(level) >= static_cast<int>(level_);
+void Logger::Flush() {
+    std::unique_lock<std::mutex> lock(wake_mutex_);
+    const std::uint64_t ticket = ++flush_requested_;
+    wake_.notify_one();
+    flushed_.wait(lock, [this, ticket]() { return flush_completed_ >= ticket; });
 }
 
-void Logger::WriteLine(const std::string &line) {
+Logger::Ring &Logger::LocalRing() {
+    for (std::size_t i = 0; i < t_rings.size(); ++i) {
+        if (t_rings[i].first == id_) {
+            return *static_cast<Ring *>(t_rings[i].second);
+        }
+    }
+    std::lock_guard<std::mutex> lock(rings_mutex_);
+    rings_.push_back(std::unique_ptr<Ring>(new Ring(ring_capacity_)));
+    t_rings.push_back(std::make_pair(id_, static_cast<void *>(rings_.back().get())));
+    return *rings_.back();
+}
+
+void Logger::RunWriter() {
+    std::string batch;
+    std::uint64_t reported_drops = 0;
+    while (true) {
+        bool stopping = false;
+        std::uint64_t request = 0;
+        {
+            std::unique_lock<std::mutex> lock(wake_mutex_);
+            wake_.wait(lock, [this]() {
+                return stopping_ || flush_requested_ != flush_completed_ ||
+                       pending_.load(std::memory_order_relaxed);
+            });
+            // 라인이 생겼으면 주기 끝까지 더 모아서 한 번에 쓴다.
+            wake_.wait_for(lock, std::chrono::milliseconds(kFlushIntervalMs), [this]() {
+                return stopping_ || flush_requested_ != flush_completed_ ||
+                       wake_requested_.load(std::memory_order_relaxed);
+            });
+            wake_requested_.store(false, std::memory_order_relaxed);
+            stopping = stopping_;
+            request = flush_requested_;
+        }
+        // 비우기 전에 내려야 그 사이 넣은 생산자가 다음 주기를 위해 다시 깨운다.
+        // acq_rel 교환이 그 생산자들의 TryPush를 보이게 한다.
+        pending_.exchange(false, std::memory_order_acq_rel);
+        writer_wakeups_.fetch_add(1, std::memory_order_relaxed);
+        WriteBatch(batch, reported_drops);
+        {
+            std::lock_guard<std::mutex> lock(wake_mutex_);
+            flush_completed_ = request;
+        }
+        flushed_.notify_all();
+        if (stopping) {
+            return;
+        }
+    }
+}
+
+// 모든 링을 비워 한 번에 쓴다. 한 스레드의 라인 순서는 유지되고, 스레드 사이 순서는 보장하지 않는다.
+void Logger::WriteBatch(std::string &batch, std::uint64_t &reported_drops) {
+    batch.clear();
+    {
+        std::lock_guard<std::mutex> lock(rings_mutex_);
+        for (std::size_t i = 0; i < rings_.size(); ++i) {
+            rings_[i]->Drain([&batch](std::string &line) {
+                batch += line;
+                batch += '\n';
+            });
+        }
+    }
+    const std::uint64_t drops = dropped_.load(std::memory_order_relaxed);
+    if (drops != reported_drops) {
+        batch += "[warn] 로그 링 가득 참: " + std::to_string(drops - reported_drops) + "줄 버림\n";
+        reported_drops = drops;
+    }
+    if (batch.empty()) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(output_mutex_);
     if (file_.is_open()) {
-        file_ << line << '\n';
+        file_.write(batch.data(), static_cast<std::streamsize>(batch.size()));
         file_.flush();
         return;
     }
-    std::cerr << line << '\n';
+    std::cerr.write(batch.data(), static_cast<std::streamsize>(batch.size()));
+    std::cerr.flush();
 }
-
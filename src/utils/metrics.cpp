@@ -0,0 +1,115 @@
+/*
+ * 설명: 로그-선형 히스토그램의 칸 계산, 사본 합치기와 백분위수, Prometheus 텍스트 출력을 구현한다.
+ * 버전: v1.1.0
+ * 관련 문서: design/server/v1.1.0-performance.md
+ * 테스트: tests/unit/metrics_test.cpp
+ */
+#include "utils/metrics.hpp"
+
+#include <cstdio>
+
+namespace metrics {
+
+std::size_t BucketIndex(std::uint64_t value) {
+    if (value < kSubBuckets) {
+        return static_cast<std::size_t>(value);
+    }
+    // value >> shift는 [16, 32) 안에 든다.
+    const int shift = 63 - __builtin_clzll(value) - 4;
+    const std::size_t index =
+        kSubBuckets + static_cast<std::size_t>(shift) * kSubBuckets + static_cast<std::size_t>((value >> shift) - kSubBuckets);
+    return index < kBucketCount ? index : kBucketCount - 1;
+}
+
+std::uint64_t BucketMiddle(std::size_t index) {
+    if (index < kSubBuckets) {
+        return index;
+    }
+    const std::size_t shift = (index - kSubBuckets) / kSubBuckets;
+    const std::uint64_t lower = static_cast<std::uint64_t>(kSubBuckets + (index - kSubBuckets) % kSubBuckets) << shift;
+    return lower + ((std::uint64_t(1) << shift) >> 1);
+}
+
+HistogramSnapshot::HistogramSnapshot() : buckets_(), count_(0), sum_(0), max_(0) {}
+
+void HistogramSnapshot::Record(std::uint64_t value) {
+    ++buckets_[BucketIndex(value)];
+    AddTotals(1, value, value);
+}
+
+void HistogramSnapshot::AddTotals(std::uint64_t count, std::uint64_t sum, std::uint64_t max) {
+    count_ += count;
+    sum_ += sum;
+    if (max > max_) {
+        max_ = max;
+    }
+}
+
+std::uint64_t HistogramSnapshot::Percentile(double p) const {
+    std::uint64_t total = 0;
+    for (std::size_t i = 0; i < kBucketCount; ++i) {
+        total += buckets_[i];
+    }
+    if (total == 0) {
+        return 0;
+    }
+    std::uint64_t rank = static_cast<std::uint64_t>(p * static_cast<double>(total) + 0.5);
+    if (rank == 0) {
+        rank = 1;
+    }
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < kBucketCount; ++i) {
+        seen += buckets_[i];
+        if (seen >= rank) {
+            const std::uint64_t middle = BucketMiddle(i);
+            return middle < max_ ? middle : max_;
+        }
+    }
+    return max_;
+}
+
+Histogram::Histogram() : max_(0) {
+    for (std::size_t i = 0; i < kBucketCount; ++i) {
+        buckets_[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+void Histogram::AddTo(HistogramSnapshot &out) const {
+    for (std::size_t i = 0; i < kBucketCount; ++i) {
+        const std::uint64_t count = buckets_[i].load(std::memory_order_relaxed);
+        if (count != 0) {
+            out.Add(i, count);
+        }
+    }
+    out.AddTotals(count_.Load(), sum_.Load(), max_.load(std::memory_order_relaxed));
+}
+
+void TextWriter::Family(std::string_view name, std::string_view type, std::string_view help) {
+    text_.append("# HELP ").append(name).append(" ").append(help).append("\n");
+    text_.append("# TYPE ").append(name).append(" ").append(type).append("\n");
+}
+
+void TextWriter::Value(std::string_view name, std::string_view labels, double value) {
+    char number[32];
+    std::snprintf(number, sizeof(number), "%.15g", value);
+    text_.append(name);
+    if (!labels.empty()) {
+        text_.append("{").append(labels).append("}");
+    }
+    text_.append(" ").append(number).append("\n");
+}
+
+void TextWriter::Summary(std::string_view name, std::string_view labels, const HistogramSnapshot &histogram,
+                         double scale) {
+    static const double kQuantiles[] = {0.5, 0.99, 0.999};
+    static const char *const kQuantileLabels[] = {"0.5", "0.99", "0.999"};
+    const std::string prefix = labels.empty() ? std::string() : std::string(labels) + ",";
+    for (std::size_t i = 0; i < sizeof(kQuantiles) / sizeof(kQuantiles[0]); ++i) {
+        Value(name, prefix + "quantile=\"" + kQuantileLabels[i] + "\"",
+              static_cast<double>(histogram.Percentile(kQuantiles[i])) * scale);
+    }
+    Value(std::string(name) + "_sum", labels, static_cast<double>(histogram.sum()) * scale);
+    Value(std::string(name) + "_count", labels, static_cast<double>(histogram.count()));
+}
+
+}  // namespace metrics
@@ -0,0 +1,57 @@
+/*
+ * 설명: 벤치마크 결과 표/JSON 출력을 구현한다.
+ * 버전: v1.1.0
+ * 관련 문서: design/server/v1.1.0-performance.md
+ * 테스트: 이 파일 자체 (make bench)
+ */
+#include "bench_harness.hpp"
+
+#include <cstdio>
+
+namespace bench {
+
+Report::Report(const std::string &suite) : suite_(suite) {
+    std::printf("%s\n", suite_.c_str());
+}
+
+void Report::Add(const Result &result) {
+    results_.push_back(result);
+    std::printf("  %-28s %10.1f ns/op %8.2f allocs/op %8.0f B/op %14.0f items/s\n", result.name.c_str(),
+                result.ns_per_op, result.allocs_per_op, result.alloc_bytes_per_op,
+                result.ops_per_s * result.items_per_op);
+    std::fflush(stdout);
+}
+
+std::string Report::Json() const {
+    std::string out = "{\"suite\":\"" + suite_ + "\",\"results\":[";
+    char row[512];
+    for (std::size_t i = 0; i < results_.size(); ++i) {
+        const Result &r = results_[i];
+        std::snprintf(row, sizeof(row),
+                      "%s{\"name\":\"%s\",\"iterations\":%llu,\"ns_per_op\":%.3f,\"allocs_per_op\":%.3f,"
+                      "\"alloc_bytes_per_op\":%.1f,\"items_per_op\":%.1f,\"ops_per_s\":%.1f,"
+                      "\"items_per_s\":%.1f}",
+                      i == 0 ? "" : ",", r.name.c_str(), static_cast<unsigned long long>(r.iterations),
+                      r.ns_per_op, r.allocs_per_op, r.alloc_bytes_per_op, r.items_per_op, r.ops_per_s,
+                      r.ops_per_s * r.items_per_op);
+        out += row;
+    }
+    out += "]}\n";
+    return out;
+}
+
+bool Report::WriteJson(const std::string &path) const {
+    const std::string text = Json();
+    if (path == "-") {
+        std::fputs(text.c_str(), stdout);
+        return true;
+    }
+    std::FILE *file = std::fopen(path.c_str(), "w");
+    if (file == nullptr) {
+        return false;
+    }
+    const bool ok = std::fwrite(text.data(), 1, text.size(), file) == text.size();
+    return std::fclose(file) == 0 && ok;
+}
+
+}  // namespace bench
@@ -0,0 +1,78 @@
+/*
+ * 설명: 마이크로벤치마크 공용 도구. tests/support/alloc_counter로 스레드별 할당 횟수/바이트를 세고, 반복 측정 결과를 표와 JSON으로 낸다.
+ * 버전: v1.1.0
+ * 관련 문서: design/server/v1.1.0-performance.md
+ * 테스트: 이 파일 자체 (make bench)
+ */
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../support/alloc_counter.hpp"
+
+namespace bench {
+
+using support::AllocationStats;
+using support::ThreadAllocations;
+
+// 컴파일러가 결과를 쓰지 않는다고 보고 계산을 지우지 못하게 한다.
+template <typename T>
+inline void DoNotOptimize(const T &value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+struct Result {
+    std::string name;
+    std::uint64_t iterations;
+    double ns_per_op;
+    double allocs_per_op;
+    double alloc_bytes_per_op;
+    // 연산 한 번이 처리하는 항목 수(라인, 전달 수 등). 처리량 = ops/s × items_per_op.
+    double items_per_op;
+    double ops_per_s;
+};
+
+// run(n)은 연산 n번을 한다. n/10번으로 한 번 예열한 뒤 iterations번을 잰다.
+template <typename F>
+Result Measure(const std::string &name, std::uint64_t iterations, double items_per_op, F run) {
+    run(iterations / 10 > 0 ? iterations / 10 : 1);
+
+    const AllocationStats before = ThreadAllocations();
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    run(iterations);
+    const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    const AllocationStats after = ThreadAllocations();
+
+    const double ns = std::chrono::duration<double, std::nano>(end - start).count();
+    Result result;
+    result.name = name;
+    result.iterations = iterations;
+    result.ns_per_op = ns / static_cast<double>(iterations);
+    result.allocs_per_op =
+        static_cast<double>(after.count - before.count) / static_cast<double>(iterations);
+    result.alloc_bytes_per_op =
+        static_cast<double>(after.bytes - before.bytes) / static_cast<double>(iterations);
+    result.items_per_op = items_per_op;
+    result.ops_per_s = ns > 0 ? static_cast<double>(iterations) * 1e9 / ns : 0;
+    return result;
+}
+
+// 결과를 모아 한 줄씩 표로 찍고, 끝에 JSON 문서 하나로 낸다.
+class Report {
+   public:
+    explicit Report(const std::string &suite);
+
+    void Add(const Result &result);
+    std::string Json() const;
+    // path가 "-"이면 표준 출력에 쓴다.
+    bool WriteJson(const std::string &path) const;
+
+   private:
+    std::string suite_;
+    std::vector<Result> results_;
+};
+
+}  // namespace bench
@@ -0,0 +1,199 @@
+/*
+ * 설명: 채널 멤버 1k/10k에 한 줄을 팬아웃할 때, 매번 멤버 집합을 복사하던 이전 방식과 멤버 배열을 그대로 훑는 방식의 비용을 비교한다.
+ *       수신자 큐에 공유 버퍼 참조를 넣던 이전 송신 큐, 라인 바이트를 수신자마다 풀 청크에 복사하는 작은 채널 경로,
+ *       게시 청크에 한 번 복사하고 구간만 붙이는 큰 채널 경로의 비용도 비교한다.
+ * 버전: v1.1.0
+ * 관련 문서: design/server/v1.1.0-performance.md
+ * 테스트: 이 파일 자체 (make bench)
+ */
+#include <chrono>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "net/line_builder.hpp"
+#include "net/outbound_queue.hpp"
+#include "net/shared_buffer.hpp"
+#include "state/channel_registry.hpp"
+
+namespace {
+const int kMessages = 200;
+const int kMemberCounts[] = {1000, 10000};
+const int kPayloadMemberCounts[] = {16, 256, 1000, 10000};
+// 짧은 채팅 라인과 정책 최대 길이 라인.
+const std::size_t kLineSizes[] = {48, 512};
+// 기본 [limits] outbound_pool_bytes(16MiB)를 샤드 하나가 모두 쓸 때의 프리 리스트 상한.
+const std::size_t kPoolChunks = 16 * 1024 * 1024 / net::kOutboundChunkBytes;
+
+// 이전 MakeLineBuffer: CRLF를 붙인 라인을 한 번 만들어 모든 수신자가 참조를 나눠 가진다.
+net::SharedBuffer MakeLineBuffer(const std::string &line) {
+    std::string framed;
+    framed.reserve(line.size() + 2);
+    framed.append(line);
+    framed.append("\r\n");
+    return std::make_shared<const std::string>(std::move(framed));
+}
+
+// 이전 BroadcastToChannel: std::set<int> recipients = members; 후 순회.
+std::size_t CopyAndFanOut(const std::set<int> &members,
+                          std::vector<std::deque<net::SharedBuffer> > &queues,
+                          const net::SharedBuffer &buffer, int exclude_fd) {
+    std::set<int> recipients = members;
+    std::size_t sent = 0;
+    for (std::set<int>::const_iterator it = recipients.begin(); it != recipients.end(); ++it) {
+        if (*it == exclude_fd) {
+            continue;
+        }
+        queues[*it].push_back(buffer);
+        ++sent;
+    }
+    return sent;
+}
+
+std::size_t FanOutInPlace(const state::MemberList &members,
+                          std::vector<std::deque<net::SharedBuffer> > &queues,
+                          const net::SharedBuffer &buffer, int exclude_fd) {
+    std::size_t sent = 0;
+    for (std::size_t i = 0; i < members.size(); ++i) {
+        int fd = members[i].fd;
+        if (fd == exclude_fd) {
+            continue;
+        }
+        queues[fd].push_back(buffer);
+        ++sent;
+    }
+    return sent;
+}
+
+// 송신 경로가 큐를 비우는 것을 흉내 내어 큐가 커지지 않게 한다.
+void Drain(std::vector<std::deque<net::SharedBuffer> > &queues) {
+    for (std::size_t i = 0; i < queues.size(); ++i) {
+        queues[i].clear();
+    }
+}
+
+// 이전 송신 큐(user-003): 브로드캐스트마다 버퍼를 한 번 만들고 수신자 큐에는 참조만 넣는다. 보낸 뒤 참조를 놓는다.
+double SharedPayload(const state::MemberList &members, std::vector<std::deque<net::SharedBuffer> > &queues,
+                     const std::string &line) {
+    double ns = 0;
+    for (int i = 0; i < kMessages; ++i) {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        const net::SharedBuffer buffer = MakeLineBuffer(line);
+        FanOutInPlace(members, queues, buffer, i % static_cast<int>(members.size()));
+        Drain(queues);
+        std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+        ns += std::chrono::duration<double, std::nano>(end - start).count();
+    }
+    return ns / kMessages;
+}
+
+// 작은 채널 경로: 수신자마다 라인 바이트를 꼬리 청크에 복사한다. shared면 큰 채널 경로처럼 게시 청크에 한 번만 복사한다.
+// 보낸 뒤 다 비운 구간과 청크는 풀로 돌아간다.
+double ChunkFanOut(const state::MemberList &members, std::vector<net::OutboundQueue> &queues,
+                   net::ChunkPool &pool, const std::string &line, bool shared) {
+    net::LineBuilder framed;
+    framed.Append(line);
+    const std::string_view bytes = framed.Finish();
+    double ns = 0;
+    for (int i = 0; i < kMessages; ++i) {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        const int exclude_fd = i % static_cast<int>(members.size());
+        if (shared) {
+            const net::OutboundSlice slice = pool.Publish(bytes);
+            for (std::size_t m = 0; m < members.size(); ++m) {
+                if (members[m].fd != exclude_fd) {
+                    queues[members[m].fd].AppendShared(pool, slice);
+                }
+            }
+        } else {
+            for (std::size_t m = 0; m < members.size(); ++m) {
+                if (members[m].fd != exclude_fd) {
+                    queues[members[m].fd].Append(pool, bytes);
+                }
+            }
+        }
+        for (std::size_t q = 0; q < queues.size(); ++q) {
+            queues[q].Consume(queues[q].size());
+        }
+        std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+        ns += std::chrono::duration<double, std::nano>(end - start).count();
+    }
+    return ns / kMessages;
+}
+
+void MeasurePayload(int member_count, std::size_t line_size) {
+    state::MemberList flat;
+    for (int fd = 0; fd < member_count; ++fd) {
+        flat.Insert(fd, 0);
+    }
+    const std::string line = ":alice!alice@server PRIVMSG #bench :" + std::string(line_size - 38, 'x');
+    std::vector<std::deque<net::SharedBuffer> > shared_queues(member_count);
+    net::ChunkPool pool(kPoolChunks);
+    std::vector<net::OutboundQueue> chunk_queues(member_count);
+    // 한 번씩 돌려 deque 블록과 풀 청크를 데운다.
+    // 경로마다 따로 데운다. 복사 경로가 만든 청크 사이에 구간이 흩어지지 않게 큐와 풀도 따로 쓴다.
+    net::ChunkPool slice_pool(kPoolChunks);
+    std::vector<net::OutboundQueue> slice_queues(member_count);
+    SharedPayload(flat, shared_queues, line);
+    ChunkFanOut(flat, slice_queues, slice_pool, line, true);
+    ChunkFanOut(flat, chunk_queues, pool, line, false);
+
+    const double shared_ns = SharedPayload(flat, shared_queues, line);
+    const double slice_ns = ChunkFanOut(flat, slice_queues, slice_pool, line, true);
+    const double copy_ns = ChunkFanOut(flat, chunk_queues, pool, line, false);
+    std::printf("  members=%-6d line=%-4zu shared-buffer=%.2f chunk-copy=%.2f shared-slice=%.2f us/msg\n",
+                member_count, line.size() + 2, shared_ns / 1000.0, copy_ns / 1000.0, slice_ns / 1000.0);
+}
+
+void Measure(int member_count) {
+    std::set<int> tree;
+    state::MemberList flat;
+    for (int fd = 0; fd < member_count; ++fd) {
+        tree.insert(fd);
+        flat.Insert(fd, 0);
+    }
+    std::vector<std::deque<net::SharedBuffer> > queues(member_count);
+    const net::SharedBuffer buffer =
+        MakeLineBuffer(":alice!alice@server PRIVMSG #bench :hello");
+
+    std::size_t copy_sent = 0;
+    double copy_ns = 0;
+    for (int i = 0; i < kMessages; ++i) {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        copy_sent += CopyAndFanOut(tree, queues, buffer, i % member_count);
+        std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+        copy_ns += std::chrono::duration<double, std::nano>(end - start).count();
+        Drain(queues);
+    }
+    std::size_t flat_sent = 0;
+    double flat_ns = 0;
+    for (int i = 0; i < kMessages; ++i) {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        flat_sent += FanOutInPlace(flat, queues, buffer, i % member_count);
+        std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+        flat_ns += std::chrono::duration<double, std::nano>(end - start).count();
+        Drain(queues);
+    }
+
+    std::printf("  members=%-6d copy+fanout=%.0f us/msg in-place=%.0f us/msg%s\n", member_count,
+                copy_ns / kMessages / 1000.0, flat_ns / kMessages / 1000.0,
+                copy_sent == flat_sent ? "" : " (mismatch)");
+}
+}  // namespace
+
+int main() {
+    std::printf("broadcast_bench: messages=%d\n", kMessages);
+    for (std::size_t i = 0; i < sizeof(kMemberCounts) / sizeof(kMemberCounts[0]); ++i) {
+        Measure(kMemberCounts[i]);
+    }
+    std::printf("broadcast_bench: payload (enqueue + drain), pool=%zu chunks\n", kPoolChunks);
+    for (std::size_t i = 0; i < sizeof(kPayloadMemberCounts) / sizeof(kPayloadMemberCounts[0]); ++i) {
+        for (std::size_t j = 0; j < sizeof(kLineSizes) / sizeof(kLineSizes[0]); ++j) {
+            MeasurePayload(kPayloadMemberCounts[i], kLineSizes[j]);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,98 @@
+/*
+ * 설명: 채널 수가 늘어날 때 JOIN/PRIVMSG/PART 한 번에 드는 채널 조회·멤버 갱신 비용을 이전 map/set 구조와 채널 레지스트리로 비교한다.
+ * 버전: v1.1.0
+ * 관련 문서: design/server/v1.1.0-performance.md
+ * 테스트: 이 파일 자체 (make bench)
+ */
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "state/channel_registry.hpp"
+
+namespace {
+const int kOps = 20000;
+const int kMembersPerChannel = 8;
+const int kChannelCounts[] = {1000, 10000, 50000};
+
+// 이전 ChannelState와 같은 배치.
+struct OldChannel {
+    std::set<int> members;
+    std::set<int> operators;
+};
+
+struct NewChannel {
+    state::MemberList members;
+};
+
+void Measure(int channel_count) {
+    std::map<std::string, OldChannel> old_channels;
+    state::ChannelRegistry<NewChannel> registry;
+    std::vector<std::string> names;
+    for (int c = 0; c < channel_count; ++c) {
+        names.push_back("#chan" + std::to_string(c));
+        OldChannel &old_channel = old_channels[names.back()];
+        NewChannel &new_channel = registry.Get(registry.FindOrCreate(names.back()));
+        for (int m = 0; m < kMembersPerChannel; ++m) {
+            int fd = 100 + m * 13 + c % 7;
+            old_channel.members.insert(fd);
+            new_channel.members.Insert(fd, m == 0 ? state::kMemberOperator : 0u);
+        }
+        old_channel.operators.insert(*old_channel.members.begin());
+    }
+    const int joiner = 5;
+
+    long checksum = 0;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kOps; ++i) {
+        const std::string &name = names[(i * 7919) % channel_count];
+        // JOIN: 조회 + 삽입 + 운영자 확인
+        OldChannel &channel = old_channels.find(name)->second;
+        channel.members.insert(joiner);
+        checksum += channel.operators.empty() ? 0 : 1;
+        // PRIVMSG: 조회 + 멤버 확인 + 복사 후 순회
+        OldChannel &target = old_channels.find(name)->second;
+        if (target.members.count(joiner) != 0) {
+            std::set<int> recipients = target.members;
+            for (std::set<int>::const_iterator it = recipients.begin(); it != recipients.end(); ++it) {
+                checksum += *it;
+            }
+        }
+        // PART: 조회 + 삭제
+        OldChannel &leaving = old_channels.find(name)->second;
+        leaving.members.erase(joiner);
+        leaving.operators.erase(joiner);
+    }
+    std::chrono::steady_clock::time_point mid = std::chrono::steady_clock::now();
+    for (int i = 0; i < kOps; ++i) {
+        const std::string &name = names[(i * 7919) % channel_count];
+        state::ChannelId id = registry.Find(name);
+        state::MemberList &members = registry.Get(id).members;
+        members.Insert(joiner, 0);
+        checksum -= members.OperatorCount() == 0 ? 0 : 1;
+        if (members.Contains(joiner)) {
+            for (std::size_t m = 0; m < members.size(); ++m) {
+                checksum -= members[m].fd;
+            }
+        }
+        members.Erase(joiner);
+    }
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+    double old_ns = std::chrono::duration<double, std::nano>(mid - start).count() / kOps;
+    double new_ns = std::chrono::duration<double, std::nano>(end - mid).count() / kOps;
+    std::printf("  channels=%-6d map/set=%.0f ns/round registry=%.0f ns/round%s\n", channel_count,
+                old_ns, new_ns, checksum == 0 ? "" : " (mismatch)");
+}
+}  // namespace
+
+int main() {
+    std::printf("channel_bench: rounds=%d members=%d\n", kOps, kMembersPerChannel + 1);
+    for (std::size_t i = 0; i < sizeof(kChannelCounts) / sizeof(kChannelCounts[0]); ++i) {
+        Measure(kChannelCounts[i]);
+    }
+    return 0;
+}
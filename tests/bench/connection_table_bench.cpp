@@ -0,0 +1,85 @@
+/*
+ * 설명: 명령 처리처럼 fd로 연결 상태를 반복 조회할 때 std::map과 연결 슬랩의 조회 비용을 비교한다.
+ * 버전: v1.1.0
+ * 관련 문서: design/server/v1.1.0-performance.md
+ * 테스트: 이 파일 자체 (make bench)
+ */
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "state/connection_table.hpp"
+
+namespace {
+const int kLookups = 1000000;
+const int kClientCounts[] = {1000, 10000, 50000};
+
+struct Hot {
+    std::size_t queued;
+    Hot() : queued(0) {}
+    void Reset() { queued = 0; }
+};
+
+struct Cold {
+    bool registered;
+    std::string nick;
+    Cold() : registered(true) {}
+    void Reset() {
+        registered = true;
+        nick.clear();
+    }
+};
+
+// 이전 ClientConnection처럼 핫/콜드 필드를 한 구조체에 둔다.
+struct Combined {
+    std::size_t queued;
+    bool registered;
+    std::string nick;
+    Combined() : queued(0), registered(true) {}
+};
+
+void Measure(int clients) {
+    std::map<int, Combined> tree;
+    state::ConnectionTable<Hot, Cold> table;
+    for (int fd = 0; fd < clients; ++fd) {
+        tree[fd] = Combined();
+        table.Insert(fd);
+    }
+    std::vector<int> order;
+    for (int i = 0; i < kLookups; ++i) {
+        order.push_back(static_cast<int>((static_cast<long>(i) * 7919) % clients));
+    }
+
+    // 핸들러가 한 명령에서 registered 확인 후 큐를 건드리는 패턴.
+    std::size_t tree_sum = 0;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kLookups; ++i) {
+        if (tree[order[i]].registered) {
+            tree_sum += ++tree[order[i]].queued;
+        }
+    }
+    std::chrono::steady_clock::time_point mid = std::chrono::steady_clock::now();
+    std::size_t table_sum = 0;
+    for (int i = 0; i < kLookups; ++i) {
+        if (table.Contains(order[i]) && table.Session(order[i]).registered) {
+            table_sum += ++table.Io(order[i]).queued;
+        }
+    }
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+    double tree_ns = std::chrono::duration<double, std::nano>(mid - start).count() / kLookups;
+    double table_ns = std::chrono::duration<double, std::nano>(end - mid).count() / kLookups;
+    std::printf("  clients=%-6d map=%.1f ns/command table=%.1f ns/command%s\n", clients, tree_ns,
+                table_ns, tree_sum == table_sum ? "" : " (mismatch)");
+}
+}  // namespace
+
+int main() {
+    std::printf("connection_table_bench: lookups=%d\n", kLookups);
+    for (std::size_t i = 0; i < sizeof(kClientCounts) / sizeof(kClientCounts[0]); ++i) {
+        Measure(kClientCounts[i]);
+    }
+    return 0;
+}
@@ -0,0 +1,61 @@
+/*
+ * 설명: 명령 디스패치 비용을 명령별로 측정한다. 대문자 사본 + 문자열 비교 체인(이전 방식)과 LookupCommand를 비교한다.
+ * 버전: v1.1.0
+ * 관련 문서: design/server/v1.1.0-performance.md
+ * 테스트: 이 파일 자체 (make bench)
+ */
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+#include "protocol/command.hpp"
+
+namespace {
+const int kIterations = 2000000;
+const char *const kChainOrder[] = {"PING",  "PONG", "PASS",  "NICK", "USER",   "JOIN",
+                                   "PART",  "PRIVMSG", "NOTICE", "TOPIC", "KICK", "INVITE",
+                                   "MODE", "REHASH", "NAMES", "LIST", "QUIT"};
+const std::size_t kChainSize = sizeof(kChainOrder) / sizeof(kChainOrder[0]);
+
+// v1.0.0 HandleCommand와 같은 방식: 대문자 사본을 만든 뒤 순서대로 비교한다.
+int ChainDispatch(const std::string &token) {
+    std::string upper = token;
+    for (std::size_t i = 0; i < upper.size(); ++i) {
+        upper[i] = static_cast<char>(std::toupper(static_cast<unsigned char>(upper[i])));
+    }
+    for (std::size_t i = 0; i < kChainSize; ++i) {
+        if (upper == kChainOrder[i]) {
+            return static_cast<int>(i) + 1;
+        }
+    }
+    return 0;
+}
+
+template <typename Fn>
+double MeasureNs(const std::string &token, Fn fn) {
+    volatile int sink = 0;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kIterations; ++i) {
+        sink = sink + fn(token);
+    }
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / kIterations;
+}
+}  // namespace
+
+int main() {
+    std::printf("dispatch_bench: iterations=%d (token은 클라이언트가 보낸 소문자 형태)\n", kIterations);
+    for (std::size_t i = 0; i < kChainSize; ++i) {
+        std::string token = kChainOrder[i];
+        for (std::size_t j = 0; j < token.size(); ++j) {
+            token[j] = static_cast<char>(std::tolower(static_cast<unsigned char>(token[j])));
+        }
+        double chain_ns = MeasureNs(token, ChainDispatch);
+        double table_ns = MeasureNs(token, [](const std::string &t) {
+            return static_cast<int>(protocol::LookupCommand(t));
+        });
+        std::printf("  %-8s chain=%5.1f ns  table=%5.1f ns\n", kChainOrder[i], chain_ns, table_ns);
+    }
+    return 0;
+}
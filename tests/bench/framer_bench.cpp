@@ -0,0 +1,85 @@
+/*
+ * 설명: 한 번의 recv에 1000개 PING이 파이프라인으로 들어왔을 때 ExtractLines와 입력 링 프레이머의 라인당 비용을 비교한다.
+ * 버전: v1.1.0
+ * 관련 문서: design/server/v1.1.0-performance.md
+ * 테스트: 이 파일 자체 (make bench)
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "protocol/framer.hpp"
+
+namespace {
+const int kLines = 1000;
+const int kRounds = 200;
+const std::size_t kMaxLine = 512;
+
+std::string BuildPipelinedInput() {
+    std::string data;
+    for (int i = 0; i < kLines; ++i) {
+        data += "PING :token" + std::to_string(i) + "\r\n";
+    }
+    return data;
+}
+
+// ExtractLines는 버퍼가 정책 길이를 넘으면 거부하므로 정책 길이 단위로 나눠 넣는다.
+double MeasureExtractLines(const std::string &data, std::size_t &lines_out) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::size_t lines = 0;
+    for (int round = 0; round < kRounds; ++round) {
+        std::string buffer;
+        std::size_t offset = 0;
+        while (offset < data.size()) {
+            std::size_t n = std::min(kMaxLine - buffer.size(), data.size() - offset);
+            buffer.append(data, offset, n);
+            offset += n;
+            protocol::FrameResult res = protocol::ExtractLines(buffer, kMaxLine);
+            lines += res.lines.size();
+        }
+    }
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    lines_out = lines / kRounds;
+    return std::chrono::duration<double, std::nano>(end - start).count() / lines;
+}
+
+double MeasureInputRing(const std::string &data, std::size_t &lines_out) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::size_t lines = 0;
+    std::size_t checksum = 0;
+    for (int round = 0; round < kRounds; ++round) {
+        protocol::InputRing ring(kMaxLine, kMaxLine);
+        std::size_t offset = 0;
+        while (offset < data.size()) {
+            std::size_t n = std::min(ring.WritableSize(), data.size() - offset);
+            std::memcpy(ring.WritePtr(), data.data() + offset, n);
+            ring.Commit(n);
+            offset += n;
+            std::string_view line;
+            while (ring.NextLine(line) == protocol::FrameStatus::kLine) {
+                checksum += line.size();
+                ++lines;
+            }
+        }
+    }
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    lines_out = checksum > 0 ? lines / kRounds : 0;
+    return std::chrono::duration<double, std::nano>(end - start).count() / lines;
+}
+}  // namespace
+
+int main() {
+    const std::string data = BuildPipelinedInput();
+    std::size_t extract_lines = 0;
+    std::size_t ring_lines = 0;
+    double extract_ns = MeasureExtractLines(data, extract_lines);
+    double ring_ns = MeasureInputRing(data, ring_lines);
+
+    std::printf("framer_bench: %d pipelined PINGs (%zu bytes), rounds=%d\n", kLines, data.size(),
+                kRounds);
+    std::printf("  ExtractLines  lines=%zu %.1f ns/line\n", extract_lines, extract_ns);
+    std::printf("  InputRing     lines=%zu %.1f ns/line\n", ring_lines, ring_ns);
+    return 0;
+}
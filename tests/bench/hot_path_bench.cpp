@@ -0,0 +1,165 @@
+/*
+ * 설명: 프로토콜/라우팅 핫 패스(ExtractLines, ParseMessageLine, 닉네임/채널 이름 검사, PollServer 채널 팬아웃)의 ns/op, 할당/op, 처리량을 재고 JSON으로 낸다.
+ * 버전: v1.1.0
+ * 관련 문서: design/server/v1.1.0-performance.md
+ * 테스트: 이 파일 자체 (make bench)
+ */
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "../support/server_harness.hpp"
+#include "bench_harness.hpp"
+#include "protocol/framer.hpp"
+#include "protocol/message.hpp"
+
+// 채널 하나에 members명을 넣어 두고, 0번 클라이언트가 채널에 PRIVMSG 한 줄을 보내 서버가 그 줄을 읽어
+// 모든 멤버 소켓에 써 넣을 때까지를 한 번으로 센다.
+class FanOutBench {
+   public:
+    explicit FanOutBench(std::size_t members) {
+        for (std::size_t i = 0; i < members; ++i) {
+            const std::size_t client = harness_.Connect("u" + std::to_string(i));
+            harness_.Feed(client, "JOIN #bench\r\n");
+            harness_.Flush();
+            harness_.Drain();
+        }
+        harness_.ResetReceived();
+    }
+
+    // 받는 쪽 소켓은 몇 번에 한 번씩 비워 측정 클라이언트의 recv 비용을 나눠 싣는다.
+    void Send(std::uint64_t count) {
+        static const std::string kLine = "PRIVMSG #bench :hello from the fan-out benchmark\r\n";
+        for (std::uint64_t i = 0; i < count; ++i) {
+            harness_.Feed(0, kLine);
+            harness_.Flush();
+            if ((i & 63) == 63) {
+                harness_.Drain();
+            }
+        }
+        harness_.Drain();
+    }
+
+    std::uint64_t received_lines() const { return harness_.received_lines(); }
+
+   private:
+    ServerHarness harness_;
+};
+
+namespace {
+const std::size_t kMaxLine = 512;
+const int kPipelinedLines = 1000;
+const std::uint64_t kParseOps = 2000000;
+const std::uint64_t kValidateOps = 10000000;
+const std::size_t kFanOutMembers[] = {16, 256};
+
+const char *const kParseLines[] = {
+    ":alice!alice@irc.local PRIVMSG #bench :hello from the parser benchmark",
+    "JOIN #bench,#other key1,key2",
+    "MODE #bench +kl secret 42",
+    "PING :irc.local",
+};
+const std::size_t kParseLineCount = sizeof(kParseLines) / sizeof(kParseLines[0]);
+
+const char *const kNicknames[] = {"alice", "Bob_42", "x[away]", "-bad", "bad nick", "a", "n\\ick", "bad!"};
+const char *const kChannelNames[] = {"#bench", "#a", "#room_1-x", "room", "#bad.name", "#",
+                                     "#abcdefghijklmnopqrstuvwxyz0123456789", "#bad,name"};
+const std::size_t kNameCount = 8;
+
+std::string BuildPipelinedInput() {
+    std::string data;
+    for (int i = 0; i < kPipelinedLines; ++i) {
+        data += "PING :token" + std::to_string(i) + "\r\n";
+    }
+    return data;
+}
+
+// 한 번 = 라인 하나. 1000줄 파이프라인 입력을 정책 길이 단위로 나눠 넣는다.
+void RunExtractLines(const std::string &data, std::uint64_t lines) {
+    for (std::uint64_t round = 0; round * kPipelinedLines < lines; ++round) {
+        std::string buffer;
+        std::size_t offset = 0;
+        while (offset < data.size()) {
+            std::size_t n = std::min(kMaxLine - buffer.size(), data.size() - offset);
+            buffer.append(data, offset, n);
+            offset += n;
+            protocol::FrameResult res = protocol::ExtractLines(buffer, kMaxLine);
+            bench::DoNotOptimize(res.lines.size());
+        }
+    }
+}
+
+void PrintUsage(const char *prog) {
+    std::fprintf(stderr, "사용법: %s [--json <path|->]\n", prog);
+}
+}  // namespace
+
+int main(int argc, char **argv) {
+    std::string json_path;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            json_path = argv[++i];
+        } else {
+            PrintUsage(argv[0]);
+            return 2;
+        }
+    }
+
+    bench::Report report("hot_path_bench");
+
+    const std::string pipelined = BuildPipelinedInput();
+    const std::uint64_t extract_lines = 200 * kPipelinedLines;
+    report.Add(bench::Measure("extract_lines", extract_lines, 1,
+                              [&](std::uint64_t n) { RunExtractLines(pipelined, n); }));
+
+    std::vector<std::string> parse_lines(kParseLines, kParseLines + kParseLineCount);
+    report.Add(bench::Measure("parse_message_line", kParseOps, 1, [&](std::uint64_t n) {
+        for (std::uint64_t i = 0; i < n; ++i) {
+            protocol::ParsedMessage msg = protocol::ParseMessageLine(parse_lines[i % kParseLineCount]);
+            bench::DoNotOptimize(msg.params.size());
+        }
+    }));
+    report.Add(bench::Measure("parse_message_view", kParseOps, 1, [&](std::uint64_t n) {
+        for (std::uint64_t i = 0; i < n; ++i) {
+            protocol::ParsedMessageView msg = protocol::ParseMessageView(parse_lines[i % kParseLineCount]);
+            bench::DoNotOptimize(msg.params.size());
+        }
+    }));
+
+    report.Add(bench::Measure("is_valid_nickname", kValidateOps, 1, [&](std::uint64_t n) {
+        for (std::uint64_t i = 0; i < n; ++i) {
+            bench::DoNotOptimize(protocol::IsValidNickname(kNicknames[i % kNameCount]));
+        }
+    }));
+    report.Add(bench::Measure("is_valid_channel_name", kValidateOps, 1, [&](std::uint64_t n) {
+        for (std::uint64_t i = 0; i < n; ++i) {
+            bench::DoNotOptimize(protocol::IsValidChannelName(kChannelNames[i % kNameCount]));
+        }
+    }));
+
+    for (std::size_t m = 0; m < sizeof(kFanOutMembers) / sizeof(kFanOutMembers[0]); ++m) {
+        const std::size_t members = kFanOutMembers[m];
+        FanOutBench fanout(members);
+        // 멤버 수와 관계없이 전달 약 50만 줄을 잰다.
+        const std::uint64_t messages = 500000 / members;
+        const bench::Result result =
+            bench::Measure("fanout_privmsg_" + std::to_string(members), messages,
+                           static_cast<double>(members - 1), [&](std::uint64_t n) { fanout.Send(n); });
+        const std::uint64_t expected = (messages + (messages / 10 > 0 ? messages / 10 : 1)) * (members - 1);
+        if (fanout.received_lines() != expected) {
+            std::fprintf(stderr, "fanout_privmsg_%zu: 받은 줄 %llu, 기대 %llu\n", members,
+                         static_cast<unsigned long long>(fanout.received_lines()),
+                         static_cast<unsigned long long>(expected));
+            return 1;
+        }
+        report.Add(result);
+    }
+
+    if (!json_path.empty() && !report.WriteJson(json_path)) {
+        std::fprintf(stderr, "JSON 쓰기 실패: %s\n", json_path.c_str());
+        return 1;
+    }
+    return 0;
+}
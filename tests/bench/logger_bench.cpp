@@ -0,0 +1,69 @@
+/*
+ * 설명: 경고 로그를 쏟아낼 때 이벤트 루프 스레드가 치르는 비용을, 라인마다 파일에 쓰고 flush하던 이전 방식과 링에 넣고 돌아오는 비동기 로거로 비교한다. 꺼진 레벨의 비용도 함께 잰다.
+ * 버전: v1.1.0
+ * 관련 문서: design/server/v1.1.0-performance.md
+ * 테스트: 이 파일 자체 (make bench)
+ */
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "utils/logger.hpp"
+
+namespace {
+const int kLines = 100000;
+
+double NsPerLine(std::chrono::steady_clock::time_point start) {
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / kLines;
+}
+}  // namespace
+
+int main() {
+    const std::string path = "/tmp/modern_irc_logger_bench_" + std::to_string(getpid()) + ".log";
+
+    // 이전 Logger::Log: ostringstream으로 만들고 라인마다 write + flush.
+    double sync_ns = 0;
+    {
+        std::ofstream file(path.c_str(), std::ios::out | std::ios::trunc);
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (int i = 0; i < kLines; ++i) {
+            std::ostringstream oss;
+            oss << "[warn] 송신 큐 초과: fd=" << i << " nick=flood queued=262144";
+            file << oss.str() << '\n';
+            file.flush();
+        }
+        sync_ns = NsPerLine(start);
+    }
+
+    double async_ns = 0;
+    double disabled_ns = 0;
+    std::uint64_t dropped = 0;
+    {
+        Logger logger;
+        logger.SetOutput(path);
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (int i = 0; i < kLines; ++i) {
+            IRC_LOG(logger, config::LogLevel::kWarn, "송신 큐 초과: fd=" << i << " nick=flood queued=262144");
+        }
+        async_ns = NsPerLine(start);
+        logger.Flush();
+        dropped = logger.dropped();
+
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < kLines; ++i) {
+            IRC_LOG(logger, config::LogLevel::kDebug, "꺼진 레벨: fd=" << i);
+        }
+        disabled_ns = NsPerLine(start);
+    }
+    std::remove(path.c_str());
+
+    std::printf("logger_bench: lines=%d\n", kLines);
+    std::printf("  sync write+flush=%.0f ns/line async enqueue=%.0f ns/line (dropped=%llu) disabled=%.1f ns/line\n",
+                sync_ns, async_ns, static_cast<unsigned long long>(dropped), disabled_ns);
+    return 0;
+}
@@ -0,0 +1,73 @@
+/*
+ * 설명: 연결 수가 늘어날 때 개인 메시지 대상 조회 비용을 이전 선형 탐색과 닉네임 인덱스로 비교한다.
+ * 버전: v1.1.0
+ * 관련 문서: design/server/v1.1.0-performance.md
+ * 테스트: 이 파일 자체 (make bench)
+ */
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "state/nick_registry.hpp"
+
+namespace {
+const int kLookups = 2000;
+const int kUserCounts[] = {1000, 10000, 50000};
+
+struct FakeClient {
+    std::string nick;
+    bool registered;
+};
+
+// 이전 PollServer::FindClientFdByNick과 같은 순회.
+int LinearFind(const std::map<int, FakeClient> &clients, const std::string &nick) {
+    for (std::map<int, FakeClient>::const_iterator it = clients.begin(); it != clients.end(); ++it) {
+        if (it->second.registered && it->second.nick == nick) {
+            return it->first;
+        }
+    }
+    return -1;
+}
+
+void Measure(int users) {
+    std::map<int, FakeClient> clients;
+    state::NickRegistry registry;
+    std::vector<std::string> targets;
+    for (int fd = 0; fd < users; ++fd) {
+        FakeClient client;
+        client.nick = "user" + std::to_string(fd);
+        client.registered = true;
+        registry.Claim(client.nick, fd);
+        clients[fd] = client;
+    }
+    for (int i = 0; i < kLookups; ++i) {
+        targets.push_back("user" + std::to_string((i * 7919) % users));
+    }
+
+    long checksum = 0;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kLookups; ++i) {
+        checksum += LinearFind(clients, targets[i]);
+    }
+    std::chrono::steady_clock::time_point mid = std::chrono::steady_clock::now();
+    for (int i = 0; i < kLookups; ++i) {
+        checksum -= registry.Find(targets[i]);
+    }
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+    double linear_ns = std::chrono::duration<double, std::nano>(mid - start).count() / kLookups;
+    double index_ns = std::chrono::duration<double, std::nano>(end - mid).count() / kLookups;
+    std::printf("  users=%-6d linear=%.0f ns/lookup index=%.1f ns/lookup%s\n", users, linear_ns,
+                index_ns, checksum == 0 ? "" : " (mismatch)");
+}
+}  // namespace
+
+int main() {
+    std::printf("nick_lookup_bench: lookups=%d\n", kLookups);
+    for (std::size_t i = 0; i < sizeof(kUserCounts) / sizeof(kUserCounts[0]); ++i) {
+        Measure(kUserCounts[i]);
+    }
+    return 0;
+}
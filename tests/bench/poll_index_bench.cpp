@@ -0,0 +1,52 @@
+/*
+ * 설명: 유휴 연결 수가 늘어나도 브로드캐스트 시 쓰기 관심 갱신 비용이 일정한지 측정한다.
+ * 버전: v1.1.0
+ * 관련 문서: design/server/v1.1.0-performance.md
+ * 테스트: 이 파일 자체 (make bench)
+ */
+#include <chrono>
+#include <cstdio>
+
+#include "net/reactor.hpp"
+
+namespace {
+const int kMembers = 1000;
+const int kRounds = 200;
+const int kIdleCounts[] = {0, 1000, 10000, 50000};
+
+// 채널 멤버 fd는 유휴 연결 뒤쪽에 배치해 선형 탐색이라면 최악의 경우가 되도록 한다.
+double MeasureBroadcastNs(int idle) {
+    net::PollReactor reactor;
+    for (int fd = 0; fd < idle; ++fd) {
+        reactor.Add(fd, net::kEventRead);
+    }
+    const int first_member = idle;
+    for (int i = 0; i < kMembers; ++i) {
+        reactor.Add(first_member + i, net::kEventRead);
+    }
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int round = 0; round < kRounds; ++round) {
+        // 브로드캐스트: 멤버마다 쓰기 관심을 켜고, 송신 완료 후 다시 끈다.
+        for (int i = 0; i < kMembers; ++i) {
+            reactor.Modify(first_member + i, net::kEventRead | net::kEventWrite);
+        }
+        for (int i = 0; i < kMembers; ++i) {
+            reactor.Modify(first_member + i, net::kEventRead);
+        }
+    }
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    double total_ns = std::chrono::duration<double, std::nano>(end - start).count();
+    return total_ns / kRounds;
+}
+}  // namespace
+
+int main() {
+    std::printf("poll_index_bench: members=%d rounds=%d\n", kMembers, kRounds);
+    for (std::size_t i = 0; i < sizeof(kIdleCounts) / sizeof(kIdleCounts[0]); ++i) {
+        double ns = MeasureBroadcastNs(kIdleCounts[i]);
+        std::printf("  idle=%-6d broadcast=%.0f ns (%.1f ns/member)\n", kIdleCounts[i], ns,
+                    ns / kMembers);
+    }
+    return 0;
+}
@@ -0,0 +1,78 @@
+/*
+ * 설명: PRIVMSG 한 줄을 만들 때, prefix를 매번 다시 만들고 std::string 임시 객체를 이어 붙이던 이전 방식과 캐시된 prefix와 라인 빌더를 쓰는 방식의 비용을 비교한다.
+ * 버전: v1.1.0
+ * 관련 문서: design/server/v1.1.0-performance.md
+ * 테스트: 이 파일 자체 (make bench)
+ */
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string>
+
+#include "net/line_builder.hpp"
+#include "net/shared_buffer.hpp"
+
+namespace {
+const int kLines = 1000000;
+
+struct Session {
+    std::string nick;
+    std::string username;
+    std::string prefix;
+};
+
+// 이전 MakeLineBuffer: CRLF를 붙인 라인을 공유 버퍼로 한 번 만든다.
+net::SharedBuffer MakeLineBuffer(const std::string &line) {
+    std::string framed;
+    framed.reserve(line.size() + 2);
+    framed.append(line);
+    framed.append("\r\n");
+    return std::make_shared<const std::string>(std::move(framed));
+}
+
+// 이전 BuildUserPrefix + 문자열 연결.
+net::SharedBuffer Concatenate(const Session &session, const std::string &server,
+                              const std::string &target, const std::string &text) {
+    const std::string prefix = ":" + (session.nick.empty() ? std::string("*") : session.nick) + "!" +
+                               session.username + "@" + server;
+    return MakeLineBuffer(prefix + " PRIVMSG " + target + " :" + text);
+}
+
+// 라인 빌더 + 캐시된 prefix. 송신 큐가 빌더의 뷰를 청크에 복사해 가므로 라인을 만드는 데는 할당이 없다.
+std::size_t Build(const Session &session, const std::string &target, const std::string &text) {
+    net::LineBuilder line;
+    line.Append(session.prefix).Append(" PRIVMSG ").Append(target).Append(" :").Append(text);
+    return line.Finish().size();
+}
+
+template <typename F>
+double Measure(F make_line, std::size_t &bytes) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kLines; ++i) {
+        bytes += make_line();
+    }
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / kLines;
+}
+}  // namespace
+
+int main() {
+    const std::string server = "irc.local";
+    const std::string target = "#bench";
+    const std::string text = "hello from the reply builder benchmark";
+    Session session;
+    session.nick = "alice";
+    session.username = "alice";
+    session.prefix = ":" + session.nick + "!" + session.username + "@" + server;
+
+    std::size_t concat_bytes = 0;
+    std::size_t build_bytes = 0;
+    const double concat_ns =
+        Measure([&]() { return Concatenate(session, server, target, text)->size(); }, concat_bytes);
+    const double build_ns = Measure([&]() { return Build(session, target, text); }, build_bytes);
+
+    std::printf("reply_bench: lines=%d\n", kLines);
+    std::printf("  concat=%.1f ns/line builder+cached-prefix=%.1f ns/line%s\n", concat_ns, build_ns,
+                concat_bytes == build_bytes ? "" : " (mismatch)");
+    return 0;
+}
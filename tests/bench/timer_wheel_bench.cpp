@@ -0,0 +1,81 @@
+/*
+ * 설명: 대부분 쉬고 있는 연결들의 시간 초과를 매 틱 전체 순회로 확인할 때와 타이머 휠로 확인할 때의 비용을 비교한다.
+ * 버전: v1.1.0
+ * 관련 문서: design/server/v1.1.0-performance.md
+ * 테스트: 이 파일 자체 (make bench)
+ */
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "net/timer_wheel.hpp"
+
+namespace {
+const std::uint64_t kTickMs = 100;
+const std::uint64_t kIntervalMs = 120000;  // 기본 ping_interval
+const int kTicks = 600;                    // 1분 분량
+const int kClientCounts[] = {1000, 10000, 100000};
+
+void Measure(int clients) {
+    // 연결마다 마지막 활동 시각을 흩어 둔다.
+    std::vector<std::uint64_t> last_activity(static_cast<std::size_t>(clients));
+    for (int i = 0; i < clients; ++i) {
+        last_activity[static_cast<std::size_t>(i)] =
+            static_cast<std::uint64_t>((static_cast<long>(i) * 7919) % kIntervalMs);
+    }
+    const std::uint64_t base = kIntervalMs;
+
+    std::size_t scan_due = 0;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int tick = 1; tick <= kTicks; ++tick) {
+        const std::uint64_t now = base + static_cast<std::uint64_t>(tick) * kTickMs;
+        for (int i = 0; i < clients; ++i) {
+            std::uint64_t &last = last_activity[static_cast<std::size_t>(i)];
+            if (now - last >= kIntervalMs) {
+                last = now;
+                ++scan_due;
+            }
+        }
+    }
+    std::chrono::steady_clock::time_point mid = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < clients; ++i) {
+        last_activity[static_cast<std::size_t>(i)] =
+            static_cast<std::uint64_t>((static_cast<long>(i) * 7919) % kIntervalMs);
+    }
+    std::vector<std::uint64_t> expired;
+    net::TimerWheel wheel(kTickMs);
+    wheel.Advance(base, expired);
+    for (int i = 0; i < clients; ++i) {
+        wheel.Schedule(static_cast<std::uint64_t>(i),
+                       last_activity[static_cast<std::size_t>(i)] + kIntervalMs);
+    }
+    std::size_t wheel_due = 0;
+    std::chrono::steady_clock::time_point wheel_start = std::chrono::steady_clock::now();
+    for (int tick = 1; tick <= kTicks; ++tick) {
+        const std::uint64_t now = base + static_cast<std::uint64_t>(tick) * kTickMs;
+        expired.clear();
+        wheel.Advance(now, expired);
+        for (std::size_t i = 0; i < expired.size(); ++i) {
+            wheel.Schedule(expired[i], now + kIntervalMs);
+        }
+        wheel_due += expired.size();
+    }
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+    double scan_us = std::chrono::duration<double, std::micro>(mid - start).count() / kTicks;
+    double wheel_us = std::chrono::duration<double, std::micro>(end - wheel_start).count() / kTicks;
+    std::printf("  clients=%-6d scan=%.2f us/tick wheel=%.2f us/tick due=%zu/%zu\n", clients, scan_us,
+                wheel_us, scan_due, wheel_due);
+}
+}  // namespace
+
+int main() {
+    std::printf("timer_wheel_bench: ticks=%d tick_ms=%llu\n", kTicks,
+                static_cast<unsigned long long>(kTickMs));
+    for (std::size_t i = 0; i < sizeof(kClientCounts) / sizeof(kClientCounts[0]); ++i) {
+        Measure(kClientCounts[i]);
+    }
+    return 0;
+}
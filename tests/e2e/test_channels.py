@@ -1,6 +1,6 @@
 """
-버전: v0.4.0
-관련 문서: design/protocol/contract.md
+버전: v1.1.0
+관련 문서: design/protocol/contract.md, design/server/v1.1.0-performance.md
 테스트: 이 파일 자체
 설명: JOIN/PART 채널 멤버십과 브로드캐스트를 검증한다.
 """
@@ -70,6 +70,27 @@ class ChannelTest(unittest.TestCase):
                         with self.assertRaises(socket.timeout):
                             sock1.recv(1024)
 
+    def test_channel_names_are_case_insensitive(self):
+        with run_server() as (_proc, port, password):
+            with socket.create_connection(("127.0.0.1", port), timeout=2.0) as sock1:
+                register_client(sock1, password, "upper")
+                sock1.sendall(b"JOIN #Room\r\n")
+                self.assertIn("JOIN #Room", recv_line(sock1))
+
+                with socket.create_connection(("127.0.0.1", port), timeout=2.0) as sock2:
+                    register_client(sock2, password, "lower")
+                    sock2.sendall(b"JOIN #room\r\n")
+                    self.assertIn("JOIN #Room", recv_line(sock2))
+                    self.assertIn("JOIN #Room", recv_line(sock1))
+
+                    sock2.sendall(b"PRIVMSG #ROOM :same channel\r\n")
+                    msg = recv_line(sock1)
+                    self.assertTrue(msg.startswith(":lower!"))
+                    self.assertIn("PRIVMSG #Room :same channel", msg)
+
+                    sock1.sendall(b"JOIN #rOOm\r\n")
+                    self.assertIn(" 443 ", recv_line(sock1))
+
 
 if __name__ == "__main__":
     unittest.main()
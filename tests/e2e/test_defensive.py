@@ -1,10 +1,11 @@
 """
-버전: v0.9.0
-관련 문서: design/protocol/contract.md, design/server/v0.9.0-defensive.md
+버전: v1.1.0
+관련 문서: design/protocol/contract.md, design/server/v0.9.0-defensive.md, design/server/v1.1.0-performance.md
 테스트: 이 파일 자체
 설명: 레이트리밋과 송신 큐 백프레셔 정책을 검증한다.
 """
 import os
+import resource
 import socket
 import tempfile
 import time
@@ -20,7 +21,13 @@ def register_client(sock: socket.socket, password: str, nick: str):
     recv_line(sock)
 
 
-def write_config(limit: int, outbound_lines: int | None = None) -> str:
+def write_config(
+    limit: int,
+    high_bytes: int | None = None,
+    joins: int | None = None,
+    low_bytes: int | None = None,
+    sndbuf: int | None = None,
+) -> str:
     fd, path = tempfile.mkstemp()
     with os.fdopen(fd, "w") as f:
         f.write("[server]\n")
@@ -30,8 +37,15 @@ def write_config(limit: int, outbound_lines: int | None = None) -> str:
         f.write("file=-\n")
         f.write("[limits]\n")
         f.write(f"messages_per_5s={limit}\n")
-        if outbound_lines is not None:
-            f.write(f"outbound_lines={outbound_lines}\n")
+        if high_bytes is not None:
+            f.write(f"outbound_high_bytes={high_bytes}\n")
+        if low_bytes is not None:
+            f.write(f"outbound_low_bytes={low_bytes}\n")
+        if joins is not None:
+            f.write(f"joins_per_5s={joins}\n")
+        if sndbuf is not None:
+            f.write("[socket]\n")
+            f.write(f"sndbuf={sndbuf}\n")
     return path
 
 
@@ -72,8 +86,30 @@ class DefensiveTest(unittest.TestCase):
         finally:
             os.remove(config_path)
 
+    def test_join_rate_limit_is_separate_from_messages(self):
+        config_path = write_config(0, joins=2)
+        try:
+            with run_server(config_path=config_path) as (_proc, port, password):
+                with socket.create_connection(("127.0.0.1", port), timeout=2.0) as sock:
+                    register_client(sock, password, "hopper")
+                    for channel in ["#one", "#two"]:
+                        sock.sendall(f"JOIN {channel}\r\n".encode())
+                        self.assertIn(f"JOIN {channel}", recv_line(sock))
+
+                    sock.sendall(b"JOIN #three\r\n")
+                    warning = recv_line(sock)
+                    self.assertIn("439", warning)
+                    self.assertIn("JOIN :명령 속도 초과", warning)
+
+                    # 다른 명령 묶음은 JOIN 토큰과 무관하게 처리된다.
+                    sock.sendall(b"PRIVMSG #one :still here\r\n")
+                    sock.sendall(b"PING :alive\r\n")
+                    self.assertEqual("PONG alive", recv_line(sock))
+        finally:
+            os.remove(config_path)
+
     def test_slow_consumer_gets_closed_on_queue_overflow(self):
-        config_path = write_config(0, outbound_lines=8)
+        config_path = write_config(0, high_bytes=4096)
         try:
             with run_server(config_path=config_path) as (_proc, port, password):
                 slow_sock = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
@@ -132,6 +168,115 @@ class DefensiveTest(unittest.TestCase):
         finally:
             os.remove(config_path)
 
+    def test_notice_dropped_between_watermarks_without_disconnect(self):
+        config_path = write_config(0, high_bytes=8 * 1024 * 1024, low_bytes=4096, sndbuf=4096)
+        try:
+            with run_server(config_path=config_path) as (_proc, port, password):
+                slow_sock = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+                slow_sock.setsockopt(socket.SOL_SOCKET, socket.SO_RCVBUF, 512)
+                slow_sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_WINDOW_CLAMP, 1024)
+                slow_sock.settimeout(2.0)
+                slow_sock.connect(("127.0.0.1", port))
+
+                with slow_sock, socket.create_connection(("127.0.0.1", port), timeout=2.0) as sender:
+                    register_client(slow_sock, password, "reader")
+                    register_client(sender, password, "noisy")
+
+                    total = 2000
+                    payload = "n" * 400
+                    for i in range(total):
+                        sender.sendall(f"NOTICE reader :{payload}{i}\r\n".encode())
+                    sender.sendall(b"PRIVMSG reader :end\r\n")
+
+                    notices = 0
+                    while True:
+                        line = recv_line(slow_sock)
+                        self.assertNotEqual("", line, "NOTICE 적체로 연결이 닫힘")
+                        if " NOTICE reader " in line:
+                            notices += 1
+                        elif line.endswith("PRIVMSG reader :end"):
+                            break
+                    self.assertGreater(notices, 0)
+                    self.assertLess(notices, total)
+        finally:
+            os.remove(config_path)
+
+    def test_notice_flood_past_high_watermark_drops_without_disconnect(self):
+        # NOTICE 한 줄이 high 워터마크를 넘기는 구간에서도 연결을 끊지 않고 버려야 한다.
+        config_path = write_config(0, high_bytes=1024, low_bytes=512, sndbuf=4096)
+        try:
+            with run_server(config_path=config_path) as (_proc, port, password):
+                slow_sock = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+                slow_sock.setsockopt(socket.SOL_SOCKET, socket.SO_RCVBUF, 512)
+                slow_sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_WINDOW_CLAMP, 1024)
+                slow_sock.settimeout(2.0)
+                slow_sock.connect(("127.0.0.1", port))
+
+                with slow_sock, socket.create_connection(("127.0.0.1", port), timeout=2.0) as sender:
+                    register_client(slow_sock, password, "reader")
+                    register_client(sender, password, "noisy")
+
+                    total = 2000
+                    payload = "h" * 440
+                    for i in range(total):
+                        sender.sendall(f"NOTICE reader :{payload}{i}\r\n".encode())
+
+                    # 쌓인 NOTICE를 다 읽어 큐를 비운 뒤 일반 메시지가 여전히 도착하는지 본다.
+                    slow_sock.settimeout(1.0)
+                    notices = 0
+                    while True:
+                        try:
+                            line = recv_line(slow_sock)
+                        except socket.timeout:
+                            break
+                        self.assertNotEqual("", line, "NOTICE 적체로 연결이 닫힘")
+                        if " NOTICE reader " in line:
+                            notices += 1
+                    self.assertGreater(notices, 0)
+                    self.assertLess(notices, total)
+
+                    slow_sock.settimeout(2.0)
+                    sender.sendall(b"PRIVMSG reader :end\r\n")
+                    self.assertTrue(recv_line(slow_sock).endswith("PRIVMSG reader :end"))
+        finally:
+            os.remove(config_path)
+
+    def test_connections_beyond_fd_limit_are_closed_not_left_pending(self):
+        # fd 상한을 낮춰 띄운다. 엣지 트리거 리스닝 소켓에서 EMFILE로 멈추면 넘친 연결은 끊기지도 받히지도 않고 남는다.
+        config_path = write_config(1000)
+
+        def limit_fds():
+            resource.setrlimit(resource.RLIMIT_NOFILE, (24, 24))
+
+        try:
+            with run_server(config_path=config_path, preexec_fn=limit_fds) as (_proc, port, password):
+                clients = []
+                try:
+                    for _ in range(40):
+                        clients.append(socket.create_connection(("127.0.0.1", port), timeout=2.0))
+                    closed = 0
+                    for client in clients:
+                        client.settimeout(0.3)
+                        try:
+                            if client.recv(1024) == b"":
+                                closed += 1
+                        except socket.timeout:
+                            pass
+                        except ConnectionResetError:
+                            closed += 1
+                    self.assertGreater(closed, 0)
+                finally:
+                    for client in clients:
+                        client.close()
+
+                # 자리가 나면 다시 정상적으로 받는다.
+                time.sleep(0.2)
+                with socket.create_connection(("127.0.0.1", port), timeout=2.0) as sock:
+                    sock.sendall(f"PASS {password}\r\nNICK after\r\nUSER after 0 * :After\r\n".encode())
+                    self.assertIn(" 001 ", recv_line(sock))
+        finally:
+            os.remove(config_path)
+
 
 if __name__ == "__main__":
     unittest.main()
@@ -0,0 +1,55 @@
+"""
+버전: v1.1.0
+관련 문서: design/server/v1.1.0-performance.md, CLONE_GUIDE.md
+테스트: 이 파일 자체
+설명: irc-bench 부하 생성기가 서버에 붙어 등록/JOIN을 마치고 메시지를 전달받아 처리량과 지연 백분위수를 JSON으로 보고하는지 확인한다.
+"""
+import json
+import os
+import subprocess
+import unittest
+
+from .utils import run_server
+
+REPO_ROOT = os.path.abspath(os.path.join(os.path.dirname(__file__), "..", ".."))
+BENCH_PATH = os.path.join(REPO_ROOT, "irc-bench")
+
+
+class IrcBenchTest(unittest.TestCase):
+    def test_reports_throughput_and_latency(self):
+        with run_server() as (_proc, port, password):
+            result = subprocess.run(
+                [
+                    BENCH_PATH,
+                    "--port", str(port),
+                    "--password", password,
+                    "--clients", "60",
+                    "--channels", "6",
+                    "--joins-per-client", "2",
+                    "--rate", "2000",
+                    "--duration", "1",
+                    "--warmup", "0.2",
+                    "--churn", "5",
+                    "--direct", "10",
+                    "--json",
+                ],
+                capture_output=True,
+                text=True,
+                timeout=30,
+            )
+            self.assertEqual(0, result.returncode, result.stderr)
+            report = json.loads(result.stdout)
+
+        self.assertEqual(0, report["disconnects"])
+        self.assertEqual(0, report["error_numerics"])
+        self.assertGreater(report["sent"], 1000)
+        # 채널 멤버가 20명이라 채널 메시지 한 번이 여러 줄로 전달된다.
+        self.assertGreater(report["delivered"], report["sent"])
+        self.assertGreater(report["delivered_per_s"], 0)
+        self.assertLessEqual(report["p50_us"], report["p99_us"])
+        self.assertLessEqual(report["p99_us"], report["p999_us"])
+        self.assertLessEqual(report["p999_us"], report["max_us"])
+
+
+if __name__ == "__main__":
+    unittest.main()
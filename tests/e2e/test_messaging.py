@@ -1,10 +1,12 @@
 """
-버전: v0.5.0
-관련 문서: design/protocol/contract.md, design/server/v0.5.0-messaging.md
+버전: v1.1.0
+관련 문서: design/protocol/contract.md, design/server/v0.5.0-messaging.md, design/server/v1.1.0-performance.md
 테스트: 이 파일 자체
-설명: PRIVMSG/NOTICE 라우팅과 NAMES/LIST numeric 응답을 검증한다.
+설명: PRIVMSG/NOTICE 라우팅과 전달 라인의 길이 제한, NAMES/LIST numeric 응답, LIST 필터와 큰 목록의 나눠 보내기를 검증한다.
 """
+import os
 import socket
+import tempfile
 import unittest
 
 from .utils import recv_line, run_server
@@ -31,6 +33,39 @@ class MessagingTest(unittest.TestCase):
                     self.assertTrue(msg.startswith(":alice!"))
                     self.assertIn("PRIVMSG bob :hello world", msg)
 
+    def test_relayed_privmsg_is_truncated_to_line_limit(self):
+        with run_server() as (_proc, port, password):
+            with socket.create_connection(("127.0.0.1", port), timeout=2.0) as sender:
+                register_client(sender, password, "alice")
+                with socket.create_connection(("127.0.0.1", port), timeout=2.0) as receiver:
+                    register_client(receiver, password, "bob")
+
+                    # 입력은 512바이트 안이지만 prefix를 붙이면 넘친다.
+                    text = "x" * (510 - len("PRIVMSG bob :"))
+                    sender.sendall(f"PRIVMSG bob :{text}\r\n".encode())
+                    msg = recv_line(receiver)
+                    self.assertTrue(msg.startswith(":alice!"))
+                    self.assertEqual(510, len(msg.encode()))
+                    sender.sendall(b"PRIVMSG bob :next\r\n")
+                    self.assertTrue(recv_line(receiver).endswith("PRIVMSG bob :next"))
+
+    def test_nick_lookup_uses_rfc1459_casemapping(self):
+        with run_server() as (_proc, port, password):
+            with socket.create_connection(("127.0.0.1", port), timeout=2.0) as receiver:
+                register_client(receiver, password, "Alice[1]")
+                with socket.create_connection(("127.0.0.1", port), timeout=2.0) as sender:
+                    register_client(sender, password, "carol")
+
+                    sender.sendall(b"PRIVMSG aLiCe{1} :case folded\r\n")
+                    msg = recv_line(receiver)
+                    self.assertTrue(msg.startswith(":carol!"))
+                    self.assertIn("PRIVMSG aLiCe{1} :case folded", msg)
+
+                    with socket.create_connection(("127.0.0.1", port), timeout=2.0) as dup:
+                        dup.sendall(f"PASS {password}\r\n".encode())
+                        dup.sendall(b"NICK ALICE[1]\r\n")
+                        self.assertIn(" 433 ", recv_line(dup))
+
     def test_privmsg_to_channel_broadcast(self):
         with run_server() as (_proc, port, password):
             with socket.create_connection(("127.0.0.1", port), timeout=2.0) as a:
@@ -97,6 +132,92 @@ class MessagingTest(unittest.TestCase):
                     self.assertIn("2", entry)
                     self.assertIn("323", end)
 
+    def test_list_filters_by_mask_and_user_count(self):
+        with run_server() as (_proc, port, password):
+            with socket.create_connection(("127.0.0.1", port), timeout=2.0) as a:
+                register_client(a, password, "filt1")
+                for channel in ["#alpha", "#alphabet", "#beta"]:
+                    a.sendall(f"JOIN {channel}\r\n".encode())
+                    recv_line(a)
+                with socket.create_connection(("127.0.0.1", port), timeout=2.0) as b:
+                    register_client(b, password, "filt2")
+                    b.sendall(b"JOIN #ALPHA\r\n")
+                    recv_line(b)
+                    recv_line(a)
+
+                    def list_names(command):
+                        a.sendall(command)
+                        self.assertIn("321", recv_line(a))
+                        names = []
+                        while True:
+                            line = recv_line(a)
+                            if " 323 " in line:
+                                return sorted(names)
+                            self.assertIn(" 322 ", line)
+                            names.append(line.split()[3])
+
+                    self.assertEqual(["#alpha", "#alphabet"], list_names(b"LIST #ALPHA*\r\n"))
+                    self.assertEqual(["#alpha"], list_names(b"LIST >1\r\n"))
+                    self.assertEqual(["#alphabet", "#beta"], list_names(b"LIST <2\r\n"))
+                    self.assertEqual(["#beta"], list_names(b"LIST <2 #b?ta,#zzz\r\n"))
+
+    def test_large_list_and_names_are_split_within_limits(self):
+        with tempfile.TemporaryDirectory() as tmp:
+            config_path = os.path.join(tmp, "server.ini")
+            with open(config_path, "w", encoding="utf-8") as file:
+                file.write("[limits]\n")
+                file.write("outbound_high_bytes=8192\n")
+                file.write("outbound_low_bytes=2048\n")
+
+            with run_server(config_path=config_path) as (_proc, port, password):
+                socks = []
+                try:
+                    owner = socket.create_connection(("127.0.0.1", port), timeout=3.0)
+                    socks.append(owner)
+                    register_client(owner, password, "owner")
+                    channels = [f"#stream{i:03d}" for i in range(300)]
+                    for channel in channels:
+                        owner.sendall(f"JOIN {channel}\r\n".encode())
+                        self.assertIn(f"JOIN {channel}", recv_line(owner))
+
+                    # 한 번에 만들면 high 워터마크(8KiB)를 넘는 LIST도 끊기지 않고 끝까지 온다.
+                    owner.sendall(b"LIST\r\n")
+                    self.assertIn("321", recv_line(owner))
+                    listed = []
+                    while True:
+                        line = recv_line(owner)
+                        self.assertNotEqual("", line, "LIST 도중 연결 종료")
+                        if " 323 " in line:
+                            break
+                        listed.append(line.split()[3])
+                    self.assertEqual(sorted(channels), sorted(listed))
+
+                    nicks = [f"member{i:02d}" for i in range(60)]
+                    for nick in nicks:
+                        sock = socket.create_connection(("127.0.0.1", port), timeout=3.0)
+                        socks.append(sock)
+                        register_client(sock, password, nick)
+                        sock.sendall(b"JOIN #stream000\r\n")
+                        recv_line(sock)
+                        recv_line(owner)
+
+                    owner.sendall(b"NAMES #stream000\r\n")
+                    named = []
+                    reply_lines = 0
+                    while True:
+                        line = recv_line(owner)
+                        if " 366 " in line:
+                            break
+                        self.assertIn(" 353 ", line)
+                        self.assertLessEqual(len(line.encode()) + 2, 512)
+                        reply_lines += 1
+                        named.extend(line.split(" :", 1)[1].split())
+                    self.assertGreater(reply_lines, 1)
+                    self.assertEqual(sorted(nicks + ["owner"]), sorted(named))
+                finally:
+                    for sock in socks:
+                        sock.close()
+
 
 if __name__ == "__main__":
     unittest.main()
@@ -0,0 +1,134 @@
+"""
+버전: v1.1.0
+관련 문서: design/protocol/contract.md, design/server/v1.1.0-performance.md
+테스트: 이 파일 자체
+설명: OPER로 얻은 운영자 권한으로 STATS 지표를 조회하고, 지표 유닉스 소켓이 Prometheus 텍스트를 내보내는지,
+      지표 소켓 경로에 일반 파일이 있으면 지우지 않고 기동에 실패하는지 확인한다.
+"""
+import os
+import socket
+import subprocess
+import tempfile
+import unittest
+
+from .utils import find_free_port, recv_line, run_server
+
+OPER_PASSWORD = "s3cret"
+
+
+def write_config(directory: str) -> tuple[str, str]:
+    socket_path = os.path.join(directory, "metrics.sock")
+    config_path = os.path.join(directory, "server.conf")
+    with open(config_path, "w") as f:
+        f.write("[server]\n")
+        f.write("name=modern-irc\n")
+        f.write(f"oper_password={OPER_PASSWORD}\n")
+        f.write("[logging]\n")
+        f.write("level=error\n")
+        f.write("file=-\n")
+        f.write("[metrics]\n")
+        f.write(f"socket={socket_path}\n")
+    return config_path, socket_path
+
+
+def register_client(sock: socket.socket, password: str, nick: str):
+    sock.sendall(f"PASS {password}\r\n".encode())
+    sock.sendall(f"NICK {nick}\r\n".encode())
+    sock.sendall(f"USER {nick} 0 * :Real {nick}\r\n".encode())
+    read_until(sock, " 001 ")
+
+
+def read_until(sock: socket.socket, marker: str) -> list[str]:
+    lines = []
+    while True:
+        line = recv_line(sock)
+        if not line:
+            raise AssertionError(f"연결이 끊겨 {marker!r}를 받지 못함: {lines}")
+        lines.append(line)
+        if marker in line:
+            return lines
+
+
+def read_metrics(path: str) -> str:
+    with socket.socket(socket.AF_UNIX, socket.SOCK_STREAM) as sock:
+        sock.settimeout(2.0)
+        sock.connect(path)
+        chunks = []
+        while True:
+            chunk = sock.recv(65536)
+            if not chunk:
+                break
+            chunks.append(chunk)
+    return b"".join(chunks).decode("utf-8")
+
+
+class MetricsTest(unittest.TestCase):
+    def test_stats_requires_oper(self):
+        with tempfile.TemporaryDirectory() as directory:
+            config_path, _socket_path = write_config(directory)
+            with run_server(config_path=config_path) as (_proc, port, password):
+                with socket.create_connection(("127.0.0.1", port), timeout=2.0) as client:
+                    register_client(client, password, "watcher")
+
+                    client.sendall(b"STATS m\r\n")
+                    self.assertIn(" 481 ", read_until(client, " 481 ")[-1])
+
+                    client.sendall(b"OPER watcher wrong\r\n")
+                    self.assertIn(" 464 ", read_until(client, " 464 ")[-1])
+
+                    client.sendall(f"OPER watcher {OPER_PASSWORD}\r\n".encode())
+                    self.assertIn(" 381 ", read_until(client, " 381 ")[-1])
+
+                    client.sendall(b"JOIN #metrics\r\n")
+                    read_until(client, " JOIN #metrics")
+
+                    client.sendall(b"STATS m\r\n")
+                    lines = read_until(client, " 219 ")
+                    join_lines = [line for line in lines if " 212 watcher JOIN 1 " in line]
+                    self.assertEqual(1, len(join_lines), lines)
+                    self.assertIn("p99=", join_lines[0])
+
+                    client.sendall(b"STATS z\r\n")
+                    lines = read_until(client, " 219 ")
+                    self.assertTrue(any(" 249 watcher connections 1" in line for line in lines), lines)
+
+    def test_metrics_socket_exports_prometheus_text(self):
+        with tempfile.TemporaryDirectory() as directory:
+            config_path, socket_path = write_config(directory)
+            with run_server(config_path=config_path) as (_proc, port, password):
+                with socket.create_connection(("127.0.0.1", port), timeout=2.0) as client:
+                    register_client(client, password, "scraped")
+                    client.sendall(b"JOIN #metrics\r\n")
+                    read_until(client, " JOIN #metrics")
+
+                    text = read_metrics(socket_path)
+
+        self.assertIn("# TYPE irc_commands_total counter\n", text)
+        self.assertIn('irc_commands_total{command="JOIN"} 1\n', text)
+        self.assertIn("# TYPE irc_command_duration_seconds summary\n", text)
+        self.assertIn('irc_command_duration_seconds_count{command="JOIN"} 1\n', text)
+        self.assertIn("irc_connections 1\n", text)
+        self.assertIn('irc_poll_wakeups_total{shard="0"} ', text)
+
+    def test_metrics_socket_refuses_to_replace_regular_file(self):
+        with tempfile.TemporaryDirectory() as directory:
+            config_path, socket_path = write_config(directory)
+            with open(socket_path, "w") as f:
+                f.write("keep me\n")
+
+            repo_root = os.path.abspath(os.path.join(os.path.dirname(__file__), "..", ".."))
+            proc = subprocess.run(
+                [os.path.join(repo_root, "modern-irc"), str(find_free_port()), "testpass", config_path],
+                stdout=subprocess.DEVNULL,
+                stderr=subprocess.PIPE,
+                timeout=5,
+            )
+
+            self.assertNotEqual(0, proc.returncode)
+            self.assertIn("지표 소켓 경로에 소켓이 아닌 파일이 있음", proc.stderr.decode("utf-8", errors="replace"))
+            with open(socket_path) as f:
+                self.assertEqual("keep me\n", f.read())
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -1,8 +1,8 @@
 """
-버전: v0.3.0
+버전: v1.1.0
 관련 문서: design/protocol/contract.md
 테스트: 이 파일 자체
-설명: 등록 전후 PING/PONG 응답과 파라미터 부족 에러를 확인한다.
+설명: 등록 전후 PING/PONG 응답, 파이프라인 입력 처리와 파라미터 부족 에러를 확인한다.
 """
 import socket
 import unittest
@@ -40,6 +40,16 @@ class PingTest(unittest.TestCase):
                 self.assertIn("409", pong_error)
                 self.assertIn(":출처 없음", pong_error)
 
+    def test_pipelined_pings_beyond_line_limit_in_one_send(self):
+        with run_server() as (_proc, port, _password):
+            with socket.create_connection(("127.0.0.1", port), timeout=2.0) as sock:
+                tokens = [f"token{idx:02d}-" + "p" * 48 for idx in range(12)]
+                payload = "".join(f"PING {token}\r\n" for token in tokens).encode()
+                self.assertGreater(len(payload), 512)
+                sock.sendall(payload)
+                for token in tokens:
+                    self.assertEqual(f"PONG {token}", recv_line(sock))
+
 
 if __name__ == "__main__":
     unittest.main()
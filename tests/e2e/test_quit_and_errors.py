@@ -1,10 +1,11 @@
 """
-버전: v0.3.0
-관련 문서: design/protocol/contract.md
+버전: v1.1.0
+관련 문서: design/protocol/contract.md, design/server/v1.1.0-performance.md
 테스트: 이 파일 자체
-설명: QUIT 종료와 미지원 명령/길이 초과 오류 처리를 검증한다.
+설명: QUIT 종료, 데이터와 함께 끊긴 연결의 정리, 미지원 명령/길이 초과 오류 처리를 검증한다.
 """
 import socket
+import time
 import unittest
 
 from .utils import recv_line, run_server
@@ -26,6 +27,24 @@ class QuitAndErrorTest(unittest.TestCase):
                 data = sock.recv(1024)
                 self.assertEqual(b"", data)
 
+    def test_half_close_with_data_releases_nick(self):
+        # 마지막 데이터와 FIN이 한 엣지에 도착해도 서버가 EOF를 보고 닉네임을 놓아야 한다.
+        with run_server() as (_proc, port, password):
+            ghost = socket.create_connection(("127.0.0.1", port), timeout=2.0)
+            ghost.sendall(f"PASS {password}\r\nNICK ghost\r\n".encode())
+            ghost.shutdown(socket.SHUT_WR)
+            ghost.close()
+
+            deadline = time.time() + 3.0
+            while True:
+                with socket.create_connection(("127.0.0.1", port), timeout=2.0) as sock:
+                    sock.sendall(f"PASS {password}\r\nNICK ghost\r\nUSER ghost 0 * :Ghost\r\n".encode())
+                    reply = recv_line(sock)
+                if " 001 " in reply or time.time() > deadline:
+                    break
+                time.sleep(0.1)
+            self.assertIn(" 001 ", reply)
+
     def test_unknown_command_after_registration(self):
         with run_server() as (_proc, port, password):
             with socket.create_connection(("127.0.0.1", port), timeout=2.0) as sock:
@@ -0,0 +1,87 @@
+"""
+버전: v1.1.0
+관련 문서: design/protocol/contract.md, design/server/v1.1.0-performance.md
+테스트: 이 파일 자체
+설명: [io] threads를 2 이상으로 줘도 채널/개인 메시지가 빠짐없이 순서대로 전달되는지 검증한다.
+      기본 빌드는 샤드 1개로 동작하고, IRC_EXPERIMENTAL_SHARDS 빌드에서는 샤드를 넘는 전달을 검증한다.
+"""
+import os
+import socket
+import tempfile
+import unittest
+
+from .utils import recv_line, run_server
+
+CLIENTS = 8
+
+
+def write_config(path, threads):
+    with open(path, "w", encoding="utf-8") as file:
+        file.write("[io]\n")
+        file.write(f"threads={threads}\n")
+        file.write("[limits]\n")
+        file.write("outbound_high_bytes=131072\n")
+
+
+def register_client(sock, password, nick):
+    sock.sendall(f"PASS {password}\r\n".encode())
+    sock.sendall(f"NICK {nick}\r\n".encode())
+    sock.sendall(f"USER {nick} 0 * :Real {nick}\r\n".encode())
+    recv_line(sock)
+
+
+def recv_until(sock, needle):
+    while True:
+        line = recv_line(sock)
+        if not line:
+            raise AssertionError(f"연결 종료: {needle} 대기 중")
+        if needle in line:
+            return line
+
+
+class ShardingTest(unittest.TestCase):
+    def test_messages_cross_shards_in_order(self):
+        with tempfile.TemporaryDirectory() as tmp:
+            config_path = os.path.join(tmp, "server.ini")
+            write_config(config_path, 4)
+
+            with run_server(config_path=config_path) as (_proc, port, password):
+                socks = []
+                try:
+                    for i in range(CLIENTS):
+                        sock = socket.create_connection(("127.0.0.1", port), timeout=3.0)
+                        socks.append(sock)
+                        register_client(sock, password, f"user{i}")
+                        sock.sendall(b"JOIN #shard\r\n")
+                        recv_until(sock, f"user{i}!")
+                        for earlier in socks[:-1]:
+                            recv_until(earlier, f":user{i}!")
+
+                    for n in range(20):
+                        socks[0].sendall(f"PRIVMSG #shard :seq {n}\r\n".encode())
+                    for sock in socks[1:]:
+                        for n in range(20):
+                            line = recv_until(sock, "PRIVMSG #shard")
+                            self.assertTrue(line.startswith(":user0!"))
+                            self.assertTrue(line.endswith(f":seq {n}"))
+
+                    for i, sock in enumerate(socks):
+                        target = (i + 1) % CLIENTS
+                        sock.sendall(f"PRIVMSG user{target} :from {i}\r\n".encode())
+                    for i, sock in enumerate(socks):
+                        source = (i - 1) % CLIENTS
+                        line = recv_until(sock, f"PRIVMSG user{i}")
+                        self.assertIn(f":from {source}", line)
+
+                    socks[3].sendall(b"QUIT\r\n")
+                    for i, sock in enumerate(socks):
+                        if i == 3:
+                            continue
+                        self.assertIn("PART #shard", recv_until(sock, ":user3!"))
+                finally:
+                    for sock in socks:
+                        sock.close()
+
+
+if __name__ == "__main__":
+    unittest.main()
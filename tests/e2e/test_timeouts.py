@@ -0,0 +1,60 @@
+"""
+버전: v1.1.0
+관련 문서: design/protocol/contract.md, design/server/v1.1.0-performance.md
+테스트: 이 파일 자체
+설명: [timeouts] 설정에 따른 등록 시간 초과, 서버 PING 전송과 PONG 응답 유무에 따른 연결 유지/종료를 확인한다.
+"""
+import os
+import socket
+import tempfile
+import unittest
+
+from .utils import recv_line, run_server
+
+
+def write_config(path):
+    with open(path, "w", encoding="utf-8") as file:
+        file.write("[timeouts]\n")
+        file.write("registration=1\n")
+        file.write("ping_interval=1\n")
+        file.write("pong=1\n")
+
+
+def register_client(sock, password, nick):
+    sock.sendall(f"PASS {password}\r\n".encode())
+    sock.sendall(f"NICK {nick}\r\n".encode())
+    sock.sendall(f"USER {nick} 0 * :Real {nick}\r\n".encode())
+    recv_line(sock)
+
+
+class TimeoutTest(unittest.TestCase):
+    def test_unregistered_connection_is_closed(self):
+        with tempfile.TemporaryDirectory() as tmp:
+            config_path = os.path.join(tmp, "server.ini")
+            write_config(config_path)
+            with run_server(config_path=config_path) as (_proc, port, _password):
+                with socket.create_connection(("127.0.0.1", port), timeout=4.0) as sock:
+                    sock.sendall(b"NICK lurker\r\n")
+                    self.assertEqual("", recv_line(sock))
+
+    def test_pong_keeps_connection_and_silence_closes_it(self):
+        with tempfile.TemporaryDirectory() as tmp:
+            config_path = os.path.join(tmp, "server.ini")
+            write_config(config_path)
+            with run_server(config_path=config_path) as (_proc, port, password):
+                with socket.create_connection(("127.0.0.1", port), timeout=4.0) as sock:
+                    register_client(sock, password, "alive")
+                    # 등록 기한이 지나도 PING에 답하는 동안은 연결이 유지된다.
+                    for _ in range(3):
+                        line = recv_line(sock)
+                        self.assertTrue(line.startswith("PING :"), line)
+                        token = line[len("PING :"):]
+                        sock.sendall(f"PONG :{token}\r\n".encode())
+
+                    line = recv_line(sock)
+                    self.assertTrue(line.startswith("PING :"), line)
+                    self.assertEqual("", recv_line(sock))
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -34,7 +34,7 @@ def wait_for_listen(host, port, timeout=5.0):
 
 
 @contextlib.contextmanager
-def run_server(password="testpass", config_path=None):
+def run_server(password="testpass", config_path=None, preexec_fn=None):
     repo_root = os.path.abspath(os.path.join(os.path.dirname(__file__), "..", ".."))
     server_path = os.path.join(repo_root, "modern-irc")
     port = find_free_port()
@@ -43,7 +43,7 @@ def run_server(password="testpass", config_path=None):
     if config_path:
         cmd.append(config_path)
 
-    proc = subprocess.Popen(cmd, stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+    proc = subprocess.Popen(cmd, stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL, preexec_fn=preexec_fn)
 
     try:
         if not wait_for_listen("127.0.0.1", port):
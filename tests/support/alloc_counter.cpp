@@ -0,0 +1,44 @@
+/*
+ * 설명: 스레드별 할당 계수기(전역 operator new/delete 교체)를 구현한다.
+ * 버전: v1.1.0
+ * 관련 문서: design/server/v1.1.0-performance.md
+ * 테스트: tests/unit/steady_state_alloc_test.cpp, make bench
+ */
+#include "alloc_counter.hpp"
+
+#include <cstdlib>
+#include <new>
+
+namespace {
+// 스레드마다 따로 세서 로거 스레드 같은 배경 스레드의 할당이 섞이지 않게 한다.
+thread_local std::uint64_t t_alloc_count = 0;
+thread_local std::uint64_t t_alloc_bytes = 0;
+
+void *CountedAllocate(std::size_t size) {
+    ++t_alloc_count;
+    t_alloc_bytes += size;
+    void *ptr = std::malloc(size == 0 ? 1 : size);
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+}  // namespace
+
+void *operator new(std::size_t size) { return CountedAllocate(size); }
+void *operator new[](std::size_t size) { return CountedAllocate(size); }
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete[](void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, std::size_t) noexcept { std::free(ptr); }
+
+namespace support {
+
+AllocationStats ThreadAllocations() {
+    AllocationStats stats;
+    stats.count = t_alloc_count;
+    stats.bytes = t_alloc_bytes;
+    return stats;
+}
+
+}  // namespace support
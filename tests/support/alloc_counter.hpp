@@ -0,0 +1,21 @@
+/*
+ * 설명: 전역 operator new/delete를 바꿔 스레드별 할당 횟수와 바이트를 센다. 벤치마크와 할당 횟수 테스트 바이너리에만 링크한다.
+ * 버전: v1.1.0
+ * 관련 문서: design/server/v1.1.0-performance.md
+ * 테스트: tests/unit/steady_state_alloc_test.cpp, make bench
+ */
+#pragma once
+
+#include <cstdint>
+
+namespace support {
+
+// 부르는 스레드가 시작 후 operator new로 받은 횟수와 바이트 합.
+struct AllocationStats {
+    std::uint64_t count;
+    std::uint64_t bytes;
+};
+
+AllocationStats ThreadAllocations();
+
+}  // namespace support
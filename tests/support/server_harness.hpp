@@ -0,0 +1,139 @@
+/*
+ * 설명: PollServer의 friend로서 리액터 대기 없이 샤드 0을 부르는 스레드에서 직접 돌린다. 벤치마크와 할당 횟수 테스트가 함께 쓴다.
+ * 버전: v1.1.0
+ * 관련 문서: design/server/v1.1.0-performance.md
+ * 테스트: tests/unit/steady_state_alloc_test.cpp, tests/bench/hot_path_bench.cpp
+ */
+#pragma once
+
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "server.hpp"
+
+// 클라이언트는 socketpair 한 쌍으로 만들고, 서버 쪽 fd를 수락한 연결처럼 올린다.
+class ServerHarness {
+   public:
+    explicit ServerHarness(const config::Settings &settings = DefaultSettings())
+        : server_(0, "harness", settings, ""), received_lines_(0) {
+        server_.SetupShards();
+        server_.EnterShard(*server_.shards_[0]);
+    }
+
+    ~ServerHarness() {
+        for (std::size_t i = 0; i < peer_fds_.size(); ++i) {
+            close(peer_fds_[i]);
+        }
+    }
+
+    ServerHarness(const ServerHarness &) = delete;
+    ServerHarness &operator=(const ServerHarness &) = delete;
+
+    // 등록까지 마친 클라이언트를 하나 붙이고 번호를 돌려준다. 환영 응답은 읽어 버린다.
+    std::size_t Connect(const std::string &nick) {
+        int pair[2];
+        if (socketpair(AF_UNIX, SOCK_STREAM, 0, pair) < 0) {
+            throw std::runtime_error("socketpair 실패");
+        }
+        fcntl(pair[0], F_SETFL, fcntl(pair[0], F_GETFL, 0) | O_NONBLOCK);
+        fcntl(pair[1], F_SETFL, fcntl(pair[1], F_GETFL, 0) | O_NONBLOCK);
+        if (!server_.AdoptClient(*server_.shards_[0], pair[0])) {
+            throw std::runtime_error("연결 등록 실패");
+        }
+        server_fds_.push_back(pair[0]);
+        peer_fds_.push_back(pair[1]);
+        const std::size_t client = peer_fds_.size() - 1;
+        Feed(client, "PASS harness\r\nNICK " + nick + "\r\nUSER " + nick + " 0 * :" + nick + "\r\n");
+        Flush();
+        Drain();
+        return client;
+    }
+
+    // 클라이언트가 data를 보낸 것처럼 쓰고, 서버가 읽기 이벤트를 받은 것처럼 처리시킨다.
+    // 읽기 예산 때문에 미룬 부분도 이벤트 루프가 여러 바퀴 도는 것처럼 끝까지 처리한다.
+    void Feed(std::size_t client, std::string_view data) {
+        Write(client, data);
+        Read(client);
+        while (!server_.shards_[0]->read_backlog.empty()) {
+            Tick();
+        }
+    }
+
+    // 클라이언트 소켓에 쓰기만 한다.
+    void Write(std::size_t client, std::string_view data) {
+        if (write(peer_fds_[client], data.data(), data.size()) != static_cast<ssize_t>(data.size())) {
+            throw std::runtime_error("입력 쓰기 실패");
+        }
+    }
+
+    // 이 클라이언트에 읽기 이벤트가 한 번 온 것처럼 처리한다(예산을 넘는 부분은 미룬다).
+    void Read(std::size_t client) { server_.HandleClientRead(server_fds_[client]); }
+
+    // 이벤트 루프 한 바퀴의 끝처럼 지난 바퀴에 미룬 읽기를 한 번씩 처리한다.
+    void Tick() {
+        EventShard &shard = *server_.shards_[0];
+        shard.read_serving.swap(shard.read_backlog);
+        server_.ServeReadBacklog(shard);
+    }
+
+    std::size_t deferred_reads() const { return server_.shards_[0]->read_backlog.size(); }
+
+    // 쓰기 이벤트가 온 것처럼 큐가 남은 연결을 모두 비운다.
+    void Flush() {
+        for (std::size_t i = 0; i < server_fds_.size(); ++i) {
+            if (!server_.clients_.Io(server_fds_[i]).outbound.empty()) {
+                server_.HandleClientWrite(server_fds_[i]);
+            }
+        }
+        server_.ReapPendingCloses();
+    }
+
+    // 모든 클라이언트 소켓에 온 응답을 읽어 줄 수만 센다.
+    void Drain() {
+        char buffer[65536];
+        for (std::size_t i = 0; i < peer_fds_.size(); ++i) {
+            ssize_t n;
+            while ((n = read(peer_fds_[i], buffer, sizeof(buffer))) > 0) {
+                received_lines_ += static_cast<std::uint64_t>(std::count(buffer, buffer + n, '\n'));
+            }
+        }
+    }
+
+    std::uint64_t received_lines() const { return received_lines_; }
+    void ResetReceived() { received_lines_ = 0; }
+
+    // 로그는 오류만, 이벤트 루프는 하나로 둔다.
+    static config::Settings DefaultSettings() {
+        config::Settings settings;
+        settings.log_level = config::LogLevel::kError;
+        settings.io_threads = 1;
+        return settings;
+    }
+
+    // 클라이언트 소켓에 지금까지 온 응답을 읽어 돌려준다(줄 수도 센다).
+    std::string Receive(std::size_t client) {
+        std::string out;
+        char buffer[65536];
+        ssize_t n;
+        while ((n = read(peer_fds_[client], buffer, sizeof(buffer))) > 0) {
+            out.append(buffer, static_cast<std::size_t>(n));
+            received_lines_ += static_cast<std::uint64_t>(std::count(buffer, buffer + n, '\n'));
+        }
+        return out;
+    }
+
+   private:
+
+    PollServer server_;
+    std::vector<int> server_fds_;
+    std::vector<int> peer_fds_;
+    std::uint64_t received_lines_;
+};
@@ -0,0 +1,80 @@
+/*
+ * 설명: 아레나가 정렬을 지켜 메모리를 내주고, 블록이 모자라면 블록을 붙이며, Reset 뒤에는 붙인 블록을 다시 써 새 블록을 만들지 않는지 확인한다.
+ * 버전: v1.1.0
+ * 관련 문서: design/server/v1.1.0-performance.md
+ * 테스트: 이 파일 자체
+ */
+#include "net/arena.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+// 받은 메모리를 끝까지 써 보아 크기만큼 내줬는지 확인한다.
+void Fill(net::Arena &arena, std::size_t bytes) {
+    void *ptr = arena.allocate(bytes, 8);
+    assert(ptr != nullptr);
+    std::memset(ptr, 0x5a, bytes);
+}
+
+void TestBumpAndAlignment() {
+    net::Arena arena(256);
+    char *a = static_cast<char *>(arena.allocate(3, 1));
+    std::uint64_t *b = static_cast<std::uint64_t *>(arena.allocate(sizeof(std::uint64_t), alignof(std::uint64_t)));
+    assert(reinterpret_cast<std::uintptr_t>(b) % alignof(std::uint64_t) == 0);
+    assert(reinterpret_cast<char *>(b) > a);
+    std::memcpy(a, "abc", 3);
+    *b = 42;
+    assert(std::memcmp(a, "abc", 3) == 0);
+    assert(arena.used() == 3 + sizeof(std::uint64_t));
+    assert(arena.block_count() == 1);
+}
+
+void TestGrowsAndReusesBlocksAfterReset() {
+    net::Arena arena(64);
+    for (int i = 0; i < 10; ++i) {
+        Fill(arena, 40);
+    }
+    // 64바이트 블록에 40바이트는 하나씩만 들어가고, 블록보다 큰 요청은 전용 블록을 받는다.
+    Fill(arena, 1000);
+    const std::size_t blocks = arena.block_count();
+    assert(blocks == 11);
+    assert(arena.high_water() == 10 * 40 + 1000);
+
+    arena.Reset();
+    assert(arena.used() == 0);
+    for (int i = 0; i < 10; ++i) {
+        Fill(arena, 40);
+    }
+    Fill(arena, 1000);
+    assert(arena.block_count() == blocks);
+    assert(arena.high_water() == 10 * 40 + 1000);
+}
+
+void TestPmrContainers() {
+    net::Arena arena(1024);
+    {
+        net::ArenaScope scope(arena);
+        std::pmr::string text("a string that does not fit the small buffer", &arena);
+        std::pmr::vector<int> numbers(&arena);
+        for (int i = 0; i < 50; ++i) {
+            numbers.push_back(i);
+        }
+        text += " and grows";
+        assert(text == "a string that does not fit the small buffer and grows");
+        assert(numbers[49] == 49);
+        assert(arena.used() > 0);
+    }
+    assert(arena.used() == 0);
+}
+}  // namespace
+
+int main() {
+    TestBumpAndAlignment();
+    TestGrowsAndReusesBlocksAfterReset();
+    TestPmrContainers();
+    return 0;
+}
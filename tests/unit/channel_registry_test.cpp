@@ -0,0 +1,111 @@
+/*
+ * 설명: 채널 레지스트리가 대소문자 무시로 이름을 인터닝/재사용하고, 멤버 배열이 정렬과 운영자 수를 유지하며, 나눠 훑기와 LIST 마스크 비교가 맞는지 확인한다.
+ * 버전: v1.1.0
+ * 관련 문서: design/protocol/contract.md, design/server/v1.1.0-performance.md
+ * 테스트: 이 파일 자체
+ */
+#include "state/channel_registry.hpp"
+
+#include <cassert>
+#include <string>
+
+namespace {
+struct Channel {
+    std::string topic;
+};
+
+void TestInternIsCaseInsensitive() {
+    state::ChannelRegistry<Channel> registry;
+    state::ChannelId id = registry.FindOrCreate("#Room[1]");
+    assert(id != state::kNoChannel);
+    assert(registry.FindOrCreate("#ROOM{1}") == id);
+    assert(registry.Find("#room[1]") == id);
+    assert(registry.Name(id) == "#Room[1]");
+    assert(registry.Find("#other") == state::kNoChannel);
+    assert(registry.Size() == 1);
+}
+
+void TestErasedIdIsReused() {
+    state::ChannelRegistry<Channel> registry;
+    state::ChannelId first = registry.FindOrCreate("#a");
+    state::ChannelId second = registry.FindOrCreate("#b");
+    registry.Get(first).topic = "old";
+    registry.Erase(first);
+    assert(!registry.IsLive(first));
+    assert(registry.Find("#a") == state::kNoChannel);
+
+    state::ChannelId reused = registry.FindOrCreate("#c");
+    assert(reused == first);
+    assert(registry.Get(reused).topic.empty());
+    assert(registry.Name(reused) == "#c");
+    assert(registry.IsLive(second));
+
+    std::size_t visited = 0;
+    registry.ForEach([&](state::ChannelId, const std::string &, const Channel &) { ++visited; });
+    assert(visited == 2);
+}
+
+void TestMemberListKeepsOrderAndOperatorCount() {
+    state::MemberList members;
+    assert(members.Insert(9, 0));
+    assert(members.Insert(3, state::kMemberOperator));
+    assert(members.Insert(5, 0));
+    assert(!members.Insert(5, state::kMemberOperator));
+    assert(members.size() == 3);
+    assert(members[0].fd == 3 && members[1].fd == 5 && members[2].fd == 9);
+    assert(members.OperatorCount() == 1);
+    assert(members.HasFlag(3, state::kMemberOperator));
+    assert(!members.HasFlag(5, state::kMemberOperator));
+
+    members.SetFlag(9, state::kMemberOperator, true);
+    members.SetFlag(9, state::kMemberOperator, true);
+    assert(members.OperatorCount() == 2);
+    members.SetFlag(3, state::kMemberOperator, false);
+    assert(members.OperatorCount() == 1);
+
+    assert(members.Erase(9));
+    assert(!members.Erase(9));
+    assert(members.OperatorCount() == 0);
+    assert(members.Contains(3) && members.Contains(5) && !members.Contains(9));
+}
+void TestResumableIteration() {
+    state::ChannelRegistry<Channel> registry;
+    state::ChannelId a = registry.FindOrCreate("#a");
+    state::ChannelId b = registry.FindOrCreate("#b");
+    state::ChannelId c = registry.FindOrCreate("#c");
+    registry.Erase(b);
+    assert(registry.NextLive(state::kNoChannel) == a);
+    assert(registry.NextLive(a) == c);
+    assert(registry.NextLive(c) == state::kNoChannel);
+
+    state::MemberList members;
+    members.Insert(4, 0);
+    members.Insert(8, 0);
+    members.Insert(6, 0);
+    assert(members.LowerBound(0) == 0);
+    assert(members.LowerBound(5) == 1);
+    assert(members.LowerBound(6) == 1);
+    assert(members.LowerBound(9) == 3);
+}
+
+void TestMatchMask() {
+    assert(state::MatchMask("#room", "#ROOM"));
+    assert(state::MatchMask("#team[*]", "#TEAM{dev}"));
+    assert(state::MatchMask("*", "#anything"));
+    assert(state::MatchMask("#a*b*c", "#aXXbYYc"));
+    assert(state::MatchMask("#?", "#x"));
+    assert(!state::MatchMask("#?", "#xy"));
+    assert(!state::MatchMask("#a*b", "#acd"));
+    assert(!state::MatchMask("#room", "#room2"));
+    assert(state::MatchMask("#room*", "#room"));
+}
+}  // namespace
+
+int main() {
+    TestInternIsCaseInsensitive();
+    TestErasedIdIsReused();
+    TestMemberListKeepsOrderAndOperatorCount();
+    TestResumableIteration();
+    TestMatchMask();
+    return 0;
+}
@@ -1,7 +1,7 @@
 /*
  * 설명: INI 설정 파서가 기본값과 사용자 지정 값을 올바르게 해석하는지 확인한다.
- * 버전: v0.9.0
- * 관련 문서: design/protocol/contract.md, design/server/v0.8.0-config-logging.md, design/server/v0.9.0-defensive.md
+ * 버전: v1.1.0
+ * 관련 문서: design/protocol/contract.md, design/server/v0.8.0-config-logging.md, design/server/v0.9.0-defensive.md, design/server/v1.1.0-performance.md
  * 테스트: 이 파일 자체
  */
 #include "utils/config.hpp"
@@ -21,7 +21,28 @@ void TestDefaultsWhenFileMissing() {
     assert(settings.log_level == config::LogLevel::kInfo);
     assert(settings.log_file.empty());
     assert(settings.messages_per_5s == 0);
-    assert(settings.outbound_lines == 16);
+    assert(settings.joins_per_5s == 0);
+    assert(settings.nicks_per_5s == 0);
+    assert(settings.outbound_high_bytes == 256 * 1024);
+    assert(settings.outbound_low_bytes == 64 * 1024);
+    assert(settings.outbound_total_bytes == 256 * 1024 * 1024);
+    assert(settings.outbound_pool_bytes == 16 * 1024 * 1024);
+    assert(settings.io_backend == config::IoBackend::kEpoll);
+    assert(settings.write_budget_bytes == 64 * 1024);
+    assert(settings.read_buffer_bytes == 4096);
+    assert(settings.read_budget_bytes == 16 * 1024);
+    assert(settings.read_budget_lines == 64);
+    assert(settings.io_threads == 1);
+    assert(settings.socket_sndbuf == 0);
+    assert(settings.tcp_nodelay);
+    assert(settings.tcp_keepalive);
+    assert(settings.listen_backlog == 511);
+    assert(settings.registration_timeout == 60);
+    assert(settings.ping_interval == 120);
+    assert(settings.pong_timeout == 60);
+    assert(settings.send_stall_timeout == 60);
+    assert(settings.oper_password.empty());
+    assert(settings.metrics_socket.empty());
 }
 
 void TestParseCustomValues() {
@@ -29,12 +50,40 @@ void TestParseCustomValues() {
     std::ofstream file(path.c_str());
     file << "[server]\n";
     file << "name=custom-irc\n";
+    file << "oper_password=s3cret\n";
+    file << "[metrics]\n";
+    file << "socket=/tmp/irc.metrics\n";
     file << "[logging]\n";
     file << "level=warn\n";
     file << "file=logs/server.log\n";
     file << "[limits]\n";
     file << "messages_per_5s=15\n";
-    file << "outbound_lines=10\n";
+    file << "joins_per_5s=3\n";
+    file << "nicks_per_5s=2\n";
+    file << "outbound_high_bytes=10000\n";
+    file << "outbound_low_bytes=2000\n";
+    file << "outbound_total_bytes=0\n";
+    file << "outbound_pool_bytes=8192\n";
+    file << "[io]\n";
+    file << "backend=POLL\n";
+    file << "write_budget_bytes=4096\n";
+    file << "read_buffer_bytes=8192\n";
+    file << "read_budget_bytes=32768\n";
+    file << "read_budget_lines=16\n";
+    file << "threads=4\n";
+    file << "[socket]\n";
+    file << "sndbuf=262144\n";
+    file << "rcvbuf=131072\n";
+    file << "tcp_nodelay=off\n";
+    file << "notsent_lowat=16384\n";
+    file << "keepalive=no\n";
+    file << "keepalive_idle=60\n";
+    file << "backlog=1024\n";
+    file << "[timeouts]\n";
+    file << "registration=10\n";
+    file << "ping_interval=0\n";
+    file << "pong=5\n";
+    file << "send_stall=7\n";
     file.close();
 
     config::Settings settings;
@@ -46,7 +95,48 @@ void TestParseCustomValues() {
     assert(settings.log_level == config::LogLevel::kWarn);
     assert(settings.log_file == "logs/server.log");
     assert(settings.messages_per_5s == 15);
-    assert(settings.outbound_lines == 10);
+    assert(settings.joins_per_5s == 3);
+    assert(settings.nicks_per_5s == 2);
+    assert(settings.outbound_high_bytes == 10000);
+    assert(settings.outbound_low_bytes == 2000);
+    assert(settings.outbound_total_bytes == 0);
+    assert(settings.outbound_pool_bytes == 8192);
+    assert(settings.io_backend == config::IoBackend::kPoll);
+    assert(settings.write_budget_bytes == 4096);
+    assert(settings.read_buffer_bytes == 8192);
+    assert(settings.read_budget_bytes == 32768);
+    assert(settings.read_budget_lines == 16);
+    assert(settings.io_threads == 4);
+    assert(settings.socket_sndbuf == 262144);
+    assert(settings.socket_rcvbuf == 131072);
+    assert(!settings.tcp_nodelay);
+    assert(settings.tcp_notsent_lowat == 16384);
+    assert(!settings.tcp_keepalive);
+    assert(settings.tcp_keepalive_idle == 60);
+    assert(settings.listen_backlog == 1024);
+    assert(settings.registration_timeout == 10);
+    assert(settings.ping_interval == 0);
+    assert(settings.pong_timeout == 5);
+    assert(settings.send_stall_timeout == 7);
+    assert(settings.oper_password == "s3cret");
+    assert(settings.metrics_socket == "/tmp/irc.metrics");
+
+    std::remove(path.c_str());
+}
+
+void TestLegacyOutboundLinesMapsToBytes() {
+    const std::string path = "tests/unit/legacy_outbound.ini";
+    std::ofstream file(path.c_str());
+    file << "[limits]\n";
+    file << "outbound_lines=8\n";
+    file.close();
+
+    config::Settings settings;
+    std::string error;
+    bool ok = config::LoadFromFile(path, settings, error);
+    assert(ok);
+    assert(settings.outbound_high_bytes == 8 * 512);
+    assert(settings.outbound_low_bytes == 64 * 1024);
 
     std::remove(path.c_str());
 }
@@ -67,10 +157,45 @@ void TestRejectInvalid() {
     std::remove(path.c_str());
 }
 
+void TestRejectUnknownBackend() {
+    const std::string path = "tests/unit/bad_backend.ini";
+    std::ofstream file(path.c_str());
+    file << "[io]\n";
+    file << "backend=kqueue\n";
+    file.close();
+
+    config::Settings settings;
+    std::string error;
+    bool ok = config::LoadFromFile(path, settings, error);
+    assert(!ok);
+    assert(error.find("io.backend") != std::string::npos);
+
+    std::remove(path.c_str());
+}
+
+void TestRejectInvalidSocketFlag() {
+    const std::string path = "tests/unit/bad_socket.ini";
+    std::ofstream file(path.c_str());
+    file << "[socket]\n";
+    file << "tcp_nodelay=maybe\n";
+    file.close();
+
+    config::Settings settings;
+    std::string error;
+    bool ok = config::LoadFromFile(path, settings, error);
+    assert(!ok);
+    assert(error.find("socket.tcp_nodelay") != std::string::npos);
+
+    std::remove(path.c_str());
+}
+
 int main() {
     TestDefaultsWhenFileMissing();
     TestParseCustomValues();
+    TestLegacyOutboundLinesMapsToBytes();
     TestRejectInvalid();
+    TestRejectUnknownBackend();
+    TestRejectInvalidSocketFlag();
     return 0;
 }
 
@@ -0,0 +1,98 @@
+/*
+ * 설명: 연결 슬랩이 fd 재사용을 세대 번호로 구별하고 닫힌 슬롯을 제자리에서 기본값으로 되돌리는지(용량은 유지) 확인한다.
+ * 버전: v1.1.0
+ * 관련 문서: design/server/v1.1.0-performance.md
+ * 테스트: 이 파일 자체
+ */
+#include "state/connection_table.hpp"
+
+#include <cassert>
+#include <string>
+
+namespace {
+struct Hot {
+    int queued;
+    Hot() : queued(0) {}
+    void Reset() { queued = 0; }
+};
+
+struct Cold {
+    std::string nick;
+    void Reset() { nick.clear(); }
+};
+
+typedef state::ConnectionTable<Hot, Cold> Table;
+
+void TestInsertAndErase() {
+    Table table;
+    assert(!table.Contains(7));
+    state::ConnectionHandle handle = table.Insert(7);
+    assert(table.Contains(7));
+    assert(!table.Contains(3));
+    assert(table.Size() == 1);
+    assert(table.IsCurrent(handle));
+
+    table.Io(7).queued = 5;
+    table.Session(7).nick = "alice";
+    table.Erase(7);
+    assert(!table.Contains(7));
+    assert(table.Size() == 0);
+    assert(!table.IsCurrent(handle));
+    assert(!table.IsCurrent(table.HandleOf(7)));
+}
+
+void TestReusedFdIsNotMistakenForOldConnection() {
+    Table table;
+    state::ConnectionHandle old_handle = table.Insert(4);
+    table.Session(4).nick = "old";
+    table.Erase(4);
+
+    // 닫힌 슬롯을 건드린 흔적이 있어도 새 연결은 기본값에서 시작한다.
+    table.Session(4).nick = "stale";
+    state::ConnectionHandle new_handle = table.Insert(4);
+    assert(new_handle.fd == old_handle.fd);
+    assert(new_handle.generation != old_handle.generation);
+    assert(!table.IsCurrent(old_handle));
+    assert(table.IsCurrent(new_handle));
+    assert(table.Session(4).nick.empty());
+    assert(table.Io(4).queued == 0);
+}
+
+void TestResetKeepsCapacity() {
+    Table table;
+    table.Insert(5);
+    table.Session(5).nick.assign(200, 'n');
+    const std::size_t capacity = table.Session(5).nick.capacity();
+    const char *storage = table.Session(5).nick.data();
+    table.Erase(5);
+    table.Insert(5);
+    // 새 객체로 갈아 끼우지 않고 비우기만 하므로 다음 연결이 버퍼를 그대로 쓴다.
+    assert(table.Session(5).nick.empty());
+    assert(table.Session(5).nick.capacity() == capacity);
+    assert(table.Session(5).nick.data() == storage);
+}
+
+void TestReferencesSurviveGrowth() {
+    Table table;
+    table.Reserve(10);
+    assert(table.Capacity() >= 10);
+    table.Insert(2);
+    Hot &io = table.Io(2);
+    io.queued = 3;
+    // 디렉터리 밖의 fd를 넣어도 기존 청크는 옮겨지지 않는다.
+    table.Insert(static_cast<int>(Table::kChunkSlots) * 4 + 1);
+    assert(&table.Io(2) == &io);
+    assert(table.Io(2).queued == 3);
+    assert(table.Capacity() > Table::kChunkSlots * 4);
+    assert(!table.Contains(static_cast<int>(Table::kChunkSlots) * 2));
+    assert(!table.Contains(-1));
+}
+}  // namespace
+
+int main() {
+    TestInsertAndErase();
+    TestReusedFdIsNotMistakenForOldConnection();
+    TestResetKeepsCapacity();
+    TestReferencesSurviveGrowth();
+    return 0;
+}
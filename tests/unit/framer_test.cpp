@@ -1,14 +1,95 @@
 /*
- * 설명: CRLF 프레이밍 유틸리티가 조각난 입력을 처리하는지 확인한다.
- * 버전: v0.1.0
- * 관련 문서: design/protocol/contract.md
+ * 설명: CRLF 프레이밍 유틸리티와 입력 링이 조각난 입력, 파이프라인 입력, 길이 초과를 처리하는지 확인한다.
+ * 버전: v1.1.0
+ * 관련 문서: design/protocol/contract.md, design/server/v1.1.0-performance.md
  * 테스트: 이 파일 자체
  */
 #include <cassert>
+#include <cstring>
 #include <string>
+#include <vector>
 
 #include "protocol/framer.hpp"
 
+namespace {
+// recv()처럼 링의 빈 영역에 들어가는 만큼만 복사하고 복사한 바이트 수를 돌려준다.
+std::size_t Feed(protocol::InputRing &ring, const std::string &data, std::size_t offset) {
+    std::size_t room = ring.WritableSize();
+    std::size_t n = data.size() - offset < room ? data.size() - offset : room;
+    std::memcpy(ring.WritePtr(), data.data() + offset, n);
+    ring.Commit(n);
+    return n;
+}
+
+void TestRingFragmentedInput() {
+    protocol::InputRing ring(512, 512);
+    std::string_view line;
+    Feed(ring, "PING", 0);
+    assert(ring.NextLine(line) == protocol::FrameStatus::kNeedMore);
+
+    Feed(ring, " test\r", 0);
+    assert(ring.NextLine(line) == protocol::FrameStatus::kNeedMore);
+
+    Feed(ring, "\nPONG\r\n", 0);
+    assert(ring.NextLine(line) == protocol::FrameStatus::kLine);
+    assert(line == "PING test");
+    assert(ring.NextLine(line) == protocol::FrameStatus::kLine);
+    assert(line == "PONG");
+    assert(ring.NextLine(line) == protocol::FrameStatus::kNeedMore);
+    assert(ring.Size() == 0);
+}
+
+void TestRingBareLineFeedIsContent() {
+    protocol::InputRing ring(512, 512);
+    std::string_view line;
+    Feed(ring, "a\nb\r\n", 0);
+    assert(ring.NextLine(line) == protocol::FrameStatus::kLine);
+    assert(line == "a\nb");
+}
+
+void TestRingPipelinedInput() {
+    std::string data;
+    for (int i = 0; i < 1000; ++i) {
+        data += "PING :token" + std::to_string(i) + "\r\n";
+    }
+
+    protocol::InputRing ring(512, 512);
+    std::vector<std::string> lines;
+    std::size_t offset = 0;
+    while (offset < data.size()) {
+        offset += Feed(ring, data, offset);
+        std::string_view line;
+        protocol::FrameStatus status;
+        while ((status = ring.NextLine(line)) == protocol::FrameStatus::kLine) {
+            lines.push_back(std::string(line));
+        }
+        assert(status == protocol::FrameStatus::kNeedMore);
+    }
+    assert(lines.size() == 1000);
+    assert(lines[0] == "PING :token0");
+    assert(lines[999] == "PING :token999");
+}
+
+void TestRingLineTooLong() {
+    protocol::InputRing ring(512, 512);
+    std::string_view line;
+    Feed(ring, std::string(513, 'x'), 0);
+    assert(ring.NextLine(line) == protocol::FrameStatus::kTooLong);
+    assert(ring.Size() == 0);
+
+    // CRLF 포함 513바이트 라인도 거부한다.
+    protocol::InputRing crlf_ring(512, 512);
+    Feed(crlf_ring, std::string(511, 'y') + "\r\n", 0);
+    assert(crlf_ring.NextLine(line) == protocol::FrameStatus::kTooLong);
+
+    // CRLF 포함 512바이트는 허용한다.
+    protocol::InputRing max_ring(512, 512);
+    Feed(max_ring, std::string(510, 'z') + "\r\n", 0);
+    assert(max_ring.NextLine(line) == protocol::FrameStatus::kLine);
+    assert(line.size() == 510);
+}
+}  // namespace
+
 int main() {
     std::string buffer;
     buffer.append("PING");
@@ -29,5 +110,10 @@ int main() {
     assert(res3.lines.empty());
     assert(long_buffer.empty());
 
+    TestRingFragmentedInput();
+    TestRingBareLineFeedIsContent();
+    TestRingPipelinedInput();
+    TestRingLineTooLong();
+
     return 0;
 }
@@ -0,0 +1,47 @@
+/*
+ * 설명: 라인 빌더가 조각을 이어 붙이고 CRLF를 더해 내보내며, 512바이트 라인 정책을 넘는 부분은 잘라 내는지 확인한다.
+ * 버전: v1.1.0
+ * 관련 문서: design/server/v1.1.0-performance.md
+ * 테스트: 이 파일 자체
+ */
+#include "net/line_builder.hpp"
+
+#include <cassert>
+#include <string>
+#include <string_view>
+
+namespace {
+void TestAppendAndFinish() {
+    net::LineBuilder line;
+    line.Append(":irc.local").Append(' ').Append("001").Append(' ').Append("nick").Append(" :n=");
+    line.AppendNumber(0).Append('/').AppendNumber(18446744073709551615ull);
+    assert(line.View() == ":irc.local 001 nick :n=0/18446744073709551615");
+    assert(!line.truncated());
+
+    assert(line.Finish() == ":irc.local 001 nick :n=0/18446744073709551615\r\n");
+    // Finish 후에도 이어서 쓸 수 있다. 덧붙인 글자가 앞서 붙인 CRLF를 덮는다.
+    line.Append("!");
+    assert(line.View() == ":irc.local 001 nick :n=0/18446744073709551615!");
+    assert(line.Finish() == ":irc.local 001 nick :n=0/18446744073709551615!\r\n");
+}
+
+void TestTruncatesToLinePolicy() {
+    net::LineBuilder line;
+    line.Append(std::string(300, 'a')).Append(std::string(300, 'b'));
+    assert(line.truncated());
+    assert(line.size() == net::LineBuilder::kMaxContent);
+    line.Append('c');
+    assert(line.size() == net::LineBuilder::kMaxContent);
+
+    const std::string_view framed = line.Finish();
+    assert(framed.size() == net::LineBuilder::kMaxLine);
+    assert(framed.substr(framed.size() - 2) == "\r\n");
+    assert(framed[299] == 'a' && framed[300] == 'b');
+}
+}  // namespace
+
+int main() {
+    TestAppendAndFinish();
+    TestTruncatesToLinePolicy();
+    return 0;
+}
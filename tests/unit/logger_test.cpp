@@ -0,0 +1,185 @@
+/*
+ * 설명: 단일 생산자 링의 순서/용량 동작과, 비동기 로거가 꺼진 레벨의 식을 평가하지 않고 여러 스레드의 라인을 파일에 모두 쓰며 넘친 라인은 세어 알리는지,
+ *       유휴 중에는 백그라운드 스레드가 깨어나지 않다가 새 라인이 들어오면 Flush 없이도 쓰는지 확인한다.
+ * 버전: v1.1.0
+ * 관련 문서: design/server/v1.1.0-performance.md
+ * 테스트: 이 파일 자체
+ */
+#include "net/spsc_ring.hpp"
+#include "utils/logger.hpp"
+
+#include <unistd.h>
+
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+std::vector<std::string> ReadLines(const std::string &path) {
+    std::ifstream file(path.c_str());
+    std::vector<std::string> lines;
+    std::string line;
+    while (std::getline(file, line)) {
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+std::string TempPath(const char *name) {
+    return std::string("/tmp/modern_irc_") + name + "_" + std::to_string(getpid()) + ".log";
+}
+
+void TestRingKeepsOrderAndCapacity() {
+    net::SpscRing<int> ring(3);
+    assert(ring.Capacity() == 4);
+    for (int i = 0; i < 4; ++i) {
+        int value = i;
+        assert(ring.TryPush(value));
+    }
+    int extra = 99;
+    assert(!ring.TryPush(extra));
+    assert(extra == 99);
+
+    std::vector<int> out;
+    assert(ring.Drain([&out](int &value) { out.push_back(value); }) == 4);
+    assert(out.size() == 4 && out[0] == 0 && out[3] == 3);
+    assert(ring.Size() == 0);
+    int again = 7;
+    assert(ring.TryPush(again));
+    assert(ring.Size() == 1);
+}
+
+int g_evaluations = 0;
+
+int CountEvaluation() {
+    ++g_evaluations;
+    return 1;
+}
+
+void TestDisabledLevelSkipsFormatting() {
+    const std::string path = TempPath("level");
+    std::remove(path.c_str());
+    {
+        Logger logger;
+        logger.SetOutput(path);
+        logger.SetLevel(config::LogLevel::kWarn);
+        IRC_LOG(logger, config::LogLevel::kDebug, "hidden " << CountEvaluation());
+        IRC_LOG(logger, config::LogLevel::kInfo, "hidden " << CountEvaluation());
+        assert(g_evaluations == 0);
+        IRC_LOG(logger, config::LogLevel::kWarn, "shown " << CountEvaluation());
+        assert(g_evaluations == 1);
+        logger.Flush();
+
+        std::vector<std::string> lines = ReadLines(path);
+        assert(lines.size() == 1);
+        assert(lines[0] == "[warn] shown 1");
+    }
+    std::remove(path.c_str());
+}
+
+void TestThreadsWriteEveryLineInOrder() {
+    const std::string path = TempPath("threads");
+    std::remove(path.c_str());
+    const int kThreads = 4;
+    const int kPerThread = 2000;
+    {
+        Logger logger(kThreads * kPerThread);
+        logger.SetOutput(path);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < kThreads; ++t) {
+            threads.push_back(std::thread([&logger, t]() {
+                for (int i = 0; i < kPerThread; ++i) {
+                    IRC_LOG(logger, config::LogLevel::kInfo, t << ":" << i);
+                }
+            }));
+        }
+        for (std::size_t t = 0; t < threads.size(); ++t) {
+            threads[t].join();
+        }
+        logger.Flush();
+        assert(logger.dropped() == 0);
+
+        // 스레드 사이 순서는 섞일 수 있지만 한 스레드의 라인은 넣은 순서대로 나온다.
+        std::vector<std::string> lines = ReadLines(path);
+        assert(lines.size() == static_cast<std::size_t>(kThreads * kPerThread));
+        std::vector<int> next(kThreads, 0);
+        for (std::size_t i = 0; i < lines.size(); ++i) {
+            int t = 0;
+            int n = 0;
+            assert(std::sscanf(lines[i].c_str(), "[info] %d:%d", &t, &n) == 2);
+            assert(n == next[t]);
+            ++next[t];
+        }
+    }
+    std::remove(path.c_str());
+}
+
+void TestOverflowIsCountedAndReported() {
+    const std::string path = TempPath("drops");
+    std::remove(path.c_str());
+    const int kLines = 20000;
+    {
+        Logger logger(8);
+        logger.SetOutput(path);
+        for (int i = 0; i < kLines; ++i) {
+            logger.Log(config::LogLevel::kInfo, "flood");
+        }
+        logger.Flush();
+
+        std::vector<std::string> lines = ReadLines(path);
+        std::size_t written = 0;
+        bool reported = logger.dropped() == 0;
+        for (std::size_t i = 0; i < lines.size(); ++i) {
+            if (lines[i] == "[info] flood") {
+                ++written;
+            } else {
+                assert(lines[i].find("[warn] 로그 링 가득 참") == 0);
+                reported = true;
+            }
+        }
+        assert(written + logger.dropped() == static_cast<std::size_t>(kLines));
+        assert(reported);
+    }
+    std::remove(path.c_str());
+}
+
+void TestIdleWriterSleepsUntilLineArrives() {
+    const std::string path = TempPath("idle");
+    std::remove(path.c_str());
+    {
+        Logger logger;
+        logger.SetOutput(path);
+        logger.Log(config::LogLevel::kInfo, "first");
+        logger.Flush();
+
+        // 주기(50ms)의 여러 배를 쉬어도 비울 라인이 없으면 깨어나지 않는다.
+        const std::uint64_t wakeups = logger.writer_wakeups();
+        std::this_thread::sleep_for(std::chrono::milliseconds(Logger::kFlushIntervalMs * 6));
+        assert(logger.writer_wakeups() == wakeups);
+
+        // 잠든 뒤 들어온 라인은 Flush 없이도 곧 쓰인다.
+        logger.Log(config::LogLevel::kInfo, "second");
+        std::vector<std::string> lines;
+        for (int i = 0; i < 100 && lines.size() < 2; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(Logger::kFlushIntervalMs));
+            lines = ReadLines(path);
+        }
+        assert(lines.size() == 2);
+        assert(lines[1] == "[info] second");
+    }
+    std::remove(path.c_str());
+}
+}  // namespace
+
+int main() {
+    TestRingKeepsOrderAndCapacity();
+    TestDisabledLevelSkipsFormatting();
+    TestThreadsWriteEveryLineInOrder();
+    TestOverflowIsCountedAndReported();
+    TestIdleWriterSleepsUntilLineArrives();
+    return 0;
+}
@@ -0,0 +1,71 @@
+/*
+ * 설명: 샤드 우편함이 여러 생산자 스레드의 항목을 빠짐없이 전달하고, 생산자별 순서를 지키며, 비어 있을 때의 첫 푸시만 알리는지 확인한다.
+ * 버전: v1.1.0
+ * 관련 문서: design/server/v1.1.0-performance.md
+ * 테스트: 이 파일 자체
+ */
+#include "net/mailbox.hpp"
+
+#include <cassert>
+#include <thread>
+#include <vector>
+
+namespace {
+struct Item {
+    int producer;
+    int sequence;
+};
+
+void TestFifoAndWakeSignal() {
+    net::Mailbox<int> mailbox;
+    assert(mailbox.Empty());
+    assert(mailbox.Push(1));
+    assert(!mailbox.Push(2));
+    assert(!mailbox.Push(3));
+
+    std::vector<int> out;
+    assert(mailbox.TakeAll(out) == 3);
+    assert(out.size() == 3 && out[0] == 1 && out[1] == 2 && out[2] == 3);
+    assert(mailbox.Empty());
+    assert(mailbox.TakeAll(out) == 0);
+    assert(mailbox.Push(4));
+}
+
+void TestConcurrentProducers() {
+    const int kProducers = 4;
+    const int kPerProducer = 20000;
+    net::Mailbox<Item> mailbox;
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; ++p) {
+        producers.push_back(std::thread([&mailbox, p]() {
+            for (int i = 0; i < kPerProducer; ++i) {
+                Item item = {p, i};
+                mailbox.Push(item);
+            }
+        }));
+    }
+
+    std::vector<int> next(kProducers, 0);
+    std::vector<Item> batch;
+    int received = 0;
+    while (received < kProducers * kPerProducer) {
+        batch.clear();
+        mailbox.TakeAll(batch);
+        for (std::size_t i = 0; i < batch.size(); ++i) {
+            assert(batch[i].sequence == next[batch[i].producer]);
+            ++next[batch[i].producer];
+        }
+        received += static_cast<int>(batch.size());
+    }
+    for (std::size_t i = 0; i < producers.size(); ++i) {
+        producers[i].join();
+    }
+    assert(mailbox.Empty());
+}
+}  // namespace
+
+int main() {
+    TestFifoAndWakeSignal();
+    TestConcurrentProducers();
+    return 0;
+}
@@ -1,18 +1,32 @@
 /*
- * 설명: RFC 스타일 IRC 메시지 파서와 닉네임 검증 로직을 확인한다.
- * 버전: v0.3.0
- * 관련 문서: design/protocol/contract.md
+ * 설명: RFC 스타일 IRC 메시지 파서(소유/뷰 두 변형), 명령 디스패치 테이블, 닉네임 검증 로직을 확인한다.
+ * 버전: v1.1.0
+ * 관련 문서: design/protocol/contract.md, design/server/v1.1.0-performance.md
  * 테스트: 이 파일 자체
  */
+#include "protocol/command.hpp"
 #include "protocol/message.hpp"
 
 #include <cassert>
 #include <string>
 #include <vector>
 
+// 같은 라인을 두 파서에 넣고 필드가 서로 일치하는지 함께 확인한다.
+protocol::ParsedMessage ParseBoth(const std::string &line) {
+    protocol::ParsedMessage owned = protocol::ParseMessageLine(line);
+    protocol::ParsedMessageView view = protocol::ParseMessageView(line);
+    assert(view.prefix == owned.prefix);
+    assert(view.command == owned.command);
+    assert(view.params.size() == owned.params.size());
+    for (std::size_t i = 0; i < owned.params.size(); ++i) {
+        assert(view.params[i] == owned.params[i]);
+    }
+    return owned;
+}
+
 void TestParseWithPrefixAndTrailing() {
     std::string line = ":nick!user@host PRIVMSG target :hello world";
-    protocol::ParsedMessage msg = protocol::ParseMessageLine(line);
+    protocol::ParsedMessage msg = ParseBoth(line);
     assert(msg.command == "PRIVMSG");
     assert(msg.prefix == "nick!user@host");
     assert(msg.params.size() == 2);
@@ -22,7 +36,7 @@ void TestParseWithPrefixAndTrailing() {
 
 void TestParseWithoutPrefix() {
     std::string line = "PING token";
-    protocol::ParsedMessage msg = protocol::ParseMessageLine(line);
+    protocol::ParsedMessage msg = ParseBoth(line);
     assert(msg.command == "PING");
     assert(msg.params.size() == 1);
     assert(msg.params[0] == "token");
@@ -30,7 +44,7 @@ void TestParseWithoutPrefix() {
 
 void TestParseWithExtraSpaces() {
     std::string line = ":srv   NOTICE   user   : spaced  payload";
-    protocol::ParsedMessage msg = protocol::ParseMessageLine(line);
+    protocol::ParsedMessage msg = ParseBoth(line);
     assert(msg.command == "NOTICE");
     assert(msg.prefix == "srv");
     assert(msg.params.size() == 2);
@@ -38,6 +52,44 @@ void TestParseWithExtraSpaces() {
     assert(msg.params[1] == " spaced  payload");
 }
 
+void TestParseCapsParamsAtRfcMaximum() {
+    std::string line = "MODE";
+    for (int i = 0; i < 17; ++i) {
+        line += " p" + std::to_string(i);
+    }
+    protocol::ParsedMessage msg = ParseBoth(line);
+    assert(msg.params.size() == protocol::kMaxParams);
+    assert(msg.params[13] == "p13");
+    assert(msg.params[14] == "p14 p15 p16");
+}
+
+void TestViewBorrowsFromLine() {
+    std::string line = "JOIN #room key";
+    protocol::ParsedMessageView view = protocol::ParseMessageView(line);
+    assert(view.command.data() == line.data());
+    assert(view.params[0].data() == line.data() + 5);
+}
+
+void TestCommandLookupIgnoresCase() {
+    for (int id = static_cast<int>(protocol::CommandId::kPing);
+         id < static_cast<int>(protocol::kCommandCount); ++id) {
+        protocol::CommandId command = static_cast<protocol::CommandId>(id);
+        std::string name = protocol::CommandName(command);
+        assert(protocol::LookupCommand(name) == command);
+        std::string lowered = name;
+        for (std::size_t i = 0; i < lowered.size(); ++i) {
+            lowered[i] = static_cast<char>(lowered[i] | 0x20);
+        }
+        assert(protocol::LookupCommand(lowered) == command);
+    }
+    assert(protocol::LookupCommand("PrivMsg") == protocol::CommandId::kPrivmsg);
+    assert(protocol::LookupCommand("") == protocol::CommandId::kUnknown);
+    assert(protocol::LookupCommand("PIN") == protocol::CommandId::kUnknown);
+    assert(protocol::LookupCommand("PINGS") == protocol::CommandId::kUnknown);
+    assert(protocol::LookupCommand("P1NG") == protocol::CommandId::kUnknown);
+    assert(protocol::LookupCommand("WHOIS") == protocol::CommandId::kUnknown);
+}
+
 void TestNicknameValidation() {
     assert(protocol::IsValidNickname("User1"));
     assert(protocol::IsValidNickname("nick_[]"));
@@ -47,11 +99,25 @@ void TestNicknameValidation() {
     assert(!protocol::IsValidNickname("bad!"));
 }
 
+void TestChannelNameValidation() {
+    assert(protocol::IsValidChannelName("#a"));
+    assert(protocol::IsValidChannelName("#room_1-x"));
+    assert(protocol::IsValidChannelName("#" + std::string(49, 'c')));
+    assert(!protocol::IsValidChannelName("#" + std::string(50, 'c')));
+    assert(!protocol::IsValidChannelName("#"));
+    assert(!protocol::IsValidChannelName("room"));
+    assert(!protocol::IsValidChannelName("#bad.name"));
+    assert(!protocol::IsValidChannelName("#bad,name"));
+}
+
 int main() {
     TestParseWithPrefixAndTrailing();
     TestParseWithoutPrefix();
     TestParseWithExtraSpaces();
+    TestParseCapsParamsAtRfcMaximum();
+    TestViewBorrowsFromLine();
+    TestCommandLookupIgnoresCase();
     TestNicknameValidation();
+    TestChannelNameValidation();
     return 0;
 }
-
@@ -0,0 +1,110 @@
+/*
+ * 설명: 로그-선형 히스토그램의 칸 경계와 백분위수 오차, 샤드별 히스토그램 합치기, 단일 작성자 카운터, Prometheus 텍스트 출력 형식을 확인한다.
+ * 버전: v1.1.0
+ * 관련 문서: design/server/v1.1.0-performance.md
+ * 테스트: 이 파일 자체
+ */
+#include "utils/metrics.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <string>
+
+namespace {
+void TestBucketsAreMonotonicWithBoundedError() {
+    assert(metrics::BucketIndex(0) == 0);
+    assert(metrics::BucketIndex(15) == 15);
+    assert(metrics::BucketIndex(16) == 16);
+    std::size_t previous = 0;
+    for (std::uint64_t v = 1; v < (std::uint64_t(1) << 40); v = v * 5 / 4 + 1) {
+        const std::size_t index = metrics::BucketIndex(v);
+        assert(index >= previous);
+        previous = index;
+        const std::uint64_t middle = metrics::BucketMiddle(index);
+        const std::uint64_t diff = middle > v ? middle - v : v - middle;
+        assert(diff * 16 <= v);
+    }
+    assert(metrics::BucketIndex(UINT64_MAX) == metrics::kBucketCount - 1);
+}
+
+void TestPercentiles() {
+    metrics::HistogramSnapshot histogram;
+    assert(histogram.Percentile(0.5) == 0);
+    for (std::uint64_t v = 1; v <= 10000; ++v) {
+        histogram.Record(v);
+    }
+    assert(histogram.count() == 10000);
+    assert(histogram.sum() == 10000ull * 10001 / 2);
+    assert(histogram.max() == 10000);
+    const std::uint64_t p50 = histogram.Percentile(0.5);
+    const std::uint64_t p99 = histogram.Percentile(0.99);
+    const std::uint64_t p999 = histogram.Percentile(0.999);
+    assert(p50 >= 4700 && p50 <= 5300);
+    assert(p99 >= 9300 && p99 <= 10000);
+    assert(p999 >= p99 && p999 <= 10000);
+    assert(histogram.Percentile(1.0) <= histogram.max());
+}
+
+void TestShardHistogramsMerge() {
+    metrics::Histogram a;
+    metrics::Histogram b;
+    for (int i = 0; i < 100; ++i) {
+        a.Record(100);
+        b.Record(1000000);
+    }
+    assert(a.count() == 100);
+    metrics::HistogramSnapshot merged;
+    a.AddTo(merged);
+    b.AddTo(merged);
+    assert(merged.count() == 200);
+    assert(merged.max() == 1000000);
+    assert(merged.sum() == 100ull * 100 + 100ull * 1000000);
+    const std::uint64_t low = merged.Percentile(0.25);
+    assert(low >= 100 && low <= 100 + 100 / 16);
+    const std::uint64_t high = merged.Percentile(0.99);
+    assert(high >= 1000000 - 1000000 / 16 && high <= 1000000);
+}
+
+void TestCounter() {
+    metrics::Counter counter;
+    assert(counter.Load() == 0);
+    counter.Add();
+    counter.Add(41);
+    assert(counter.Load() == 42);
+}
+
+void TestPrometheusText() {
+    metrics::HistogramSnapshot histogram;
+    histogram.Record(1000);
+    metrics::TextWriter out;
+    out.Family("irc_commands_total", "counter", "처리한 명령 수");
+    out.Value("irc_commands_total", "command=\"JOIN\"", 3);
+    out.Family("irc_connections", "gauge", "현재 연결 수");
+    out.Value("irc_connections", "", 2);
+    out.Family("irc_command_duration_seconds", "summary", "명령 핸들러 실행 시간");
+    out.Summary("irc_command_duration_seconds", "command=\"JOIN\"", histogram, 1e-9);
+
+    const std::string expected =
+        "# HELP irc_commands_total 처리한 명령 수\n"
+        "# TYPE irc_commands_total counter\n"
+        "irc_commands_total{command=\"JOIN\"} 3\n"
+        "# HELP irc_connections 현재 연결 수\n"
+        "# TYPE irc_connections gauge\n"
+        "irc_connections 2\n"
+        "# HELP irc_command_duration_seconds 명령 핸들러 실행 시간\n"
+        "# TYPE irc_command_duration_seconds summary\n";
+    assert(out.Text().compare(0, expected.size(), expected) == 0);
+    assert(out.Text().find("irc_command_duration_seconds{command=\"JOIN\",quantile=\"0.99\"} ") != std::string::npos);
+    assert(out.Text().find("irc_command_duration_seconds_count{command=\"JOIN\"} 1\n") != std::string::npos);
+    assert(out.Text().find("irc_command_duration_seconds_sum{command=\"JOIN\"} 1e-06\n") != std::string::npos);
+}
+}  // namespace
+
+int main() {
+    TestBucketsAreMonotonicWithBoundedError();
+    TestPercentiles();
+    TestShardHistogramsMerge();
+    TestCounter();
+    TestPrometheusText();
+    return 0;
+}
@@ -0,0 +1,45 @@
+/*
+ * 설명: 닉네임 레지스트리가 RFC 1459 casemapping으로 중복을 판정하고 소유자만 해제하는지 확인한다.
+ * 버전: v1.1.0
+ * 관련 문서: design/protocol/contract.md, design/server/v1.1.0-performance.md
+ * 테스트: 이 파일 자체
+ */
+#include "state/nick_registry.hpp"
+
+#include <cassert>
+
+void TestFoldCase() {
+    assert(state::FoldCase("Nick[A]\\~") == "nick{a}|^");
+    assert(state::FoldCase("abc_-1") == "abc_-1");
+}
+
+void TestClaimIsCaseInsensitive() {
+    state::NickRegistry registry;
+    assert(registry.Claim("Alice", 5));
+    assert(registry.Claim("ALICE", 5));
+    assert(!registry.Claim("alice", 6));
+    assert(registry.Find("aLiCe") == 5);
+    assert(registry.InUse("alice", 6));
+    assert(!registry.InUse("alice", 5));
+
+    assert(registry.Claim("x[y]", 7));
+    assert(registry.Find("X{Y}") == 7);
+    assert(registry.Size() == 2);
+}
+
+void TestReleaseRequiresOwner() {
+    state::NickRegistry registry;
+    registry.Claim("bob", 3);
+    registry.Release("BOB", 4);
+    assert(registry.Find("bob") == 3);
+    registry.Release("BOB", 3);
+    assert(registry.Find("bob") == -1);
+    assert(registry.Size() == 0);
+}
+
+int main() {
+    TestFoldCase();
+    TestClaimIsCaseInsensitive();
+    TestReleaseRequiresOwner();
+    return 0;
+}
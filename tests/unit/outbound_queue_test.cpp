@@ -0,0 +1,142 @@
+/*
+ * 설명: 청크 사슬 송신 큐가 라인을 청크 경계에 걸쳐 이어 붙이고, 보낸 만큼 머리에서 떼어 다 비운 청크를 풀에 돌려주며, 풀이 상한을 넘는 청크는 해제하는지 확인한다.
+ *       게시 청크 하나를 여러 큐가 나눠 쓰고, 마지막 큐가 다 보낸 뒤에야 청크가 풀로 돌아가는지도 확인한다.
+ * 버전: v1.1.0
+ * 관련 문서: design/server/v1.1.0-performance.md
+ * 테스트: 이 파일 자체
+ */
+#include "net/outbound_queue.hpp"
+
+#include <cassert>
+#include <string>
+#include <utility>
+
+namespace {
+// iov로 모은 바이트를 이어 붙여 큐 내용을 확인한다.
+std::string Contents(const net::OutboundQueue &queue, std::size_t limit = static_cast<std::size_t>(-1)) {
+    struct iovec iov[64];
+    const int count = queue.Gather(iov, 64, limit);
+    std::string out;
+    for (int i = 0; i < count; ++i) {
+        out.append(static_cast<const char *>(iov[i].iov_base), iov[i].iov_len);
+    }
+    return out;
+}
+
+void TestAppendGatherConsume() {
+    net::ChunkPool pool;
+    net::OutboundQueue queue;
+    assert(queue.empty());
+    queue.Append(pool, "PING :a\r\n");
+    queue.Append(pool, "PONG :b\r\n");
+    assert(queue.size() == 18);
+    assert(pool.in_use() == 1);
+    assert(Contents(queue) == "PING :a\r\nPONG :b\r\n");
+    assert(Contents(queue, 4) == "PING");
+
+    queue.Consume(5);
+    assert(Contents(queue) == ":a\r\nPONG :b\r\n");
+    queue.Consume(13);
+    assert(queue.empty() && queue.size() == 0);
+    // 다 보내면 청크를 쥐지 않는다.
+    assert(pool.in_use() == 0 && pool.free_count() == 1);
+}
+
+void TestLinesSpanChunks() {
+    net::ChunkPool pool;
+    net::OutboundQueue queue;
+    const std::string line(500, 'x');
+    std::string expected;
+    for (int i = 0; i < 20; ++i) {
+        queue.Append(pool, line);
+        expected += line;
+    }
+    // 10000바이트는 청크 세 개에 걸친다.
+    assert(pool.in_use() == 3);
+    assert(Contents(queue) == expected);
+
+    queue.Consume(net::OutboundChunk::kCapacity + 10);
+    assert(pool.in_use() == 2);
+    assert(Contents(queue) == expected.substr(net::OutboundChunk::kCapacity + 10));
+    queue.Clear();
+    assert(pool.in_use() == 0 && pool.free_count() == 3);
+
+    // 풀에 남은 청크를 다시 쓰므로 새로 할당하지 않는다.
+    const std::uint64_t allocations = pool.allocations();
+    queue.Append(pool, expected);
+    assert(pool.allocations() == allocations);
+    queue.Clear();
+}
+
+void TestPoolCapAndMove() {
+    net::ChunkPool pool(1);
+    net::OutboundQueue a;
+    a.Append(pool, std::string(3 * net::OutboundChunk::kCapacity, 'y'));
+    assert(pool.in_use() == 3);
+
+    net::OutboundQueue b(std::move(a));
+    assert(a.empty() && b.size() == 3 * net::OutboundChunk::kCapacity);
+    // 연결 슬롯을 기본값으로 되돌리는 것처럼 빈 큐를 이동 대입하면 청크를 돌려준다.
+    b = net::OutboundQueue();
+    assert(b.empty());
+    assert(pool.in_use() == 0);
+    // 상한 1개만 남기고 나머지는 해제했다.
+    assert(pool.free_count() == 1);
+}
+void TestSharedLines() {
+    net::ChunkPool pool;
+    net::OutboundQueue a;
+    net::OutboundQueue b;
+    // 게시는 청크 하나에 이어 쓰고 큐에는 구간만 붙인다.
+    const net::OutboundSlice first = pool.Publish("PRIVMSG #c :1\r\n");
+    a.AppendShared(pool, first);
+    b.AppendShared(pool, first);
+    const net::OutboundSlice second = pool.Publish("PRIVMSG #c :2\r\n");
+    assert(second.chunk == first.chunk);
+    a.AppendShared(pool, second);
+    assert(pool.in_use() == 1);
+    // 같은 게시 청크에서 바로 이어지면 구간을 늘려 iovec 하나로 보낸다.
+    struct iovec iov[4];
+    assert(a.Gather(iov, 4, 1024) == 1);
+    assert(Contents(a) == "PRIVMSG #c :1\r\nPRIVMSG #c :2\r\n");
+
+    // 공유 구간 뒤의 개인 라인은 게시 청크를 건드리지 않고 새 청크에 쓴다.
+    b.Append(pool, "PING :x\r\n");
+    assert(pool.in_use() == 2);
+    assert(Contents(b) == "PRIVMSG #c :1\r\nPING :x\r\n");
+    const net::OutboundSlice third = pool.Publish("PRIVMSG #c :3\r\n");
+    assert(std::string(third.chunk->data + third.begin, third.end - third.begin) == "PRIVMSG #c :3\r\n");
+    assert(Contents(b) == "PRIVMSG #c :1\r\nPING :x\r\n");
+
+    a.Consume(a.size());
+    b.Consume(b.size());
+    assert(a.empty() && b.empty());
+    // 풀이 계속 이어 쓰는 게시 청크만 남는다.
+    assert(pool.in_use() == 1);
+}
+
+void TestFullPublishedChunkReturnsAfterLastReader() {
+    net::ChunkPool pool;
+    net::OutboundQueue slow;
+    const std::string line(500, 'z');
+    const net::OutboundSlice first = pool.Publish(line);
+    slow.AppendShared(pool, first);
+    // 게시 청크가 차면 풀은 새 청크로 옮기고, 아직 보내지 않은 큐가 옛 청크를 붙잡는다.
+    net::OutboundSlice last = first;
+    while (last.chunk == first.chunk) {
+        last = pool.Publish(line);
+    }
+    assert(pool.in_use() == 2);
+    slow.Consume(slow.size());
+    assert(pool.in_use() == 1 && pool.free_count() == 1);
+}
+}  // namespace
+
+int main() {
+    TestAppendGatherConsume();
+    TestLinesSpanChunks();
+    TestPoolCapAndMove();
+    TestSharedLines();
+    TestFullPublishedChunkReturnsAfterLastReader();
+    return 0;
+}
@@ -0,0 +1,72 @@
+/*
+ * 설명: GCRA 리미터가 한도만큼 몰아서 허용한 뒤 간격마다 다시 채우고, 거부할 때는 상태를 바꾸지 않는지 확인한다.
+ * 버전: v1.1.0
+ * 관련 문서: design/server/v1.1.0-performance.md
+ * 테스트: 이 파일 자체
+ */
+#include "state/rate_limiter.hpp"
+
+#include <cassert>
+#include <cstdint>
+
+namespace {
+const std::uint64_t kStart = 123456789;
+
+void TestDisabledPolicyAlwaysAllows() {
+    state::RatePolicy policy = state::RatePolicy::PerWindow(0, 5000);
+    assert(!policy.Enabled());
+    state::RateLimiter limiter;
+    for (int i = 0; i < 1000; ++i) {
+        assert(limiter.TryAcquire(policy, kStart));
+    }
+}
+
+void TestBurstThenRefill() {
+    // 5초에 4번: 한꺼번에 4번, 이후 1.25초마다 1번.
+    state::RatePolicy policy = state::RatePolicy::PerWindow(4, 5000);
+    state::RateLimiter limiter;
+    for (int i = 0; i < 4; ++i) {
+        assert(limiter.TryAcquire(policy, kStart));
+    }
+    assert(!limiter.TryAcquire(policy, kStart));
+    assert(!limiter.TryAcquire(policy, kStart + 1249));
+    assert(limiter.TryAcquire(policy, kStart + 1250));
+    assert(!limiter.TryAcquire(policy, kStart + 1250));
+
+    // 한 창 넘게 쉬면 다시 한도만큼 쓸 수 있고 그 이상은 쌓이지 않는다.
+    const std::uint64_t later = kStart + 60000;
+    for (int i = 0; i < 4; ++i) {
+        assert(limiter.TryAcquire(policy, later));
+    }
+    assert(!limiter.TryAcquire(policy, later));
+}
+
+void TestSteadyRateNeverRejected() {
+    state::RatePolicy policy = state::RatePolicy::PerWindow(10, 5000);
+    state::RateLimiter limiter;
+    for (int i = 0; i < 1000; ++i) {
+        assert(limiter.TryAcquire(policy, kStart + static_cast<std::uint64_t>(i) * 500));
+    }
+}
+
+void TestLimitAboveWindowKeepsNonzeroInterval() {
+    state::RatePolicy policy = state::RatePolicy::PerWindow(100000, 5000);
+    assert(policy.Enabled());
+    state::RateLimiter limiter;
+    int allowed = 0;
+    for (int i = 0; i < 200000; ++i) {
+        if (limiter.TryAcquire(policy, kStart)) {
+            ++allowed;
+        }
+    }
+    assert(allowed == 100000);
+}
+}  // namespace
+
+int main() {
+    TestDisabledPolicyAlwaysAllows();
+    TestBurstThenRefill();
+    TestSteadyRateNeverRejected();
+    TestLimitAboveWindowKeepsNonzeroInterval();
+    return 0;
+}
@@ -0,0 +1,97 @@
+/*
+ * 설명: 읽기 예산(라인/바이트)을 넘는 입력은 다음 바퀴로 미뤄지고, 그 사이 다른 연결이 같은 바퀴에 처리되며,
+ *       미룬 입력은 순서와 라인 경계를 지킨 채 끝까지 처리되는지 확인한다.
+ * 버전: v1.1.0
+ * 관련 문서: design/server/v1.1.0-performance.md
+ * 테스트: 이 파일 자체
+ */
+#include <algorithm>
+#include <cassert>
+#include <string>
+
+#include "../support/server_harness.hpp"
+
+namespace {
+const int kFloodLines = 200;
+
+std::string FloodInput() {
+    std::string data;
+    for (int i = 0; i < kFloodLines; ++i) {
+        data += "PING :flood-" + std::to_string(i) + "\r\n";
+    }
+    return data;
+}
+
+std::size_t CountLines(const std::string &text) {
+    return static_cast<std::size_t>(std::count(text.begin(), text.end(), '\n'));
+}
+
+// 미룬 읽기가 없어질 때까지 바퀴를 돌리며 받은 응답을 모은다.
+std::string RunUntilIdle(ServerHarness &harness, std::size_t client, std::string received) {
+    while (harness.deferred_reads() > 0) {
+        harness.Tick();
+        harness.Flush();
+        received += harness.Receive(client);
+    }
+    return received;
+}
+
+void TestLineBudgetYieldsToOtherConnections() {
+    config::Settings settings = ServerHarness::DefaultSettings();
+    settings.read_budget_lines = 16;
+    ServerHarness harness(settings);
+    const std::size_t flooder = harness.Connect("flooder");
+    const std::size_t quiet = harness.Connect("quiet");
+
+    harness.Write(flooder, FloodInput());
+    harness.Read(flooder);
+    harness.Flush();
+    std::string flood = harness.Receive(flooder);
+    assert(CountLines(flood) == 16);
+    assert(harness.deferred_reads() == 1);
+
+    // 다음 바퀴: 조용한 연결의 이벤트가 먼저 처리되고, 미룬 연결은 예산만큼만 더 읽는다.
+    harness.Write(quiet, "PING :quiet\r\n");
+    harness.Read(quiet);
+    harness.Tick();
+    harness.Flush();
+    const std::string reply = harness.Receive(quiet);
+    assert(reply.find("PONG quiet\r\n") != std::string::npos);
+    flood += harness.Receive(flooder);
+    assert(CountLines(flood) == 32);
+
+    flood = RunUntilIdle(harness, flooder, flood);
+    assert(CountLines(flood) == static_cast<std::size_t>(kFloodLines));
+    assert(flood.find("PONG flood-0\r\n") < flood.find("PONG flood-199\r\n"));
+}
+
+void TestByteBudgetKeepsLineBoundaries() {
+    config::Settings settings = ServerHarness::DefaultSettings();
+    settings.read_budget_bytes = 1000;
+    settings.read_budget_lines = 1000;
+    ServerHarness harness(settings);
+    const std::size_t flooder = harness.Connect("flooder");
+
+    const std::string input = FloodInput();
+    assert(input.size() > 3000);
+    harness.Write(flooder, input);
+    harness.Read(flooder);
+    harness.Flush();
+    std::string flood = harness.Receive(flooder);
+    // 1000바이트 안에 든 완성 라인만 처리하고 걸친 라인은 링에 남긴다.
+    assert(CountLines(flood) > 0 && CountLines(flood) < static_cast<std::size_t>(kFloodLines));
+    assert(harness.deferred_reads() == 1);
+
+    flood = RunUntilIdle(harness, flooder, flood);
+    assert(CountLines(flood) == static_cast<std::size_t>(kFloodLines));
+    for (int i = 0; i < kFloodLines; ++i) {
+        assert(flood.find("PONG flood-" + std::to_string(i) + "\r\n") != std::string::npos);
+    }
+}
+}  // namespace
+
+int main() {
+    TestLineBudgetYieldsToOtherConnections();
+    TestByteBudgetKeepsLineBoundaries();
+    return 0;
+}
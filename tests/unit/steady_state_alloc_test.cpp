@@ -0,0 +1,83 @@
+/*
+ * 설명: 예열이 끝난 정상 상태에서 명령을 읽고 처리해 응답을 송신 큐에 넣고 소켓으로 보내기까지 힙을 한 번도 쓰지 않는지 확인한다.
+ *       명령마다 응답 한 줄이 연결 하나의 큐에 들어가도록 골라 받은 줄 수로 응답 경로를 탔는지도 확인한다.
+ * 버전: v1.1.0
+ * 관련 문서: design/server/v1.1.0-performance.md
+ * 테스트: 이 파일 자체
+ */
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+#include "../support/alloc_counter.hpp"
+#include "../support/server_harness.hpp"
+
+namespace {
+const int kLines = 64;
+
+struct Scenario {
+    const char *name;
+    const char *line;
+};
+
+// 모두 alice가 보내고, 응답(또는 전달)은 정확히 한 줄이다.
+const Scenario kScenarios[] = {
+    {"ping", "PING :steady-state-token\r\n"},
+    {"privmsg_user", "PRIVMSG bob :hello there, this is a direct message\r\n"},
+    {"privmsg_channel", "PRIVMSG #room :hello room, this goes to one other member\r\n"},
+    {"notice_channel", "NOTICE #room :a notice for the room\r\n"},
+    {"no_such_nick", "PRIVMSG nobody_by_this_name :is anyone there\r\n"},
+    {"no_such_channel", "TOPIC #a_channel_name_that_does_not_exist_anywhere\r\n"},
+    {"user_on_channel", "INVITE bob #room\r\n"},
+    {"unknown_command", "FROBNICATE #room :unsupported\r\n"},
+    {"topic_query", "TOPIC #room\r\n"},
+    {"mode_query", "MODE #room\r\n"},
+};
+
+// line을 kLines번, 한 번에 한 줄씩 보내고 서버가 읽어 큐를 비울 때까지의 할당 횟수를 센다.
+std::uint64_t CountAllocations(ServerHarness &harness, std::size_t client, const std::string &line) {
+    const support::AllocationStats before = support::ThreadAllocations();
+    for (int i = 0; i < kLines; ++i) {
+        harness.Feed(client, line);
+        harness.Flush();
+    }
+    const support::AllocationStats after = support::ThreadAllocations();
+    return after.count - before.count;
+}
+
+// 예열을 한 번 하고 잰다. 받은 줄 수로 명령마다 응답이 한 줄인지도 확인한다.
+std::uint64_t Measure(ServerHarness &harness, std::size_t client, const std::string &line) {
+    CountAllocations(harness, client, line);
+    harness.Drain();
+    harness.ResetReceived();
+    const std::uint64_t count = CountAllocations(harness, client, line);
+    harness.Drain();
+    assert(harness.received_lines() == static_cast<std::uint64_t>(kLines));
+    return count;
+}
+
+void TestSteadyStateDoesNotAllocate() {
+    ServerHarness harness;
+    const std::size_t alice = harness.Connect("alice");
+    const std::size_t bob = harness.Connect("bob");
+    harness.Feed(alice, "JOIN #room\r\nTOPIC #room :steady state topic\r\n");
+    harness.Feed(bob, "JOIN #room\r\n");
+    harness.Flush();
+    harness.Drain();
+
+    // 핸들러 임시 문자열은 읽기 묶음 아레나, 응답은 풀에서 받은 송신 큐 청크에 들어간다.
+    for (std::size_t i = 0; i < sizeof(kScenarios) / sizeof(kScenarios[0]); ++i) {
+        const std::uint64_t count = Measure(harness, alice, kScenarios[i].line);
+        if (count != 0) {
+            std::fprintf(stderr, "%s: 할당 %llu회\n", kScenarios[i].name, static_cast<unsigned long long>(count));
+        }
+        assert(count == 0);
+    }
+}
+}  // namespace
+
+int main() {
+    TestSteadyStateDoesNotAllocate();
+    return 0;
+}
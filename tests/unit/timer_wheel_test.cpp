@@ -0,0 +1,140 @@
+/*
+ * 설명: 타이머 휠이 단을 넘나드는 기한을 정확한 틱에 만료시키고, 취소/재예약과 다음 대기 시간 계산이 맞는지 확인한다.
+ * 버전: v1.1.0
+ * 관련 문서: design/server/v1.1.0-performance.md
+ * 테스트: 이 파일 자체
+ */
+#include "net/timer_wheel.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+namespace {
+const std::uint64_t kTick = 100;
+// 0이 아닌 임의의 시작 시각. steady_clock처럼 큰 값에서 시작해도 빈 구간을 돌지 않아야 한다.
+const std::uint64_t kStart = 987654321ull * kTick;
+
+// ms 단위로 한 틱씩 진행하며 key가 처음 만료된 시각을 기록한다.
+std::uint64_t RunUntilFired(net::TimerWheel &wheel, std::uint64_t from, std::uint64_t key,
+                            std::uint64_t limit) {
+    std::vector<std::uint64_t> fired;
+    for (std::uint64_t now = from; now <= limit; now += kTick) {
+        fired.clear();
+        wheel.Advance(now, fired);
+        for (std::size_t i = 0; i < fired.size(); ++i) {
+            if (fired[i] == key) {
+                return now;
+            }
+        }
+    }
+    return 0;
+}
+
+void TestFiresAtDeadlineAcrossLevels() {
+    const std::uint64_t delays[] = {0, 1, 150, 6300, 6400, 6500, 409600, 500000, 30000000};
+    for (std::size_t i = 0; i < sizeof(delays) / sizeof(delays[0]); ++i) {
+        net::TimerWheel wheel(kTick);
+        std::vector<std::uint64_t> none;
+        wheel.Advance(kStart, none);
+        wheel.Schedule(7, kStart + delays[i]);
+        std::uint64_t fired = RunUntilFired(wheel, kStart, 7, kStart + delays[i] + 10 * kTick);
+        // 기한보다 늦지 않은 첫 틱 경계에서 만료된다(이미 지난 기한은 다음 틱).
+        std::uint64_t expected = (kStart + delays[i] + kTick - 1) / kTick * kTick;
+        if (expected <= kStart) {
+            expected = kStart + kTick;
+        }
+        assert(fired == expected);
+        assert(wheel.Size() == 0);
+    }
+}
+
+void TestCancelAndReschedule() {
+    net::TimerWheel wheel(kTick);
+    std::vector<std::uint64_t> fired;
+    wheel.Advance(kStart, fired);
+    net::TimerId a = wheel.Schedule(1, kStart + 1000);
+    net::TimerId b = wheel.Schedule(2, kStart + 1000);
+    wheel.Schedule(3, kStart + 2000);
+    wheel.Cancel(a);
+    wheel.Reschedule(b, kStart + 500000);
+    assert(wheel.Size() == 2);
+
+    wheel.Advance(kStart + 2000, fired);
+    assert(fired.size() == 1 && fired[0] == 3);
+    fired.clear();
+    wheel.Advance(kStart + 499900, fired);
+    assert(fired.empty());
+    wheel.Advance(kStart + 500000, fired);
+    assert(fired.size() == 1 && fired[0] == 2);
+
+    // 해제된 노드는 재사용된다.
+    net::TimerId c = wheel.Schedule(4, kStart + 600000);
+    assert(c == a || c == b);
+}
+
+void TestNextTimeout() {
+    net::TimerWheel wheel(kTick);
+    std::vector<std::uint64_t> fired;
+    wheel.Advance(kStart, fired);
+    assert(wheel.NextTimeoutMs(kStart) == -1);
+
+    wheel.Schedule(1, kStart + 350);
+    int wait = wheel.NextTimeoutMs(kStart);
+    assert(wait > 0 && wait <= 400);
+
+    // 먼 타이머만 있으면 0단이 한 바퀴 도는 시점 안에 한 번은 깨운다.
+    net::TimerWheel far(kTick);
+    far.Advance(kStart, fired);
+    far.Schedule(2, kStart + 3600000);
+    wait = far.NextTimeoutMs(kStart);
+    assert(wait > 0 && wait <= 6400);
+}
+
+// 서버처럼 부팅 후 시각(수십 일 = 64^4틱 이상)에서 Advance 없이 바로 거는 타이머도 제 틱에 만료된다.
+void TestScheduleBeforeFirstAdvance() {
+    const std::uint64_t uptime = 30ull * 24 * 3600 * 1000;
+    net::TimerWheel wheel(kTick, uptime);
+    wheel.Schedule(9, uptime + 120000);
+    // 틱 0 기준으로 계산했다면 첫 대기가 0이 되어 빈 틱을 훑게 된다.
+    assert(wheel.NextTimeoutMs(uptime) > 0 && wheel.NextTimeoutMs(uptime) <= 6400);
+    std::vector<std::uint64_t> fired;
+    wheel.Advance(uptime + 119900, fired);
+    assert(fired.empty());
+    wheel.Advance(uptime + 120000, fired);
+    assert(fired.size() == 1 && fired[0] == 9);
+
+    // 0에서 만든 휠도 첫 Advance로 시각을 맞춘 뒤에는 같은 틱에 만료된다(EnterShard가 하는 일).
+    net::TimerWheel late(kTick);
+    late.Advance(uptime, fired);
+    late.Schedule(10, uptime + 120000);
+    fired.clear();
+    late.Advance(uptime + 119900, fired);
+    assert(fired.empty());
+    late.Advance(uptime + 120000, fired);
+    assert(fired.size() == 1 && fired[0] == 10);
+}
+
+void TestManyIdleTimersCostNothingUntilDue() {
+    net::TimerWheel wheel(kTick);
+    std::vector<std::uint64_t> fired;
+    wheel.Advance(kStart, fired);
+    for (std::uint64_t key = 0; key < 10000; ++key) {
+        wheel.Schedule(key, kStart + 120000 + key % 100 * kTick);
+    }
+    wheel.Advance(kStart + 119900, fired);
+    assert(fired.empty());
+    wheel.Advance(kStart + 130000, fired);
+    assert(fired.size() == 10000);
+    assert(wheel.Size() == 0);
+}
+}  // namespace
+
+int main() {
+    TestFiresAtDeadlineAcrossLevels();
+    TestCancelAndReschedule();
+    TestNextTimeout();
+    TestScheduleBeforeFirstAdvance();
+    TestManyIdleTimersCostNothingUntilDue();
+    return 0;
+}
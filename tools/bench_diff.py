@@ -0,0 +1,51 @@
+"""
+버전: v1.1.0
+관련 문서: design/server/v1.1.0-performance.md, CLONE_GUIDE.md
+테스트: make bench (수동 비교)
+설명: hot_path_bench가 낸 JSON 두 개를 이름별로 맞춰 ns/op와 할당/op 변화를 표로 보여 준다.
+      --max-regression을 주면 ns/op가 그 비율(%)보다 더 느려진 항목이 있을 때 1로 끝난다.
+"""
+import argparse
+import json
+import sys
+
+
+def load(path):
+    with open(path) as f:
+        report = json.load(f)
+    return {row["name"]: row for row in report["results"]}
+
+
+def main():
+    parser = argparse.ArgumentParser(description="hot_path_bench JSON 결과 비교")
+    parser.add_argument("base")
+    parser.add_argument("head")
+    parser.add_argument("--max-regression", type=float, default=None, metavar="PCT")
+    args = parser.parse_args()
+
+    base = load(args.base)
+    head = load(args.head)
+    regressions = []
+    print(f"{'name':<28} {'base ns/op':>12} {'head ns/op':>12} {'delta':>8} {'allocs/op':>18}")
+    for name, new in head.items():
+        old = base.get(name)
+        if old is None:
+            print(f"{name:<28} {'-':>12} {new['ns_per_op']:>12.1f} {'new':>8}")
+            continue
+        delta = (new["ns_per_op"] - old["ns_per_op"]) / old["ns_per_op"] * 100 if old["ns_per_op"] else 0.0
+        allocs = f"{old['allocs_per_op']:.2f} -> {new['allocs_per_op']:.2f}"
+        print(f"{name:<28} {old['ns_per_op']:>12.1f} {new['ns_per_op']:>12.1f} {delta:>+7.1f}% {allocs:>18}")
+        if args.max_regression is not None and delta > args.max_regression:
+            regressions.append(name)
+    for name in base:
+        if name not in head:
+            print(f"{name:<28} {base[name]['ns_per_op']:>12.1f} {'-':>12} {'gone':>8}")
+
+    if regressions:
+        print(f"느려진 항목: {', '.join(regressions)}", file=sys.stderr)
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,678 @@
+/*
+ * 설명: 논블로킹 클라이언트 연결 수천 개를 열어 등록과 채널 JOIN을 마친 뒤, 정해진 속도로 PRIVMSG/JOIN·PART/개인 메시지를 섞어 보내고 초당 전달 수와 전달 지연 p50/p99/p999를 보고하는 부하 생성기.
+ * 버전: v1.1.0
+ * 관련 문서: design/server/v1.1.0-performance.md, CLONE_GUIDE.md
+ * 테스트: tests/e2e/test_irc_bench.py
+ */
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <signal.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "net/reactor.hpp"
+#include "protocol/framer.hpp"
+#include "utils/metrics.hpp"
+
+namespace {
+const std::size_t kMaxPendingOutput = 64 * 1024;
+const int kSetupTimeoutMs = 30000;
+const int kDrainQuietMs = 200;
+const int kDrainMaxMs = 2000;
+
+struct Options {
+    std::string host;
+    int port;
+    std::string password;
+    int clients;
+    int channels;
+    int joins_per_client;
+    double rate;
+    double duration_s;
+    double warmup_s;
+    int churn_percent;
+    int direct_percent;
+    int payload;
+    int connect_window;
+    unsigned seed;
+    std::string spawn;
+    std::string spawn_config;
+    bool json;
+
+    Options()
+        : host("127.0.0.1"),
+          port(0),
+          password("testpass"),
+          clients(1000),
+          channels(100),
+          joins_per_client(1),
+          rate(10000),
+          duration_s(10),
+          warmup_s(1),
+          churn_percent(0),
+          direct_percent(0),
+          payload(32),
+          connect_window(256),
+          seed(1),
+          json(false) {}
+};
+
+void PrintUsage() {
+    std::fprintf(stderr,
+                 "사용법: ./irc-bench [옵션]\n"
+                 "  --host H              서버 주소 (기본 127.0.0.1)\n"
+                 "  --port P              서버 포트 (기본 6667, --spawn이면 빈 포트)\n"
+                 "  --password PW         PASS 비밀번호 (기본 testpass)\n"
+                 "  --clients N           연결 수 (기본 1000)\n"
+                 "  --channels N          채널 수 (기본 100, 0이면 개인 메시지만)\n"
+                 "  --joins-per-client N  클라이언트마다 JOIN할 채널 수 (기본 1)\n"
+                 "  --rate N              초당 보낼 명령 수 (기본 10000)\n"
+                 "  --duration S          측정 시간(초, 기본 10)\n"
+                 "  --warmup S            측정 전 예열 시간(초, 기본 1)\n"
+                 "  --churn PCT           명령 중 PART+JOIN 비율(%%, 기본 0)\n"
+                 "  --direct PCT          명령 중 사용자 대상 PRIVMSG 비율(%%, 기본 0)\n"
+                 "  --payload N           메시지 본문 채움 바이트 (기본 32)\n"
+                 "  --connect-window N    동시에 등록 중인 연결 수 상한 (기본 256)\n"
+                 "  --seed N              명령 선택 난수 시드 (기본 1)\n"
+                 "  --spawn PATH          서버를 직접 띄우고 끝나면 종료한다\n"
+                 "  --spawn-config PATH   --spawn에 넘길 설정 파일\n"
+                 "  --json                결과를 JSON 한 줄로 출력\n");
+}
+
+bool ParseNumber(const char *text, double &out) {
+    char *end = nullptr;
+    out = std::strtod(text, &end);
+    return end != text && *end == '\0' && out >= 0;
+}
+
+bool ParseOptions(int argc, char *argv[], Options &out) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string flag = argv[i];
+        if (flag == "--json") {
+            out.json = true;
+            continue;
+        }
+        if (flag == "--help" || i + 1 >= argc) {
+            return false;
+        }
+        const char *value = argv[++i];
+        double number = 0;
+        const bool numeric = ParseNumber(value, number);
+        if (flag == "--host") {
+            out.host = value;
+        } else if (flag == "--password") {
+            out.password = value;
+        } else if (flag == "--spawn") {
+            out.spawn = value;
+        } else if (flag == "--spawn-config") {
+            out.spawn_config = value;
+        } else if (!numeric) {
+            return false;
+        } else if (flag == "--port") {
+            out.port = static_cast<int>(number);
+        } else if (flag == "--clients") {
+            out.clients = static_cast<int>(number);
+        } else if (flag == "--channels") {
+            out.channels = static_cast<int>(number);
+        } else if (flag == "--joins-per-client") {
+            out.joins_per_client = static_cast<int>(number);
+        } else if (flag == "--rate") {
+            out.rate = number;
+        } else if (flag == "--duration") {
+            out.duration_s = number;
+        } else if (flag == "--warmup") {
+            out.warmup_s = number;
+        } else if (flag == "--churn") {
+            out.churn_percent = static_cast<int>(number);
+        } else if (flag == "--direct") {
+            out.direct_percent = static_cast<int>(number);
+        } else if (flag == "--payload") {
+            out.payload = static_cast<int>(number);
+        } else if (flag == "--connect-window") {
+            out.connect_window = static_cast<int>(number);
+        } else if (flag == "--seed") {
+            out.seed = static_cast<unsigned>(number);
+        } else {
+            return false;
+        }
+    }
+    if (out.clients <= 0 || out.connect_window <= 0 || out.churn_percent + out.direct_percent > 100) {
+        return false;
+    }
+    if (out.channels == 0) {
+        out.joins_per_client = 0;
+    }
+    if (out.joins_per_client > out.channels) {
+        out.joins_per_client = out.channels;
+    }
+    return true;
+}
+
+std::uint64_t NowNs() {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                          std::chrono::steady_clock::now().time_since_epoch())
+                                          .count());
+}
+
+enum ClientState { kConnecting, kRegistering, kJoining, kReady, kClosed };
+
+struct Client {
+    int fd;
+    std::string nick;
+    ClientState state;
+    protocol::InputRing input;
+    std::string output;
+    std::size_t output_sent;
+    bool want_write;
+    std::vector<int> channels;
+    std::size_t joined;
+
+    Client() : fd(-1), state(kConnecting), output_sent(0), want_write(false), joined(0) {}
+};
+
+struct Counters {
+    std::uint64_t channel_messages;
+    std::uint64_t direct_messages;
+    std::uint64_t churns;
+    std::uint64_t skipped;
+    std::uint64_t delivered;
+    std::uint64_t error_numerics;
+    std::uint64_t disconnects;
+
+    Counters()
+        : channel_messages(0),
+          direct_messages(0),
+          churns(0),
+          skipped(0),
+          delivered(0),
+          error_numerics(0),
+          disconnects(0) {}
+};
+
+class Bench {
+   public:
+    explicit Bench(const Options &options)
+        : options_(options),
+          reactor_(net::CreateReactor(config::IoBackend::kEpoll)),
+          rng_(options.seed),
+          opened_(0),
+          in_setup_(0),
+          ready_(0),
+          measure_from_ns_(UINT64_MAX),
+          measure_ns_(0) {}
+
+    int Run() {
+        std::uint64_t setup_start = NowNs();
+        if (!Setup()) {
+            std::fprintf(stderr, "irc-bench: 준비 실패 (연결 %d/%d, 준비 %d, 끊김 %llu)\n", opened_,
+                         options_.clients, ready_, static_cast<unsigned long long>(counters_.disconnects));
+            return 1;
+        }
+        const double setup_s = static_cast<double>(NowNs() - setup_start) / 1e9;
+        Load();
+        Report(setup_s);
+        return counters_.disconnects == 0 ? 0 : 1;
+    }
+
+   private:
+    Options options_;
+    std::unique_ptr<net::Reactor> reactor_;
+    std::vector<std::unique_ptr<Client> > clients_;
+    std::vector<Client *> by_fd_;
+    std::vector<net::ReadyEvent> events_;
+    std::mt19937 rng_;
+    int opened_;
+    int in_setup_;
+    int ready_;
+    std::uint64_t measure_from_ns_;
+    std::uint64_t measure_ns_;
+    Counters counters_;
+    // 마이크로초 단위.
+    metrics::HistogramSnapshot latency_;
+    std::string padding_;
+
+    bool Setup() {
+        padding_.assign(static_cast<std::size_t>(options_.payload), 'x');
+        const std::uint64_t deadline = NowNs() + static_cast<std::uint64_t>(kSetupTimeoutMs) * 1000000;
+        while (ready_ < options_.clients) {
+            while (opened_ < options_.clients && in_setup_ < options_.connect_window) {
+                if (!Open(opened_)) {
+                    return false;
+                }
+                ++opened_;
+                ++in_setup_;
+            }
+            Poll(10);
+            if (counters_.disconnects > 0 || NowNs() > deadline) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void Load() {
+        const std::uint64_t start = NowNs();
+        measure_from_ns_ = start + static_cast<std::uint64_t>(options_.warmup_s * 1e9);
+        const std::uint64_t end = measure_from_ns_ + static_cast<std::uint64_t>(options_.duration_s * 1e9);
+        std::uint64_t issued = 0;
+        while (true) {
+            const std::uint64_t now = NowNs();
+            if (now >= end) {
+                break;
+            }
+            const std::uint64_t due = static_cast<std::uint64_t>(static_cast<double>(now - start) / 1e9 * options_.rate);
+            while (issued < due) {
+                Issue(now);
+                ++issued;
+            }
+            Poll(1);
+        }
+        measure_ns_ = end - measure_from_ns_;
+
+        // 측정 중에 보낸 메시지가 아직 오고 있으면 조용해질 때까지 더 받는다.
+        const std::uint64_t drain_end = NowNs() + static_cast<std::uint64_t>(kDrainMaxMs) * 1000000;
+        std::uint64_t last_delivered = counters_.delivered;
+        std::uint64_t quiet_since = NowNs();
+        while (NowNs() < drain_end) {
+            Poll(10);
+            if (counters_.delivered != last_delivered) {
+                last_delivered = counters_.delivered;
+                quiet_since = NowNs();
+            } else if (NowNs() - quiet_since >= static_cast<std::uint64_t>(kDrainQuietMs) * 1000000) {
+                break;
+            }
+        }
+    }
+
+    bool Open(int index) {
+        int fd = socket(AF_INET, SOCK_STREAM, 0);
+        if (fd < 0) {
+            std::fprintf(stderr, "irc-bench: socket 실패: %s\n", std::strerror(errno));
+            return false;
+        }
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+        sockaddr_in addr;
+        std::memset(&addr, 0, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(static_cast<unsigned short>(options_.port));
+        if (inet_pton(AF_INET, options_.host.c_str(), &addr.sin_addr) != 1) {
+            std::fprintf(stderr, "irc-bench: 주소 형식 오류: %s\n", options_.host.c_str());
+            close(fd);
+            return false;
+        }
+        if (connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) < 0 && errno != EINPROGRESS) {
+            std::fprintf(stderr, "irc-bench: connect 실패: %s\n", std::strerror(errno));
+            close(fd);
+            return false;
+        }
+
+        std::unique_ptr<Client> client(new Client());
+        client->fd = fd;
+        client->nick = "b" + std::to_string(index);
+        // 채널을 고르게 나눠 채널당 멤버 수가 clients * joins / channels가 되게 한다.
+        for (int j = 0; j < options_.joins_per_client; ++j) {
+            client->channels.push_back((index * options_.joins_per_client + j) % options_.channels);
+        }
+        if (static_cast<std::size_t>(fd) >= by_fd_.size()) {
+            by_fd_.resize(static_cast<std::size_t>(fd) + 1, nullptr);
+        }
+        by_fd_[fd] = client.get();
+        client->want_write = true;
+        reactor_->Add(fd, net::kEventRead | net::kEventWrite);
+        clients_.push_back(std::move(client));
+        return true;
+    }
+
+    void Poll(int timeout_ms) {
+        if (reactor_->Wait(events_, timeout_ms) < 0) {
+            return;
+        }
+        for (std::size_t i = 0; i < events_.size(); ++i) {
+            const int fd = events_[i].fd;
+            Client *client = static_cast<std::size_t>(fd) < by_fd_.size() ? by_fd_[fd] : nullptr;
+            if (client == nullptr || client->state == kClosed) {
+                continue;
+            }
+            if (client->state == kConnecting) {
+                int error = 0;
+                socklen_t len = sizeof(error);
+                getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &len);
+                if (error != 0) {
+                    Close(*client);
+                    continue;
+                }
+                client->state = kRegistering;
+                Send(*client, "PASS " + options_.password + "\r\nNICK " + client->nick + "\r\nUSER " +
+                                  client->nick + " 0 * :irc-bench\r\n");
+            }
+            if (events_[i].events & (net::kEventRead | net::kEventError)) {
+                Read(*client);
+            }
+            if (client->state != kClosed && (events_[i].events & net::kEventWrite)) {
+                Flush(*client);
+            }
+        }
+    }
+
+    void Read(Client &client) {
+        while (true) {
+            if (client.input.WritableSize() == 0) {
+                Close(client);
+                return;
+            }
+            ssize_t n = recv(client.fd, client.input.WritePtr(), client.input.WritableSize(), 0);
+            if (n > 0) {
+                client.input.Commit(static_cast<std::size_t>(n));
+                const std::uint64_t now = NowNs();
+                std::string_view line;
+                protocol::FrameStatus status;
+                while ((status = client.input.NextLine(line)) == protocol::FrameStatus::kLine) {
+                    HandleLine(client, line, now);
+                    if (client.state == kClosed) {
+                        return;
+                    }
+                }
+                if (status == protocol::FrameStatus::kTooLong) {
+                    Close(client);
+                    return;
+                }
+                continue;
+            }
+            if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                return;
+            }
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            Close(client);
+            return;
+        }
+    }
+
+    void HandleLine(Client &client, std::string_view line, std::uint64_t now) {
+        if (line.compare(0, 5, "PING ") == 0) {
+            Send(client, "PONG " + std::string(line.substr(5)) + "\r\n");
+            return;
+        }
+        const std::size_t space = line.find(' ');
+        if (space == std::string_view::npos) {
+            return;
+        }
+        const std::string_view rest = line.substr(space + 1);
+        if (rest.compare(0, 8, "PRIVMSG ") == 0) {
+            const std::size_t marker = rest.find(" :b ");
+            if (marker != std::string_view::npos) {
+                const std::uint64_t sent = std::strtoull(rest.data() + marker + 4, nullptr, 10);
+                if (sent >= measure_from_ns_ && now >= sent) {
+                    latency_.Record((now - sent) / 1000);
+                    ++counters_.delivered;
+                }
+            }
+            return;
+        }
+        if (rest.size() > 4 && rest[3] == ' ' && rest[0] >= '4' && rest[0] <= '5') {
+            ++counters_.error_numerics;
+        }
+        if (client.state == kRegistering && rest.compare(0, 4, "001 ") == 0) {
+            client.state = kJoining;
+            for (std::size_t i = 0; i < client.channels.size(); ++i) {
+                Send(client, "JOIN #c" + std::to_string(client.channels[i]) + "\r\n");
+            }
+        } else if (client.state == kJoining && rest.compare(0, 5, "JOIN ") == 0 &&
+                   line.compare(1, client.nick.size(), client.nick) == 0 &&
+                   line.size() > client.nick.size() + 1 && line[client.nick.size() + 1] == '!') {
+            ++client.joined;
+        } else {
+            return;
+        }
+        if (client.state == kJoining && client.joined == client.channels.size()) {
+            client.state = kReady;
+            --in_setup_;
+            ++ready_;
+        }
+    }
+
+    void Issue(std::uint64_t now) {
+        Client &client = *clients_[std::uniform_int_distribution<std::size_t>(0, clients_.size() - 1)(rng_)];
+        if (client.state != kReady) {
+            ++counters_.skipped;
+            return;
+        }
+        if (client.output.size() - client.output_sent > kMaxPendingOutput) {
+            ++counters_.skipped;
+            return;
+        }
+        const bool measured = now >= measure_from_ns_;
+        const int roll = std::uniform_int_distribution<int>(0, 99)(rng_);
+        if (!client.channels.empty() && roll < options_.churn_percent) {
+            const std::string channel =
+                "#c" + std::to_string(client.channels[std::uniform_int_distribution<std::size_t>(
+                           0, client.channels.size() - 1)(rng_)]);
+            Send(client, "PART " + channel + " :irc-bench\r\nJOIN " + channel + "\r\n");
+            counters_.churns += measured ? 1 : 0;
+            return;
+        }
+        std::string target;
+        if (client.channels.empty() || roll < options_.churn_percent + options_.direct_percent) {
+            target = clients_[std::uniform_int_distribution<std::size_t>(0, clients_.size() - 1)(rng_)]->nick;
+            counters_.direct_messages += measured ? 1 : 0;
+        } else {
+            target = "#c" + std::to_string(client.channels[std::uniform_int_distribution<std::size_t>(
+                                0, client.channels.size() - 1)(rng_)]);
+            counters_.channel_messages += measured ? 1 : 0;
+        }
+        Send(client, "PRIVMSG " + target + " :b " + std::to_string(NowNs()) + " " + padding_ + "\r\n");
+    }
+
+    void Send(Client &client, const std::string &data) {
+        client.output += data;
+        Flush(client);
+    }
+
+    void Flush(Client &client) {
+        while (client.output_sent < client.output.size()) {
+            ssize_t n = send(client.fd, client.output.data() + client.output_sent,
+                             client.output.size() - client.output_sent, MSG_NOSIGNAL);
+            if (n > 0) {
+                client.output_sent += static_cast<std::size_t>(n);
+                continue;
+            }
+            if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == ENOTCONN)) {
+                break;
+            }
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            Close(client);
+            return;
+        }
+        if (client.output_sent == client.output.size()) {
+            client.output.clear();
+            client.output_sent = 0;
+        }
+        const bool want_write = !client.output.empty() || client.state == kConnecting;
+        if (want_write != client.want_write) {
+            client.want_write = want_write;
+            reactor_->Modify(client.fd, net::kEventRead | (want_write ? net::kEventWrite : 0u));
+        }
+    }
+
+    void Close(Client &client) {
+        if (client.state == kClosed) {
+            return;
+        }
+        if (client.state != kReady) {
+            --in_setup_;
+        }
+        client.state = kClosed;
+        ++counters_.disconnects;
+        reactor_->Remove(client.fd);
+        close(client.fd);
+    }
+
+    void Report(double setup_s) {
+        const double seconds = static_cast<double>(measure_ns_) / 1e9;
+        const std::uint64_t sent = counters_.channel_messages + counters_.direct_messages;
+        const double sent_rate = seconds > 0 ? static_cast<double>(sent) / seconds : 0;
+        const double delivered_rate = seconds > 0 ? static_cast<double>(counters_.delivered) / seconds : 0;
+        if (options_.json) {
+            std::printf(
+                "{\"clients\":%d,\"channels\":%d,\"joins_per_client\":%d,\"target_rate\":%.0f,"
+                "\"duration_s\":%.2f,\"setup_s\":%.3f,\"sent\":%llu,\"churns\":%llu,\"skipped\":%llu,"
+                "\"sent_per_s\":%.1f,\"delivered\":%llu,\"delivered_per_s\":%.1f,\"p50_us\":%llu,"
+                "\"p99_us\":%llu,\"p999_us\":%llu,\"max_us\":%llu,\"error_numerics\":%llu,"
+                "\"disconnects\":%llu}\n",
+                options_.clients, options_.channels, options_.joins_per_client, options_.rate, seconds, setup_s,
+                static_cast<unsigned long long>(sent), static_cast<unsigned long long>(counters_.churns),
+                static_cast<unsigned long long>(counters_.skipped), sent_rate,
+                static_cast<unsigned long long>(counters_.delivered), delivered_rate,
+                static_cast<unsigned long long>(latency_.Percentile(0.50)),
+                static_cast<unsigned long long>(latency_.Percentile(0.99)),
+                static_cast<unsigned long long>(latency_.Percentile(0.999)),
+                static_cast<unsigned long long>(latency_.max()),
+                static_cast<unsigned long long>(counters_.error_numerics),
+                static_cast<unsigned long long>(counters_.disconnects));
+            return;
+        }
+        std::printf("irc-bench: clients=%d channels=%d joins/client=%d rate=%.0f/s duration=%.1fs\n",
+                    options_.clients, options_.channels, options_.joins_per_client, options_.rate, seconds);
+        std::printf("  setup: %d clients registered and joined in %.2fs\n", ready_, setup_s);
+        std::printf("  sent: privmsg=%llu (channel=%llu direct=%llu) part+join=%llu skipped=%llu -> %.0f msgs/s\n",
+                    static_cast<unsigned long long>(sent),
+                    static_cast<unsigned long long>(counters_.channel_messages),
+                    static_cast<unsigned long long>(counters_.direct_messages),
+                    static_cast<unsigned long long>(counters_.churns),
+                    static_cast<unsigned long long>(counters_.skipped), sent_rate);
+        std::printf("  delivered: %llu lines -> %.0f msgs/s\n", static_cast<unsigned long long>(counters_.delivered),
+                    delivered_rate);
+        std::printf("  latency: p50=%lluus p99=%lluus p999=%lluus max=%lluus\n",
+                    static_cast<unsigned long long>(latency_.Percentile(0.50)),
+                    static_cast<unsigned long long>(latency_.Percentile(0.99)),
+                    static_cast<unsigned long long>(latency_.Percentile(0.999)),
+                    static_cast<unsigned long long>(latency_.max()));
+        std::printf("  errors: numerics=%llu disconnects=%llu\n",
+                    static_cast<unsigned long long>(counters_.error_numerics),
+                    static_cast<unsigned long long>(counters_.disconnects));
+    }
+};
+
+void RaiseFileLimit() {
+    struct rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max) {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+}
+
+int FindFreePort() {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t len = sizeof(addr);
+    int port = 0;
+    if (fd >= 0 && bind(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) == 0 &&
+        getsockname(fd, reinterpret_cast<sockaddr *>(&addr), &len) == 0) {
+        port = ntohs(addr.sin_port);
+    }
+    if (fd >= 0) {
+        close(fd);
+    }
+    return port;
+}
+
+bool WaitForListen(const std::string &host, int port) {
+    for (int attempt = 0; attempt < 50; ++attempt) {
+        int fd = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in addr;
+        std::memset(&addr, 0, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(static_cast<unsigned short>(port));
+        inet_pton(AF_INET, host.c_str(), &addr.sin_addr);
+        const bool ok = connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) == 0;
+        close(fd);
+        if (ok) {
+            return true;
+        }
+        usleep(100000);
+    }
+    return false;
+}
+
+pid_t SpawnServer(const Options &options) {
+    pid_t pid = fork();
+    if (pid != 0) {
+        return pid;
+    }
+    int null_fd = open("/dev/null", O_WRONLY);
+    if (null_fd >= 0) {
+        dup2(null_fd, STDOUT_FILENO);
+        dup2(null_fd, STDERR_FILENO);
+    }
+    const std::string port = std::to_string(options.port);
+    if (options.spawn_config.empty()) {
+        execl(options.spawn.c_str(), options.spawn.c_str(), port.c_str(), options.password.c_str(),
+              static_cast<char *>(nullptr));
+    } else {
+        execl(options.spawn.c_str(), options.spawn.c_str(), port.c_str(), options.password.c_str(),
+              options.spawn_config.c_str(), static_cast<char *>(nullptr));
+    }
+    _exit(127);
+}
+}  // namespace
+
+int main(int argc, char *argv[]) {
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        PrintUsage();
+        return 2;
+    }
+    RaiseFileLimit();
+    if (options.port == 0 && options.spawn.empty()) {
+        options.port = 6667;
+    }
+
+    pid_t server = -1;
+    if (!options.spawn.empty()) {
+        if (options.port == 0) {
+            options.port = FindFreePort();
+        }
+        server = SpawnServer(options);
+        if (server < 0 || !WaitForListen(options.host, options.port)) {
+            std::fprintf(stderr, "irc-bench: 서버 기동 실패: %s\n", options.spawn.c_str());
+            if (server > 0) {
+                kill(server, SIGKILL);
+                waitpid(server, nullptr, 0);
+            }
+            return 1;
+        }
+    }
+
+    int status = Bench(options).Run();
+
+    if (server > 0) {
+        kill(server, SIGTERM);
+        waitpid(server, nullptr, 0);
+    }
+    return status;
+}